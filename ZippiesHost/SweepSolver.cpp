@@ -0,0 +1,158 @@
+
+#include <string.h>
+#include "SweepSolver.h"
+
+#define SWEEP_SOLVER_CHUNK_COUNT   ((BASE_STATION_INFO_BLOCK_SIZE + TELEMETRY_BASE_STATION_CHUNK_LENGTH - 1) / TELEMETRY_BASE_STATION_CHUNK_LENGTH)
+
+SweepSolver::SweepSolver(double lighthouseHeightMM, double diodeHeightMM)
+  : lighthouseHeightMM(lighthouseHeightMM),
+    diodeHeightMM(diodeHeightMM),
+    receivedChunks(0),
+    geometryReady(false),
+    hasHitTime(false),
+    lastHitTime(0),
+    hitMicros(0),
+    lastSweepReceivedMicros(0),
+    hasSequence(false),
+    lastSequence(0),
+    gapPending(false),
+    handler(NULL),
+    handlerContext(NULL),
+    sweepCount(0),
+    poseCount(0),
+    gapCount(0)
+{
+  memset(baseStationInfoBlock, 0, sizeof(baseStationInfoBlock));
+}
+
+void SweepSolver::receiveTelemetry(const uint8_t* packet, uint8_t length, unsigned long long receivedMicros)
+{
+  if (length == 0)
+    return;
+
+  //a lost packet may have carried sweeps, and a long wait for this one may have hidden a wrap of the hit time
+  if (hasSequence && packet[0] != (uint8_t)(lastSequence + 1))
+    startGap();
+  hasSequence = true;
+  lastSequence = packet[0];
+  if (receivedMicros && lastSweepReceivedMicros && receivedMicros - lastSweepReceivedMicros > SWEEP_SOLVER_MAX_GAP_MICROS)
+    startGap();
+
+  uint8_t position = 1;
+  while (position < length) {
+    uint8_t channel = packet[position++];
+    if (channel == 0)
+      return;
+
+    const uint8_t* record = packet + position;
+    uint8_t recordLength = getTelemetryRecordLength(channel, record);
+    //an unknown channel or a truncated record; the rest of the packet can't be parsed
+    if (recordLength == 0 || position + recordLength > length)
+      return;
+
+    if (channel == TELEMETRY_CHANNEL_SWEEPS) {
+      receiveSweep(record);
+      lastSweepReceivedMicros = receivedMicros;
+    }
+    else if (channel == TELEMETRY_CHANNEL_BASE_STATION)
+      receiveBaseStationChunk(record);
+    position += recordLength;
+  }
+}
+
+void SweepSolver::receiveBaseStationChunk(const uint8_t* record)
+{
+  uint8_t offset = record[0];
+  if (geometryReady || offset % TELEMETRY_BASE_STATION_CHUNK_LENGTH || offset >= BASE_STATION_INFO_BLOCK_SIZE)
+    return;
+
+  uint8_t length = BASE_STATION_INFO_BLOCK_SIZE - offset;
+  if (length > TELEMETRY_BASE_STATION_CHUNK_LENGTH)
+    length = TELEMETRY_BASE_STATION_CHUNK_LENGTH;
+  memcpy(baseStationInfoBlock + offset, record+1, length);
+  receivedChunks |= 1 << (offset / TELEMETRY_BASE_STATION_CHUNK_LENGTH);
+
+  if (receivedChunks == (1 << SWEEP_SOLVER_CHUNK_COUNT) - 1) {
+    geometry.calculate(baseStationInfoBlock, lighthouseHeightMM, diodeHeightMM);
+    geometryReady = true;
+  }
+}
+
+void SweepSolver::receiveSweep(const uint8_t* record)
+{
+  uint8_t sensorIndex = (record[0] >> 1) & 0x01;
+  uint8_t axis = record[0] & 0x01;
+  uint32_t sweepTicks = 0;
+  uint16_t hitTime;
+  memcpy(&sweepTicks, record+3, 3);
+  memcpy(&hitTime, record+6, sizeof(uint16_t));
+  sweepCount++;
+
+  //hit times wrap every 262ms, but sweeps arrive at 120Hz for as long as the robot can see the lighthouse; after a gap, the
+  //time is still moved on by what the hit time says, so that poses stay in order
+  unsigned long deltaMicros = ((uint16_t)(hitTime - lastHitTime)) << TELEMETRY_SWEEP_TIME_SHIFT;
+  if (hasHitTime && deltaMicros > SWEEP_SOLVER_MAX_GAP_MICROS)
+    startGap();
+  if (hasHitTime)
+    hitMicros += deltaMicros;
+  else
+    hitMicros = ((unsigned long long)hitTime) << TELEMETRY_SWEEP_TIME_SHIFT;
+  hasHitTime = true;
+  lastHitTime = hitTime;
+
+  SolverSensor* sensor = &sensors[sensorIndex];
+  if (axis == 0) {
+    sensor->hasXSweep = true;
+    sensor->xSweepTicks = sweepTicks;
+    return;
+  }
+
+  //a y sweep without the x sweep before it can't be solved
+  if (!sensor->hasXSweep || !geometryReady) {
+    sensor->hasXSweep = false;
+    return;
+  }
+
+  sensor->hasXSweep = false;
+  geometry.calculateSensorPosition(sensor->xSweepTicks, sweepTicks, &sensor->position);
+  sensor->hasPosition = true;
+  sensor->positionMicros = hitMicros;
+
+  SolverSensor* otherSensor = &sensors[sensorIndex ^ 1];
+  if (!otherSensor->hasPosition || hitMicros - otherSensor->positionMicros > SWEEP_SOLVER_MAX_PAIR_MICROS)
+    return;
+
+  //both positions are now used; the next pose needs a fresh pair
+  sensor->hasPosition = false;
+  otherSensor->hasPosition = false;
+  poseCount++;
+  if (handler == NULL)
+    return;
+
+  SolvedPose pose;
+  pose.timeMicros = hitMicros;
+  pose.afterGap = gapPending;
+  gapPending = false;
+  pose.rightPosition.set(&sensors[0].position);
+  pose.leftPosition.set(&sensors[1].position);
+  pose.x = (pose.leftPosition.getX() + pose.rightPosition.getX()) / 2.0d;
+  pose.y = (pose.leftPosition.getY() + pose.rightPosition.getY()) / 2.0d;
+
+  //as in Lighthouse::recalculate(), the orientation is the down direction crossed with the vector between the sensors
+  KVector2 orientation(pose.leftPosition.getY() - pose.rightPosition.getY(),
+      -(pose.leftPosition.getX() - pose.rightPosition.getX()), 1.0d);
+  pose.heading = orientation.getOrientation();
+  handler(&pose, handlerContext);
+}
+
+void SweepSolver::startGap()
+{
+  //nothing from before the gap may be paired with anything after it
+  for (int i = 0; i < 2; i++) {
+    sensors[i].hasXSweep = false;
+    sensors[i].hasPosition = false;
+  }
+  if (!gapPending && hasHitTime)
+    gapCount++;
+  gapPending = hasHitTime;
+}
@@ -0,0 +1,102 @@
+
+#pragma once
+
+#include <stdint.h>
+#include "../ZippiesTinyScreen/TelemetryFormat.h"
+#include "../ZippiesTinyScreen/LighthouseGeometry.h"
+
+/**
+ * Solves robot poses on the host from the sweep events streamed on the sweeps telemetry channel, using the same geometry as the
+ * robot itself. The base station info block arrives on its own channel; poses are solved once all of it has been received. Each
+ * sensor position is solved from an x sweep followed by a y sweep, and a pose is reported once both sensors have a position
+ * from the same lighthouse cycle, as the average of the two with the heading taken from the line between them.
+ *
+ * Hit times are only 16 bits of 4us, so they wrap every 262ms and are unwrapped from one sweep to the next. That only works
+ * while sweeps keep arriving; across a longer gap, such as while the robot cannot see the lighthouse, the number of wraps is
+ * lost. A gap is recognized by a hit time that jumps by more than SWEEP_SOLVER_MAX_GAP_MICROS, a break in the packet
+ * sequence, or, when the caller gives the time each packet arrived, by packets arriving that far apart. Sweeps waiting to be
+ * paired are dropped at a gap, so that no pose is solved from both sides of it, and the first pose after it is flagged,
+ * since its time can no longer be compared with the poses before it.
+ */
+
+//positions solved further apart than this are from different cycles and are not paired
+#define SWEEP_SOLVER_MAX_PAIR_MICROS     20000
+//sweeps normally arrive every 4ms; a longer silence than this may have hidden a wrap of the hit time, which is 262ms
+#define SWEEP_SOLVER_MAX_GAP_MICROS     100000
+
+typedef struct _SolvedPose
+{
+  //unwrapped hit time of the later of the two sweeps, in micros
+  unsigned long long timeMicros;
+  //the sweeps stopped for too long before this pose to know how much time passed; its time only orders it after the others
+  bool afterGap;
+  double x;
+  double y;
+  //radians
+  double heading;
+  KVector2 leftPosition;
+  KVector2 rightPosition;
+} SolvedPose;
+
+typedef void (*SolvedPoseHandler)(SolvedPose* pose, void* context);
+
+typedef struct _SolverSensor
+{
+  bool hasXSweep = false;
+  uint32_t xSweepTicks = 0;
+  bool hasPosition = false;
+  unsigned long long positionMicros = 0;
+  KVector2 position;
+} SolverSensor;
+
+class SweepSolver
+{
+
+private:
+  double lighthouseHeightMM;
+  double diodeHeightMM;
+  uint8_t baseStationInfoBlock[BASE_STATION_INFO_BLOCK_SIZE];
+  //one bit for each chunk of the info block received so far
+  uint8_t receivedChunks;
+  bool geometryReady;
+  LighthouseGeometry geometry;
+
+  //0 is the right sensor and 1 the left, as on the sweeps channel
+  SolverSensor sensors[2];
+  bool hasHitTime;
+  uint16_t lastHitTime;
+  unsigned long long hitMicros;
+  unsigned long long lastSweepReceivedMicros;
+  bool hasSequence;
+  uint8_t lastSequence;
+  //set at a gap, and cleared once a pose has been flagged with it
+  bool gapPending;
+
+  SolvedPoseHandler handler;
+  void* handlerContext;
+
+  unsigned long sweepCount;
+  unsigned long poseCount;
+  unsigned long gapCount;
+
+  void receiveBaseStationChunk(const uint8_t* record);
+  void receiveSweep(const uint8_t* record);
+  void startGap();
+
+public:
+  //heights are from the floor
+  SweepSolver(double lighthouseHeightMM = LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM, double diodeHeightMM = ROBOT_DIODE_HEIGHT_MM);
+
+  void setPoseHandler(SolvedPoseHandler handler, void* context) { this->handler = handler; this->handlerContext = context; }
+
+  //takes a telemetry packet, as sent by the robot; records on channels other than sweeps and base station are skipped. The
+  //time the packet arrived, in micros on any clock, helps to recognize gaps; zero if it is not known, e.g. in a recording
+  void receiveTelemetry(const uint8_t* packet, uint8_t length, unsigned long long receivedMicros = 0);
+
+  bool isReady() { return geometryReady; }
+  KVector3* getLighthousePosition() { return geometry.getLighthousePosition(); }
+  unsigned long getSweepCount() { return sweepCount; }
+  unsigned long getPoseCount() { return poseCount; }
+  unsigned long getGapCount() { return gapCount; }
+
+};
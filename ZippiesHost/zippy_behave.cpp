@@ -0,0 +1,374 @@
+
+/**
+ * Assembles a behavior program from text into the bytecode described in Behavior.h, and runs it with the robot's own
+ * interpreter against a simple model of the robot, so that a program can be tried out before it is written to a Zippy. Each
+ * line holds one instruction, named as in Behavior.h but in lower case, followed by its operands; a word ending in a colon
+ * labels the next instruction, and can be given anywhere a jump target is expected. For example...
+ *
+ *   wait_signal
+ *   set_counter 0 4
+ *   side:
+ *   drive_distance 300
+ *   turn_relative 1571
+ *   loop 0 side
+ *
+ * The model is a unicycle that drives at AUTODRIVE_MAX_VELOCITY and turns at AUTODRIVE_MAX_ANGULAR_VELOCITY, starting at the
+ * origin facing +y, with the lighthouse signal arriving after a second. It follows each action exactly rather than tracking a
+ * trajectory, so it shows where a program sends the robot, not how well the robot gets there. The pose at the start of each
+ * action is printed as CSV, and the bytecode is written to a file if one is given. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_behave zippy_behave.cpp ../ZippiesTinyScreen/Behavior.cpp
+ *
+ *   zippy_behave behaviors/square.txt square.bin > square.csv
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../ZippiesTinyScreen/Behavior.h"
+
+//the speeds the model moves at; see ZippyCommand.h
+#define MODEL_VELOCITY                150.0f
+#define MODEL_ANGULAR_VELOCITY          4.0f
+#define MODEL_STEP_SECONDS              0.01f
+#define MODEL_SIGNAL_SECONDS            1.0f
+//half of WHEEL_BASE_MM; the interpreter ends a program at any arc tighter than this, as the sketch's does
+#define MODEL_MIN_ARC_RADIUS           15.0f
+//how long a program may run before it is assumed to be stuck in a loop
+#define MODEL_MAX_SECONDS             600.0f
+
+#define OPERAND_INT16                 'i'
+#define OPERAND_COUNTER               'c'
+#define OPERAND_TARGET                't'
+
+typedef struct _Mnemonic
+{
+  const char* name;
+  uint8_t opcode;
+  const char* operands;
+} Mnemonic;
+
+const Mnemonic MNEMONICS[] = {
+  { "end",             BEHAVIOR_END,             "" },
+  { "move",            BEHAVIOR_MOVE,            "ii" },
+  { "move_relative",   BEHAVIOR_MOVE_RELATIVE,   "ii" },
+  { "pause",           BEHAVIOR_PAUSE,           "i" },
+  { "turn",            BEHAVIOR_TURN,            "i" },
+  { "turn_relative",   BEHAVIOR_TURN_RELATIVE,   "i" },
+  { "wait_signal",     BEHAVIOR_WAIT_SIGNAL,     "" },
+  { "set_counter",     BEHAVIOR_SET_COUNTER,     "ci" },
+  { "loop",            BEHAVIOR_LOOP,            "ct" },
+  { "jump",            BEHAVIOR_JUMP,            "t" },
+  { "jump_if_in_zone", BEHAVIOR_JUMP_IF_IN_ZONE, "iiiit" },
+  { "drive_distance",  BEHAVIOR_DRIVE_DISTANCE,  "i" },
+  { "drive_arc",       BEHAVIOR_DRIVE_ARC,       "ii" },
+};
+
+//an instruction waiting for its jump target to be resolved once all the labels are known
+typedef struct _Instruction
+{
+  int lineNumber;
+  const Mnemonic* mnemonic;
+  std::vector<std::string> operands;
+} Instruction;
+
+const Mnemonic* findMnemonic(const char* name)
+{
+  for (size_t i = 0; i < sizeof(MNEMONICS) / sizeof(MNEMONICS[0]); i++) {
+    if (!strcmp(MNEMONICS[i].name, name))
+      return &MNEMONICS[i];
+  }
+  return NULL;
+}
+
+//the size of an instruction in bytes, including its opcode
+int instructionLength(const Mnemonic* mnemonic)
+{
+  int length = 1;
+  for (const char* operand = mnemonic->operands; *operand; operand++)
+    length += *operand == OPERAND_COUNTER ? 1 : 2;
+  return length;
+}
+
+bool parseNumber(const std::string& text, long minimum, long maximum, long* value)
+{
+  char* end;
+  *value = strtol(text.c_str(), &end, 0);
+  return !text.empty() && *end == '\0' && *value >= minimum && *value <= maximum;
+}
+
+bool assemble(const char* path, std::vector<uint8_t>* program)
+{
+  FILE* input = fopen(path, "r");
+  if (!input) {
+    perror(path);
+    return false;
+  }
+
+  //first pass: lay out the instructions, so that every label has an offset
+  std::vector<Instruction> instructions;
+  std::map<std::string, long> labels;
+  long offset = 0;
+  char line[256];
+  int lineNumber = 0;
+  bool valid = true;
+  while (valid && fgets(line, sizeof(line), input)) {
+    lineNumber++;
+    char* comment = strchr(line, '#');
+    if (comment)
+      *comment = '\0';
+
+    std::vector<std::string> words;
+    for (char* word = strtok(line, " \t\r\n,"); word; word = strtok(NULL, " \t\r\n,"))
+      words.push_back(word);
+    while (!words.empty() && words[0].size() > 1 && words[0].back() == ':') {
+      std::string label = words[0].substr(0, words[0].size() - 1);
+      if (labels.count(label)) {
+        fprintf(stderr, "%s:%d: %s is already defined\n", path, lineNumber, label.c_str());
+        valid = false;
+      }
+      labels[label] = offset;
+      words.erase(words.begin());
+    }
+    if (!valid || words.empty())
+      continue;
+
+    Instruction instruction;
+    instruction.lineNumber = lineNumber;
+    instruction.mnemonic = findMnemonic(words[0].c_str());
+    instruction.operands.assign(words.begin() + 1, words.end());
+    if (!instruction.mnemonic) {
+      fprintf(stderr, "%s:%d: no such instruction as %s\n", path, lineNumber, words[0].c_str());
+      valid = false;
+    }
+    else if (instruction.operands.size() != strlen(instruction.mnemonic->operands)) {
+      fprintf(stderr, "%s:%d: %s takes %lu operands\n", path, lineNumber, instruction.mnemonic->name,
+          (unsigned long)strlen(instruction.mnemonic->operands));
+      valid = false;
+    }
+    else {
+      instructions.push_back(instruction);
+      offset += instructionLength(instruction.mnemonic);
+    }
+  }
+  fclose(input);
+
+  if (valid && offset > BEHAVIOR_PROGRAM_SIZE) {
+    fprintf(stderr, "%s: %ld bytes is more than the %d that fit on the robot\n", path, offset, BEHAVIOR_PROGRAM_SIZE);
+    valid = false;
+  }
+
+  //second pass: encode them, with the operands little-endian
+  for (size_t i = 0; valid && i < instructions.size(); i++) {
+    Instruction* instruction = &instructions[i];
+    program->push_back(instruction->mnemonic->opcode);
+    for (size_t j = 0; valid && j < instruction->operands.size(); j++) {
+      const std::string& operand = instruction->operands[j];
+      char type = instruction->mnemonic->operands[j];
+      long value;
+      if (type == OPERAND_TARGET && labels.count(operand))
+        value = labels[operand];
+      else if (type == OPERAND_TARGET)
+        valid = parseNumber(operand, 0, BEHAVIOR_PROGRAM_SIZE - 1, &value);
+      else if (type == OPERAND_COUNTER)
+        valid = parseNumber(operand, 0, BEHAVIOR_COUNTER_COUNT - 1, &value);
+      else
+        valid = parseNumber(operand, -32768, 65535, &value);
+      if (!valid) {
+        fprintf(stderr, "%s:%d: %s is not a valid operand for %s\n", path, instruction->lineNumber, operand.c_str(),
+            instruction->mnemonic->name);
+        break;
+      }
+
+      program->push_back((uint8_t)value);
+      if (type != OPERAND_COUNTER)
+        program->push_back((uint8_t)(value >> 8));
+    }
+  }
+  return valid;
+}
+
+float wrapModelAngle(float angle)
+{
+  while (angle > M_PI)
+    angle -= 2.0f * M_PI;
+  while (angle <= -M_PI)
+    angle += 2.0f * M_PI;
+  return angle;
+}
+
+/**
+ * A unicycle that carries out one action at a time. Moves turn toward the point while driving, slowing down the further off
+ * course they are; every other action runs at full speed until it is done.
+ */
+class RobotModel
+{
+
+private:
+  BehaviorPose pose;
+  float seconds;
+  BehaviorAction action;
+  float progress;
+
+  void drive(float velocity, float angularVelocity)
+  {
+    pose.heading = wrapModelAngle(pose.heading + (angularVelocity * MODEL_STEP_SECONDS));
+    pose.x += velocity * MODEL_STEP_SECONDS * sinf(pose.heading);
+    pose.y += velocity * MODEL_STEP_SECONDS * cosf(pose.heading);
+  }
+
+  float turnToward(float heading)
+  {
+    float error = wrapModelAngle(heading - pose.heading);
+    float step = MODEL_ANGULAR_VELOCITY * MODEL_STEP_SECONDS;
+    return error > step ? MODEL_ANGULAR_VELOCITY : (error < -step ? -MODEL_ANGULAR_VELOCITY : error / MODEL_STEP_SECONDS);
+  }
+
+  //advances the current action by a step, and returns whether it has finished
+  bool stepAction()
+  {
+    float step = MODEL_VELOCITY * MODEL_STEP_SECONDS;
+    switch (action.type) {
+      case BEHAVIOR_MOVE:
+        {
+          float deltaX = action.a - pose.x;
+          float deltaY = action.b - pose.y;
+          float distance = sqrtf((deltaX*deltaX) + (deltaY*deltaY));
+          if (distance <= step) {
+            pose.x = action.a;
+            pose.y = action.b;
+            return true;
+          }
+          float heading = atan2f(deltaX, deltaY);
+          drive(MODEL_VELOCITY * fmaxf(0.0f, cosf(heading - pose.heading)), turnToward(heading));
+        }
+        return false;
+
+      case BEHAVIOR_PAUSE:
+        progress += MODEL_STEP_SECONDS;
+        return progress >= action.a;
+
+      case BEHAVIOR_TURN:
+        if (fabsf(wrapModelAngle(action.a - pose.heading)) < 0.001f) {
+          pose.heading = wrapModelAngle(action.a);
+          return true;
+        }
+        drive(0.0f, turnToward(action.a));
+        return false;
+
+      case BEHAVIOR_DRIVE_DISTANCE:
+        progress += step;
+        drive(action.a < 0.0f ? -MODEL_VELOCITY : MODEL_VELOCITY, 0.0f);
+        return progress >= fabsf(action.a);
+
+      case BEHAVIOR_DRIVE_ARC:
+        //like Trajectory::planArc(), a positive angle turns clockwise; the interpreter only yields arcs of a drivable radius
+        progress += step / action.a;
+        drive(MODEL_VELOCITY, action.b < 0.0f ? -MODEL_VELOCITY / action.a : MODEL_VELOCITY / action.a);
+        return progress >= fabsf(action.b);
+    }
+    return true;
+  }
+
+public:
+  RobotModel()
+    : seconds(0.0f),
+      progress(0.0f)
+  {
+    memset(&pose, 0, sizeof(pose));
+    memset(&action, 0, sizeof(action));
+  }
+
+  const BehaviorPose* getPose() { return &pose; }
+  float getSeconds() { return seconds; }
+
+  void start(const BehaviorAction* a)
+  {
+    action = *a;
+    progress = 0.0f;
+  }
+
+  //runs the current action to completion
+  void finish()
+  {
+    while (!stepAction())
+      step();
+    step();
+  }
+
+  void step()
+  {
+    seconds += MODEL_STEP_SECONDS;
+    pose.hasSignal = seconds >= MODEL_SIGNAL_SECONDS;
+  }
+
+};
+
+const char* actionName(uint8_t type)
+{
+  for (size_t i = 0; i < sizeof(MNEMONICS) / sizeof(MNEMONICS[0]); i++) {
+    if (MNEMONICS[i].opcode == type)
+      return MNEMONICS[i].name;
+  }
+  return "?";
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 2 && argc != 3) {
+    fprintf(stderr, "usage: %s <program> [<bytecode output>]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<uint8_t> program;
+  if (!assemble(argv[1], &program))
+    return 1;
+
+  if (argc == 3) {
+    FILE* output = fopen(argv[2], "wb");
+    if (!output || fwrite(program.data(), 1, program.size(), output) != program.size()) {
+      perror(argv[2]);
+      return 1;
+    }
+    fclose(output);
+  }
+
+  //written in pieces, as PROTOCOL_BEHAVIOR_WRITE would
+  BehaviorInterpreter behavior;
+  behavior.setMinArcRadius(MODEL_MIN_ARC_RADIUS);
+  for (size_t i = 0; i < program.size(); i += 128)
+    behavior.write(i, &program[i], program.size() - i < 128 ? program.size() - i : 128);
+  behavior.run();
+
+  RobotModel model;
+  unsigned long actionCount = 0;
+  printf("seconds,x,y,heading,action,a,b\n");
+  while (model.getSeconds() < MODEL_MAX_SECONDS) {
+    BehaviorAction action;
+    uint8_t result = behavior.next(model.getPose(), &action);
+    if (result == BEHAVIOR_RESULT_ENDED)
+      break;
+    if (result == BEHAVIOR_RESULT_WAITING) {
+      model.step();
+      continue;
+    }
+
+    const BehaviorPose* pose = model.getPose();
+    printf("%.2f,%.1f,%.1f,%.3f,%s,%g,%g\n", model.getSeconds(), pose->x, pose->y, pose->heading, actionName(action.type),
+        action.a, action.b);
+    actionCount++;
+    model.start(&action);
+    model.finish();
+  }
+
+  const BehaviorPose* pose = model.getPose();
+  printf("%.2f,%.1f,%.1f,%.3f,end,0,0\n", model.getSeconds(), pose->x, pose->y, pose->heading);
+  fprintf(stderr, "%lu bytes, %lu actions, %.2fs%s\n", (unsigned long)program.size(), actionCount, model.getSeconds(),
+      behavior.isRunning() ? ", stopped while still running" : "");
+  return 0;
+}
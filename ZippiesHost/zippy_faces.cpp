@@ -0,0 +1,327 @@
+
+/**
+ * Converts the face artwork listed in a manifest into the compressed images and expressions the robot draws, and writes them
+ * to FaceAssets.h and FaceAssets.cpp. Every image is decoded again with the robot's own decoder before anything is written, so
+ * a broken encoding never makes it onto a robot. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_faces zippy_faces.cpp ../ZippiesTinyScreen/FaceImage.cpp
+ *
+ *   zippy_faces faces/faces.txt ../ZippiesTinyScreen/FaceAssets
+ *
+ * Each line of the manifest is either a comment starting with #, or one of...
+ *
+ *   expression <name> <image>      starts an expression, drawn over the given image
+ *   frame <image or -> <millis>    adds a frame to the expression; - is just the image the expression is drawn over
+ *
+ * Images are binary PPM (P6) files the size of the screen, and named relative to the manifest. Colors are reduced to the
+ * display's 8-bit pixels, and all of the images together may use no more than FACE_PALETTE_SIZE of them.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../ZippiesTinyScreen/FaceImage.h"
+
+#define SCREEN_WIDTH_PIXELS  96
+#define SCREEN_HEIGHT_PIXELS 64
+#define SCREEN_PIXEL_COUNT   (SCREEN_WIDTH_PIXELS * SCREEN_HEIGHT_PIXELS)
+
+typedef struct _EncodedImage
+{
+  std::string name;
+  std::string file;
+  std::string baseFile;
+  FaceImage image;
+  std::vector<uint16_t> rowOffsets;
+  std::vector<uint8_t> runs;
+} EncodedImage;
+
+typedef struct _ExpressionFrame
+{
+  //index into the encoded images, or -1 for just the base image
+  int image;
+  uint16_t durationMillis;
+} ExpressionFrame;
+
+typedef struct _Expression
+{
+  std::string name;
+  int base;
+  std::vector<ExpressionFrame> frames;
+} Expression;
+
+std::string manifestDirectory;
+std::vector<uint8_t> palette;
+std::vector<EncodedImage> images;
+std::vector<Expression> expressions;
+
+bool readImage(const std::string& file, uint8_t* pixels)
+{
+  std::string path = manifestDirectory + file;
+  FILE* input = fopen(path.c_str(), "rb");
+  if (!input) {
+    perror(path.c_str());
+    return false;
+  }
+
+  int width, height, maximum;
+  bool valid = fscanf(input, "P6 %d %d %d", &width, &height, &maximum) == 3 && fgetc(input) != EOF &&
+      width == SCREEN_WIDTH_PIXELS && height == SCREEN_HEIGHT_PIXELS && maximum == 255;
+  uint8_t rgb[SCREEN_PIXEL_COUNT * 3];
+  valid = valid && fread(rgb, 1, sizeof(rgb), input) == sizeof(rgb);
+  fclose(input);
+  if (!valid) {
+    fprintf(stderr, "%s: not a %dx%d binary PPM with 8-bit channels\n", path.c_str(), SCREEN_WIDTH_PIXELS, SCREEN_HEIGHT_PIXELS);
+    return false;
+  }
+
+  //the display takes 8-bit BBBGGGRR pixels
+  for (int i = 0; i < SCREEN_PIXEL_COUNT; i++) {
+    uint8_t red = ((rgb[i*3] * 3) + 127) / 255;
+    uint8_t green = ((rgb[(i*3)+1] * 7) + 127) / 255;
+    uint8_t blue = ((rgb[(i*3)+2] * 7) + 127) / 255;
+    pixels[i] = (blue << 5) | (green << 2) | red;
+  }
+  return true;
+}
+
+int paletteIndex(uint8_t color)
+{
+  for (size_t i = 0; i < palette.size(); i++) {
+    if (palette[i] == color)
+      return i;
+  }
+  palette.push_back(color);
+  return palette.size() - 1;
+}
+
+void encodeRun(std::vector<uint8_t>* runs, int index, int length)
+{
+  while (length) {
+    int runLength = length > 262 ? 262 : length;
+    if (runLength <= FACE_RUN_LONG) {
+      runs->push_back((index << 3) | (runLength - 1));
+    }
+    else {
+      runs->push_back((index << 3) | FACE_RUN_LONG);
+      runs->push_back(runLength - FACE_RUN_LONG);
+    }
+    length -= runLength;
+  }
+}
+
+//encodes the part of the pixels that differs from the base, or all of them without one; returns -1 on failure, and the
+//index of the image otherwise
+int encodeImage(const std::string& file, const std::string& baseFile)
+{
+  for (size_t i = 0; i < images.size(); i++) {
+    if (images[i].file == file && images[i].baseFile == baseFile)
+      return i;
+  }
+
+  uint8_t pixels[SCREEN_PIXEL_COUNT];
+  uint8_t basePixels[SCREEN_PIXEL_COUNT];
+  if (!readImage(file, pixels) || (!baseFile.empty() && !readImage(baseFile, basePixels)))
+    return -1;
+
+  //frames only need to cover the pixels that change
+  int left = 0, top = 0, right = SCREEN_WIDTH_PIXELS, bottom = SCREEN_HEIGHT_PIXELS;
+  if (!baseFile.empty()) {
+    left = SCREEN_WIDTH_PIXELS;
+    top = SCREEN_HEIGHT_PIXELS;
+    right = bottom = 0;
+    for (int y = 0; y < SCREEN_HEIGHT_PIXELS; y++) {
+      for (int x = 0; x < SCREEN_WIDTH_PIXELS; x++) {
+        if (pixels[(y * SCREEN_WIDTH_PIXELS) + x] == basePixels[(y * SCREEN_WIDTH_PIXELS) + x])
+          continue;
+        left = x < left ? x : left;
+        top = y < top ? y : top;
+        right = x >= right ? x + 1 : right;
+        bottom = y >= bottom ? y + 1 : bottom;
+      }
+    }
+    if (right == 0) {
+      fprintf(stderr, "%s: no different from %s\n", file.c_str(), baseFile.c_str());
+      return -1;
+    }
+  }
+
+  EncodedImage encoded;
+  encoded.file = file;
+  encoded.baseFile = baseFile;
+  encoded.name = file.substr(0, file.rfind('.'));
+  if (!baseFile.empty())
+    encoded.name += "_over_" + baseFile.substr(0, baseFile.rfind('.'));
+  for (size_t i = 0; i < encoded.name.size(); i++)
+    encoded.name[i] = isalnum(encoded.name[i]) ? toupper(encoded.name[i]) : '_';
+
+  for (int y = top; y < bottom; y++) {
+    encoded.rowOffsets.push_back(encoded.runs.size());
+    int runStart = left;
+    for (int x = left + 1; x <= right; x++) {
+      if (x < right && pixels[(y * SCREEN_WIDTH_PIXELS) + x] == pixels[(y * SCREEN_WIDTH_PIXELS) + runStart])
+        continue;
+      encodeRun(&encoded.runs, paletteIndex(pixels[(y * SCREEN_WIDTH_PIXELS) + runStart]), x - runStart);
+      runStart = x;
+    }
+  }
+  if (palette.size() > FACE_PALETTE_SIZE) {
+    fprintf(stderr, "%s: the images use more than %d colors between them\n", file.c_str(), FACE_PALETTE_SIZE);
+    return -1;
+  }
+
+  encoded.image.x = left;
+  encoded.image.y = top;
+  encoded.image.width = right - left;
+  encoded.image.height = bottom - top;
+  images.push_back(encoded);
+
+  //decode it all again, and make sure it comes out the same
+  EncodedImage* image = &images.back();
+  image->image.palette = palette.data();
+  image->image.rowOffsets = image->rowOffsets.data();
+  image->image.runs = image->runs.data();
+  for (int y = top; y < bottom; y++) {
+    uint8_t row[SCREEN_WIDTH_PIXELS];
+    drawFaceImageRow(&image->image, y, 0, SCREEN_WIDTH_PIXELS, row);
+    if (memcmp(row + left, pixels + (y * SCREEN_WIDTH_PIXELS) + left, right - left)) {
+      fprintf(stderr, "%s: row %d didn't decode to what was encoded\n", file.c_str(), y);
+      return -1;
+    }
+  }
+  return images.size() - 1;
+}
+
+bool readManifest(const char* path)
+{
+  FILE* input = fopen(path, "r");
+  if (!input) {
+    perror(path);
+    return false;
+  }
+
+  const char* slash = strrchr(path, '/');
+  manifestDirectory = slash ? std::string(path, slash - path + 1) : std::string();
+
+  char line[256];
+  int lineNumber = 0;
+  bool valid = true;
+  while (valid && fgets(line, sizeof(line), input)) {
+    lineNumber++;
+    char command[32], first[128], second[128];
+    int fieldCount = sscanf(line, "%31s %127s %127s", command, first, second);
+    if (fieldCount <= 0 || command[0] == '#')
+      continue;
+
+    if (!strcmp(command, "expression") && fieldCount == 3) {
+      Expression expression;
+      expression.name = first;
+      expression.base = encodeImage(second, "");
+      expressions.push_back(expression);
+      valid = expression.base >= 0;
+    }
+    else if (!strcmp(command, "frame") && fieldCount == 3 && !expressions.empty()) {
+      Expression* expression = &expressions.back();
+      ExpressionFrame frame;
+      frame.image = -1;
+      frame.durationMillis = atoi(second);
+      if (strcmp(first, "-"))
+        frame.image = encodeImage(first, images[expression->base].file);
+      expression->frames.push_back(frame);
+      valid = frame.image >= 0 || !strcmp(first, "-");
+    }
+    else {
+      fprintf(stderr, "%s:%d: expected an expression, or a frame following one\n", path, lineNumber);
+      valid = false;
+    }
+  }
+  fclose(input);
+
+  for (size_t i = 0; valid && i < expressions.size(); i++) {
+    if (expressions[i].frames.empty()) {
+      fprintf(stderr, "%s: %s has no frames\n", path, expressions[i].name.c_str());
+      valid = false;
+    }
+  }
+  return valid;
+}
+
+void writeBytes(FILE* output, const char* type, const std::string& name, const uint8_t* bytes, size_t length)
+{
+  fprintf(output, "const %s %s[] = {", type, name.c_str());
+  for (size_t i = 0; i < length; i++)
+    fprintf(output, "%s0x%02x,", i % 24 ? "" : "\n  ", bytes[i]);
+  fprintf(output, "\n};\n\n");
+}
+
+bool writeAssets(const char* manifest, const char* outputBase)
+{
+  std::string headerPath = std::string(outputBase) + ".h";
+  std::string sourcePath = std::string(outputBase) + ".cpp";
+  FILE* header = fopen(headerPath.c_str(), "w");
+  FILE* source = fopen(sourcePath.c_str(), "w");
+  if (!header || !source) {
+    perror(header ? sourcePath.c_str() : headerPath.c_str());
+    return false;
+  }
+
+  const char* headerName = strrchr(headerPath.c_str(), '/');
+  headerName = headerName ? headerName + 1 : headerPath.c_str();
+  fprintf(header, "\n#pragma once\n\n#include \"FaceImage.h\"\n\n");
+  fprintf(header, "//written by zippy_faces from %s; change the artwork and run it again rather than editing this\n\n", manifest);
+  fprintf(source, "\n#include <stddef.h>\n#include \"%s\"\n\n", headerName);
+  fprintf(source, "//written by zippy_faces from %s; change the artwork and run it again rather than editing this\n\n", manifest);
+
+  writeBytes(source, "uint8_t", "FACE_PALETTE", palette.data(), palette.size());
+
+  size_t flashLength = palette.size();
+  for (size_t i = 0; i < images.size(); i++) {
+    EncodedImage* image = &images[i];
+    fprintf(source, "const uint16_t FACE_IMAGE_%s_ROWS[] = {", image->name.c_str());
+    for (size_t row = 0; row < image->rowOffsets.size(); row++)
+      fprintf(source, "%s%u,", row % 16 ? " " : "\n  ", image->rowOffsets[row]);
+    fprintf(source, "\n};\n\n");
+    writeBytes(source, "uint8_t", "FACE_IMAGE_" + image->name + "_RUNS", image->runs.data(), image->runs.size());
+    fprintf(source, "const FaceImage FACE_IMAGE_%s = { %u, %u, %u, %u, FACE_PALETTE, FACE_IMAGE_%s_ROWS, FACE_IMAGE_%s_RUNS };\n\n",
+        image->name.c_str(), image->image.x, image->image.y, image->image.width, image->image.height, image->name.c_str(),
+        image->name.c_str());
+    flashLength += (image->rowOffsets.size() * sizeof(uint16_t)) + image->runs.size() + sizeof(FaceImage);
+  }
+
+  for (size_t i = 0; i < expressions.size(); i++) {
+    Expression* expression = &expressions[i];
+    fprintf(header, "extern const FaceExpression %s;\n", expression->name.c_str());
+    fprintf(source, "const FaceFrame %s_FRAMES[] = {\n", expression->name.c_str());
+    for (size_t frame = 0; frame < expression->frames.size(); frame++) {
+      int image = expression->frames[frame].image;
+      fprintf(source, "  { %s%s, %u },\n", image < 0 ? "NULL" : "&FACE_IMAGE_", image < 0 ? "" : images[image].name.c_str(),
+          expression->frames[frame].durationMillis);
+    }
+    fprintf(source, "};\n\n");
+    fprintf(source, "const FaceExpression %s = { &FACE_IMAGE_%s, %s_FRAMES, %u };\n\n", expression->name.c_str(),
+        images[expression->base].name.c_str(), expression->name.c_str(), (unsigned)expression->frames.size());
+    flashLength += (expression->frames.size() * sizeof(FaceFrame)) + sizeof(FaceExpression);
+  }
+
+  fclose(header);
+  fclose(source);
+  fprintf(stderr, "%lu images, %lu expressions, %lu colors, about %lu bytes of flash\n", (unsigned long)images.size(),
+      (unsigned long)expressions.size(), (unsigned long)palette.size(), (unsigned long)flashLength);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 3) {
+    fprintf(stderr, "usage: %s <manifest> <output path, without .h or .cpp>\n", argv[0]);
+    return 1;
+  }
+
+  if (!readManifest(argv[1]) || !writeAssets(argv[1], argv[2]))
+    return 1;
+  return 0;
+}
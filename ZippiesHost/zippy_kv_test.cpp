@@ -0,0 +1,369 @@
+
+/**
+ * Exercises the robot's KeyValueStore on a file standing in for its flash, through FileFlashDevice, covering the cases that
+ * are hard to reach on the robot itself...
+ *
+ *   - the log wrapping around the device many times, with every row erased about as often as the others
+ *   - rows being reclaimed under a value that is never written again, which has to be copied forward each time
+ *   - the power being cut at every point in a run of writes, tearing a page or skipping an erase, after which the store must
+ *     start up with each value either old or new, never lost, and carry on
+ *   - the device reporting failed writes and erases, which must be tried again
+ *
+ * Each case prints a line, and the exit code is the number of cases that failed. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_kv_test zippy_kv_test.cpp ../ZippiesTinyScreen/KeyValueStore.cpp \
+ *       ../ZippiesTinyScreen/FileFlashDevice.cpp
+ *
+ *   zippy_kv_test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+#include "../ZippiesTinyScreen/FileFlashDevice.h"
+#include "../ZippiesTinyScreen/KeyValueStore.h"
+
+//the fewest rows the store allows, so that it wraps and reclaims as often as possible
+#define TEST_ROW_COUNT            ((KV_MAX_KEYS / FLASH_PAGES_PER_ROW) + 3)
+#define TEST_KEY_COUNT            3
+#define TEST_STATIC_KEY           0x0100
+#define TEST_WRAP_COUNT           20
+//writes made after the last good value in each power cut run, so that the cut lands in every kind of operation
+#define TEST_CUT_WRITES           12
+
+//a value that carries its own check, so that a record holding the wrong bytes can't pass for a good one
+typedef struct _TestValue
+{
+  uint16_t key;
+  uint32_t counter;
+  uint8_t pattern[32];
+} TestValue;
+
+/**
+ * Passes everything through to the file, but can cut the power after a number of operations, or make the next operation fail.
+ * A write cut short programs only the first half of its page; an erase cut short never starts. Once the power is cut, every
+ * operation is ignored, as it would be on a robot that is no longer running.
+ */
+class TestFlashDevice : public FlashDevice
+{
+
+private:
+  FileFlashDevice* file;
+  long operationsLeft;
+  bool failNext;
+  std::vector<unsigned long> rowEraseCounts;
+
+  bool isCut()
+  {
+    if (operationsLeft < 0)
+      return false;
+    return operationsLeft-- == 0;
+  }
+
+public:
+  TestFlashDevice(FileFlashDevice* f)
+    : file(f),
+      operationsLeft(-1),
+      failNext(false),
+      rowEraseCounts(f->getRowCount(), 0)
+  {}
+
+  void cutAfter(long operations) { operationsLeft = operations; }
+  bool isPowerCut() { return operationsLeft < -1; }
+  void restorePower() { operationsLeft = -1; }
+  void failNextOperation() { failNext = true; }
+  std::vector<unsigned long>* getRowEraseCounts() { return &rowEraseCounts; }
+
+  uint16_t getRowCount() { return file->getRowCount(); }
+  void read(uint32_t offset, void* data, uint32_t length) { file->read(offset, data, length); }
+
+  bool eraseRow(uint16_t row)
+  {
+    if (isPowerCut() || isCut()) {
+      operationsLeft = -2;
+      return true;
+    }
+    if (failNext) {
+      failNext = false;
+      return false;
+    }
+    rowEraseCounts[row]++;
+    return file->eraseRow(row);
+  }
+
+  bool writePage(uint16_t page, const uint8_t* data)
+  {
+    if (isPowerCut())
+      return true;
+    if (isCut()) {
+      uint8_t torn[FLASH_PAGE_SIZE];
+      memset(torn, 0xFF, sizeof(torn));
+      memcpy(torn, data, FLASH_PAGE_SIZE / 2);
+      file->writePage(page, torn);
+      operationsLeft = -2;
+      return true;
+    }
+    if (failNext) {
+      //a failed write leaves the page partly programmed
+      failNext = false;
+      uint8_t partial[FLASH_PAGE_SIZE];
+      memcpy(partial, data, sizeof(partial));
+      memset(partial + (FLASH_PAGE_SIZE / 4), 0x00, FLASH_PAGE_SIZE / 4);
+      file->writePage(page, partial);
+      return false;
+    }
+    return file->writePage(page, data);
+  }
+
+};
+
+char flashPath[] = "/tmp/zippy_kv_testXXXXXX";
+
+//starts each case with the whole device erased
+bool openErased(FileFlashDevice* file)
+{
+  file->close();
+  unlink(flashPath);
+  if (!file->open(flashPath, TEST_ROW_COUNT)) {
+    perror(flashPath);
+    return false;
+  }
+  return true;
+}
+
+TestValue makeValue(uint16_t key, uint32_t counter)
+{
+  TestValue value;
+  memset(&value, 0, sizeof(value));
+  value.key = key;
+  value.counter = counter;
+  for (uint8_t i = 0; i < sizeof(value.pattern); i++)
+    value.pattern[i] = (uint8_t)((counter * 31) + (key * 7) + i);
+  return value;
+}
+
+//returns the counter of the value stored under the key, or -1 if it is missing or not one that was ever put
+long getCounter(KeyValueStore* store, uint16_t key)
+{
+  TestValue value;
+  if (store->get(key, &value, sizeof(value)) != sizeof(value))
+    return -1;
+  TestValue expected = makeValue(key, value.counter);
+  return memcmp(&value, &expected, sizeof(value)) ? -1 : (long)value.counter;
+}
+
+//the counter of the last value put under the key, when the keys are taken in turn for each counter
+long lastCounter(uint32_t writeCount, uint16_t key)
+{
+  long counter = writeCount - 1;
+  while (counter >= 0 && (counter % TEST_KEY_COUNT) != key - 1)
+    counter--;
+  return counter;
+}
+
+void put(KeyValueStore* store, uint16_t key, uint32_t counter)
+{
+  TestValue value = makeValue(key, counter);
+  while (!store->put(key, &value, sizeof(value)))
+    store->loop();
+}
+
+bool report(const char* name, bool passed, const char* detail)
+{
+  printf("%-12s %s  %s\n", name, passed ? "ok  " : "FAIL", detail);
+  return passed;
+}
+
+bool testWrapAround(FileFlashDevice* file)
+{
+  if (!openErased(file))
+    return false;
+
+  TestFlashDevice device(file);
+  KeyValueStore store(&device);
+  store.begin();
+  uint32_t writeCount = TEST_WRAP_COUNT * TEST_ROW_COUNT * FLASH_PAGES_PER_ROW;
+  for (uint32_t i = 0; i < writeCount; i++) {
+    put(&store, 1 + (i % TEST_KEY_COUNT), i);
+    store.flush();
+  }
+
+  //the values must survive a restart as well
+  KeyValueStore restarted(&device);
+  restarted.begin();
+  bool passed = restarted.getStats()->corruptPageCount == 0;
+  for (uint16_t key = 1; key <= TEST_KEY_COUNT; key++)
+    passed = passed && getCounter(&restarted, key) == lastCounter(writeCount, key);
+
+  std::vector<unsigned long>* eraseCounts = device.getRowEraseCounts();
+  unsigned long fewest = eraseCounts->at(0), most = eraseCounts->at(0);
+  for (size_t i = 1; i < eraseCounts->size(); i++) {
+    fewest = eraseCounts->at(i) < fewest ? eraseCounts->at(i) : fewest;
+    most = eraseCounts->at(i) > most ? eraseCounts->at(i) : most;
+  }
+  passed = passed && fewest >= TEST_WRAP_COUNT - 1 && most - fewest <= 1;
+
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lu writes, %lu to %lu erases per row", (unsigned long)writeCount, fewest, most);
+  return report("wrap-around", passed, detail);
+}
+
+bool testReclaim(FileFlashDevice* file)
+{
+  if (!openErased(file))
+    return false;
+
+  TestFlashDevice device(file);
+  KeyValueStore store(&device);
+  store.begin();
+  put(&store, TEST_STATIC_KEY, 1234);
+  store.flush();
+
+  uint32_t writeCount = TEST_WRAP_COUNT * TEST_ROW_COUNT * FLASH_PAGES_PER_ROW;
+  bool passed = true;
+  for (uint32_t i = 0; i < writeCount; i++) {
+    put(&store, 1, i);
+    store.flush();
+    passed = passed && getCounter(&store, TEST_STATIC_KEY) == 1234;
+  }
+
+  KeyValueStore restarted(&device);
+  restarted.begin();
+  passed = passed && getCounter(&restarted, TEST_STATIC_KEY) == 1234 && getCounter(&restarted, 1) == (long)writeCount - 1;
+  //it has to have been copied forward at least once each time the log came round
+  passed = passed && store.getStats()->relocationCount >= TEST_WRAP_COUNT - 1;
+
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lu relocations over %d trips round the log", store.getStats()->relocationCount,
+      TEST_WRAP_COUNT);
+  return report("reclaim", passed, detail);
+}
+
+bool testPowerCuts(FileFlashDevice* file)
+{
+  bool passed = true;
+  unsigned long runCount = 0, cornerCount = 0, corruptCount = 0;
+  //the log is started at every page of the device, so that the cuts land at every point in the wrap-around too
+  for (uint32_t start = 0; passed && start < TEST_ROW_COUNT * FLASH_PAGES_PER_ROW; start++) {
+    for (long cut = 0; passed; cut++) {
+      if (!openErased(file))
+        return false;
+
+      //fill the log up to the starting point, then note the values that must not be lost
+      TestFlashDevice device(file);
+      KeyValueStore store(&device);
+      store.begin();
+      put(&store, TEST_STATIC_KEY, 1);
+      uint32_t counter = 0;
+      for (; counter < start; counter++) {
+        put(&store, 1 + (counter % TEST_KEY_COUNT), counter);
+        store.flush();
+      }
+      store.flush();
+      long before[TEST_KEY_COUNT + 1];
+      for (uint16_t key = 1; key <= TEST_KEY_COUNT; key++)
+        before[key] = getCounter(&store, key);
+
+      device.cutAfter(cut);
+      for (uint32_t i = 0; i < TEST_CUT_WRITES; i++) {
+        put(&store, 1 + ((counter + i) % TEST_KEY_COUNT), counter + i);
+        store.flush();
+      }
+      if (!device.isPowerCut())
+        break;
+      runCount++;
+      device.restorePower();
+
+      //each value must be where it was, or any of those written since; after that, the store must carry on as normal
+      KeyValueStore restarted(&device);
+      restarted.begin();
+      corruptCount += restarted.getStats()->corruptPageCount;
+      passed = getCounter(&restarted, TEST_STATIC_KEY) == 1;
+      for (uint16_t key = 1; key <= TEST_KEY_COUNT; key++) {
+        long after = getCounter(&restarted, key);
+        passed = passed && after >= before[key] && after < (long)(counter + TEST_CUT_WRITES) &&
+            (after < 0 || (after % TEST_KEY_COUNT) == key - 1);
+        if (after > before[key])
+          cornerCount++;
+      }
+      for (uint32_t i = 0; passed && i < TEST_ROW_COUNT * FLASH_PAGES_PER_ROW; i++) {
+        put(&restarted, 1 + (i % TEST_KEY_COUNT), 1000000 + i);
+        restarted.flush();
+        passed = getCounter(&restarted, 1 + (i % TEST_KEY_COUNT)) == 1000000 + i;
+      }
+      KeyValueStore again(&device);
+      again.begin();
+      passed = passed && getCounter(&again, TEST_STATIC_KEY) == 1 && again.getStats()->corruptPageCount == 0;
+      for (uint16_t key = 1; passed && key <= TEST_KEY_COUNT; key++)
+        passed = getCounter(&again, key) >= 1000000;
+
+      if (!passed)
+        printf("  failed with the log started at page %lu and the power cut after %ld operations\n", (unsigned long)start,
+            cut);
+    }
+  }
+
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lu cuts, %lu torn pages found, %lu values kept from writes in progress", runCount,
+      corruptCount, cornerCount);
+  return report("power cuts", passed && corruptCount > 0, detail);
+}
+
+bool testFailures(FileFlashDevice* file)
+{
+  if (!openErased(file))
+    return false;
+
+  TestFlashDevice device(file);
+  KeyValueStore store(&device);
+  store.begin();
+  put(&store, TEST_STATIC_KEY, 1);
+  store.flush();
+
+  //every other operation fails, which must slow the store down, but never lose or mix up a value
+  bool passed = true;
+  uint32_t writeCount = 4 * TEST_ROW_COUNT * FLASH_PAGES_PER_ROW;
+  for (uint32_t i = 0; i < writeCount; i++) {
+    put(&store, 1 + (i % TEST_KEY_COUNT), i);
+    while (!store.isIdle()) {
+      device.failNextOperation();
+      store.loop();
+      store.loop();
+    }
+    passed = passed && getCounter(&store, 1 + (i % TEST_KEY_COUNT)) == (long)i && getCounter(&store, TEST_STATIC_KEY) == 1;
+  }
+
+  KeyValueStore restarted(&device);
+  restarted.begin();
+  passed = passed && getCounter(&restarted, TEST_STATIC_KEY) == 1 && store.getStats()->failedCount > 0;
+  for (uint16_t key = 1; key <= TEST_KEY_COUNT; key++)
+    passed = passed && getCounter(&restarted, key) == lastCounter(writeCount, key);
+
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lu failed operations tried again", store.getStats()->failedCount);
+  return report("failures", passed, detail);
+}
+
+int main()
+{
+  int descriptor = mkstemp(flashPath);
+  if (descriptor < 0) {
+    perror(flashPath);
+    return 1;
+  }
+  close(descriptor);
+
+  FileFlashDevice file;
+  int failedCount = 0;
+  failedCount += !testWrapAround(&file);
+  failedCount += !testReclaim(&file);
+  failedCount += !testPowerCuts(&file);
+  failedCount += !testFailures(&file);
+
+  file.close();
+  unlink(flashPath);
+  return failedCount;
+}
@@ -0,0 +1,223 @@
+
+/**
+ * Compares the cost of an update of the robot's Pid template with that of PID_v1, which it replaced, and checks that small
+ * heading errors are still integrated. The PID_v1 figures come from a port of the library's Compute(), not the library
+ * itself; see PidV1. Each controller runs the same made-up heading loop, with the autodrive angular gains,
+ * for many updates; the numbers only rank the controllers against each other, since the host has an FPU and a hardware
+ * divide that the SAMD21 lacks. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_pid_bench zippy_pid_bench.cpp
+ *   zippy_pid_bench
+ */
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../ZippiesTinyScreen/FixedPoint.h"
+#include "../ZippiesTinyScreen/Pid.h"
+
+#define BENCH_UPDATE_COUNT        10000000
+//a control step on every third pose from the lighthouse
+#define BENCH_DELTA_SECONDS       0.025f
+//heading error held for the integration check, in radians; well under the few milliradians that Q16.16 used to lose
+#define BENCH_SMALL_ERROR         0.002f
+#define BENCH_SMALL_ERROR_STEPS   400
+
+//the autodrive angular gains; see ZippyCommand.h
+struct BenchPidConfig
+{
+  static constexpr float Kp = 3.0f;
+  static constexpr float Ki = 0.3f;
+  static constexpr float Kd = 0.1f;
+  static constexpr float OutputMin = -4.0f;
+  static constexpr float OutputMax = 4.0f;
+  static constexpr float AntiWindupGain = 1.0f;
+  static constexpr float DerivativeTimeConstant = 0.05f;
+};
+
+//stands in for millis(), which PID_v1 calls on every Compute(); the bench loop moves it on by a sample each update
+unsigned long benchClock = 0;
+
+__attribute__((noinline)) unsigned long benchMillis()
+{
+  return benchClock;
+}
+
+/**
+ * NOT the PID_v1 library itself, which is not part of this tree and cannot be built here; this is a transcription of the
+ * Compute() of Brett Beauregard's Arduino PID Library 1.2, as the sketch used it before the Pid template, so that the
+ * baseline does the same work. Like the library, it works in double through pointers to the input, output and set point,
+ * reads the clock on every call and only computes once the sample time has passed, and supports proportional on
+ * measurement; the gains are scaled by the sample time up front, as its SetTunings() does. Differences in how a compiler
+ * treats this copy and the library's own translation unit, such as inlining, are not accounted for.
+ */
+class PidV1
+{
+
+private:
+  double* myInput;
+  double* myOutput;
+  double* mySetpoint;
+  double kp;
+  double ki;
+  double kd;
+  double outMin;
+  double outMax;
+  double outputSum;
+  double lastInput;
+  unsigned long sampleTime;
+  unsigned long lastTime;
+  bool inAuto;
+  bool pOnE;
+
+public:
+  PidV1(double* input, double* output, double* setPoint)
+    : myInput(input),
+      myOutput(output),
+      mySetpoint(setPoint),
+      kp(BenchPidConfig::Kp),
+      ki(BenchPidConfig::Ki * BENCH_DELTA_SECONDS),
+      kd(BenchPidConfig::Kd / BENCH_DELTA_SECONDS),
+      outMin(BenchPidConfig::OutputMin),
+      outMax(BenchPidConfig::OutputMax),
+      outputSum(0.0d),
+      lastInput(0.0d),
+      sampleTime(BENCH_DELTA_SECONDS * 1000.0f),
+      lastTime(0),
+      inAuto(true),
+      pOnE(true)
+  {
+  }
+
+  bool compute()
+  {
+    if (!inAuto)
+      return false;
+    unsigned long now = benchMillis();
+    unsigned long timeChange = now - lastTime;
+    if (timeChange < sampleTime)
+      return false;
+
+    double input = *myInput;
+    double error = *mySetpoint - input;
+    double dInput = input - lastInput;
+    outputSum += ki * error;
+    if (!pOnE)
+      outputSum -= kp * dInput;
+    if (outputSum > outMax)
+      outputSum = outMax;
+    else if (outputSum < outMin)
+      outputSum = outMin;
+
+    double output = pOnE ? kp * error : 0.0d;
+    output += outputSum - (kd * dInput);
+    if (output > outMax)
+      output = outMax;
+    else if (output < outMin)
+      output = outMin;
+    *myOutput = output;
+
+    lastInput = input;
+    lastTime = now;
+    return true;
+  }
+
+};
+
+unsigned long long readCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+//a heading that wanders around the set point, so that every branch of the controllers gets taken
+float benchMeasurement(int step)
+{
+  return 0.5f * sinf(step * 0.001f);
+}
+
+void report(const char* name, std::chrono::steady_clock::duration elapsed, unsigned long long cycles, float sink)
+{
+  double nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  printf("%-28s %8.2f ns/update", name, nanos / BENCH_UPDATE_COUNT);
+  if (cycles)
+    printf("  %8.2f cycles/update", ((double)cycles) / BENCH_UPDATE_COUNT);
+  printf("  (%g)\n", sink);
+}
+
+template<typename P, typename T>
+void benchPid(const char* name)
+{
+  P pid;
+  T deltaSeconds(BENCH_DELTA_SECONDS);
+  T sink(0.0f);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  unsigned long long startCycles = readCycles();
+  for (int i = 0; i < BENCH_UPDATE_COUNT; i++)
+    sink += pid.update(T(0.0f), T(benchMeasurement(i)), deltaSeconds);
+  unsigned long long cycles = readCycles() - startCycles;
+  report(name, std::chrono::steady_clock::now() - start, cycles, (float)sink.toFloat());
+}
+
+//float has no toFloat(), so it gets its own copy of the loop
+void benchFloatPid(const char* name)
+{
+  Pid<float, BenchPidConfig> pid;
+  float sink = 0.0f;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  unsigned long long startCycles = readCycles();
+  for (int i = 0; i < BENCH_UPDATE_COUNT; i++)
+    sink += pid.update(0.0f, benchMeasurement(i), BENCH_DELTA_SECONDS);
+  unsigned long long cycles = readCycles() - startCycles;
+  report(name, std::chrono::steady_clock::now() - start, cycles, sink);
+}
+
+void benchPidV1(const char* name)
+{
+  double input = 0.0d;
+  double output = 0.0d;
+  double setPoint = 0.0d;
+  PidV1 pid(&input, &output, &setPoint);
+  float sink = 0.0f;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  unsigned long long startCycles = readCycles();
+  for (int i = 0; i < BENCH_UPDATE_COUNT; i++) {
+    benchClock += BENCH_DELTA_SECONDS * 1000.0f;
+    input = benchMeasurement(i);
+    pid.compute();
+    sink += output;
+  }
+  unsigned long long cycles = readCycles() - startCycles;
+  report(name, std::chrono::steady_clock::now() - start, cycles, sink);
+}
+
+//the integral after holding a small, steady heading error
+template<typename P, typename T>
+float smallErrorIntegral()
+{
+  P pid;
+  for (int i = 0; i < BENCH_SMALL_ERROR_STEPS; i++)
+    pid.update(T(BENCH_SMALL_ERROR), T(0.0f), T(BENCH_DELTA_SECONDS));
+  return pid.getIntegral().toFloat();
+}
+
+int main()
+{
+  benchPidV1("PID_v1 port (double)");
+  benchFloatPid("Pid<float>");
+  benchPid<Pid<Fixed16, BenchPidConfig>, Fixed16>("Pid<Fixed16>");
+  benchPid<Pid<Fixed16, BenchPidConfig, Fixed24>, Fixed16>("Pid<Fixed16, ..., Fixed24>");
+
+  float expected = BenchPidConfig::Ki * BENCH_SMALL_ERROR * BENCH_DELTA_SECONDS * BENCH_SMALL_ERROR_STEPS;
+  printf("\nintegral of a %gmrad error over %gs: expected %g, Fixed16 %g, Fixed24 %g\n", BENCH_SMALL_ERROR * 1000.0f,
+      BENCH_DELTA_SECONDS * BENCH_SMALL_ERROR_STEPS, expected, smallErrorIntegral<Pid<Fixed16, BenchPidConfig>, Fixed16>(),
+      smallErrorIntegral<Pid<Fixed16, BenchPidConfig, Fixed24>, Fixed16>());
+  return 0;
+}
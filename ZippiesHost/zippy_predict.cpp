@@ -0,0 +1,449 @@
+
+/**
+ * Measures how far the robot overshoots when it tracks a trajectory against the pose predicted for the moment its output
+ * reaches the motors, as TrajectoryCommand does, compared with tracking against the latest pose from the lighthouse, as it did
+ * before. The robot is a unicycle whose wheels follow the commanded velocities with a first-order lag. A model of the
+ * lighthouse reports a slightly noisy pose every AUTODRIVE_POSE_INTERVAL_MICROS, some time after the sweeps it was measured
+ * from. A control step runs on every third pose, as the sketch does by default, and plans and tracks with the sketch's own
+ * Trajectory and Pid and its default gains; its output reaches the motors a fixed time after the step starts. Each scenario
+ * is run at a few speeds and latencies, averaged over a few seeds of the noise...
+ *
+ *   stop     drive straight ahead and stop; the overshoot is the furthest the robot gets past the end point
+ *   offset   start to the left of a straight path; the overshoot is the furthest the robot swings to the right of it
+ *   corner   turn right through a blended corner; the overshoot is the furthest the robot runs wide of the second leg
+ *
+ * The motor lag and the noise are guesses rather than measurements, so the figures show how the two ways of tracking
+ * compare, not how far a particular robot will overshoot. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_predict zippy_predict.cpp ../ZippiesTinyScreen/Trajectory.cpp
+ *
+ *   zippy_predict
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../ZippiesTinyScreen/FixedPoint.h"
+#include "../ZippiesTinyScreen/Pid.h"
+#include "../ZippiesTinyScreen/Trajectory.h"
+
+//the sketch's timing; see ZippyModes.cpp and LighthouseSensor.cpp
+#define SIM_POSE_INTERVAL_MICROS      8333
+#define SIM_POSE_DECIMATION              3
+#define SIM_MAX_PREDICTION_MICROS    50000
+//from the start of a control step until the motors have been written, including the I2C transfer
+#define SIM_STEP_MICROS               3000
+//the end of a trajectory, as in ZippyCommand.cpp
+#define SIM_POSITION_EPSILON_2      2500.0f
+#define SIM_SETTLE_TIMEOUT_MICROS  1000000
+
+//the robot; see MotorDriver.h
+#define SIM_WHEEL_BASE_MM             30.0f
+#define SIM_MOTOR_TIME_CONSTANT        0.03f
+#define SIM_POSITION_NOISE_MM          0.5f
+#define SIM_HEADING_NOISE              0.01f
+#define SIM_PHYSICS_MICROS             100
+//true poses kept for the lighthouse to report late; enough for the longest latency in main()
+#define SIM_HISTORY_LENGTH             512
+//how long to keep watching once the motors have been stopped, while the wheels spin down
+#define SIM_COAST_MICROS            500000
+
+#define SIM_SEED_COUNT                  10
+#define SIM_STOP_DISTANCE_MM        1000.0f
+#define SIM_OFFSET_MM                 50.0f
+#define SIM_OFFSET_PATH_MM          1500.0f
+#define SIM_CORNER_LEG_MM            800.0f
+
+//the autodrive gains and limits; see ZippyCommand.h
+struct SimLinearPidConfig
+{
+  static constexpr float Kp = 2.0f;
+  static constexpr float Ki = 0.2f;
+  static constexpr float Kd = 0.1f;
+  static constexpr float OutputMin = -150.0f;
+  static constexpr float OutputMax = 150.0f;
+  static constexpr float AntiWindupGain = 1.0f;
+  static constexpr float DerivativeTimeConstant = 0.05f;
+};
+
+struct SimAngularPidConfig
+{
+  static constexpr float Kp = 3.0f;
+  static constexpr float Ki = 0.3f;
+  static constexpr float Kd = 0.1f;
+  static constexpr float OutputMin = -4.0f;
+  static constexpr float OutputMax = 4.0f;
+  static constexpr float AntiWindupGain = 1.0f;
+  static constexpr float DerivativeTimeConstant = 0.05f;
+};
+
+#define SIM_LOOK_AHEAD_DISTANCE      100.0f
+
+typedef struct _SimPose
+{
+  float x;
+  float y;
+  float heading;
+} SimPose;
+
+//a small generator of our own, so that every run sees the same noise on every platform
+class SimNoise
+{
+
+private:
+  unsigned long state;
+
+  float uniform()
+  {
+    state = (state * 1103515245UL) + 12345UL;
+    return ((float)((state >> 8) & 0xFFFFFF) + 0.5f) / 16777216.0f;
+  }
+
+public:
+  SimNoise(unsigned long seed)
+    : state(seed)
+  {}
+
+  float gaussian(float deviation)
+  {
+    return deviation * sqrtf(-2.0f * logf(uniform())) * cosf(2.0f * (float)M_PI * uniform());
+  }
+
+};
+
+class SimRobot
+{
+
+private:
+  bool prediction;
+  SimNoise noise;
+  unsigned long nowMicros;
+
+  //what the robot is really doing, and has been doing for the last SIM_HISTORY_LENGTH steps of the physics
+  SimPose pose;
+  SimPose history[SIM_HISTORY_LENGTH];
+  unsigned long stepCount;
+  float leftVelocity;
+  float rightVelocity;
+  float commandedLeftVelocity;
+  float commandedRightVelocity;
+  //the output of the last control step, which reaches the motors at actuationMicros
+  bool outputPending;
+  unsigned long actuationMicros;
+  float pendingLeftVelocity;
+  float pendingRightVelocity;
+
+  //what the lighthouse last reported, and the report before it, with their times in ms as the sketch keeps them
+  SimPose sensedPose;
+  SimPose previousSensedPose;
+  unsigned long poseTimeMicros;
+  unsigned long sensedTimeStamp;
+  unsigned long previousSensedTimeStamp;
+  unsigned long senseLatencyMicros;
+
+  //the tracking, as in TrajectoryCommand
+  Trajectory trajectory;
+  Pid<Fixed16, SimLinearPidConfig> linearPID;
+  Pid<Fixed16, SimAngularPidConfig, Fixed24> angularPID;
+  unsigned long startTimeMicros;
+  unsigned long previousStepMicros;
+  bool tracking;
+  float linearInput;
+  float angularInput;
+
+  void physicsStep()
+  {
+    if (outputPending && (long)(nowMicros - actuationMicros) >= 0) {
+      commandedLeftVelocity = pendingLeftVelocity;
+      commandedRightVelocity = pendingRightVelocity;
+      outputPending = false;
+    }
+
+    float deltaSeconds = ((float)SIM_PHYSICS_MICROS) / 1000000.0f;
+    float lag = deltaSeconds / (deltaSeconds + SIM_MOTOR_TIME_CONSTANT);
+    leftVelocity += (commandedLeftVelocity - leftVelocity) * lag;
+    rightVelocity += (commandedRightVelocity - rightVelocity) * lag;
+
+    //positive angular velocity is clockwise, when the left wheel is faster
+    float velocity = (leftVelocity + rightVelocity) / 2.0f;
+    pose.heading = wrapAngle(pose.heading + (((leftVelocity - rightVelocity) / SIM_WHEEL_BASE_MM) * deltaSeconds));
+    pose.x += velocity * sinf(pose.heading) * deltaSeconds;
+    pose.y += velocity * cosf(pose.heading) * deltaSeconds;
+    nowMicros += SIM_PHYSICS_MICROS;
+    history[++stepCount % SIM_HISTORY_LENGTH] = pose;
+  }
+
+  //the pose the lighthouse measured senseLatencyMicros ago, which is only now available
+  void sense()
+  {
+    SimPose* measuredPose = &history[(stepCount - (senseLatencyMicros / SIM_PHYSICS_MICROS)) % SIM_HISTORY_LENGTH];
+    previousSensedPose = sensedPose;
+    previousSensedTimeStamp = sensedTimeStamp;
+    poseTimeMicros = nowMicros - senseLatencyMicros;
+    sensedTimeStamp = poseTimeMicros / 1000;
+    sensedPose.x = measuredPose->x + noise.gaussian(SIM_POSITION_NOISE_MM);
+    sensedPose.y = measuredPose->y + noise.gaussian(SIM_POSITION_NOISE_MM);
+    sensedPose.heading = wrapAngle(measuredPose->heading + noise.gaussian(SIM_HEADING_NOISE));
+  }
+
+  //as Lighthouse::predictPose()
+  SimPose predict(unsigned long actuationTimeMicros)
+  {
+    SimPose predicted = sensedPose;
+    unsigned long horizonMicros = actuationTimeMicros - poseTimeMicros;
+    if (horizonMicros > SIM_MAX_PREDICTION_MICROS)
+      horizonMicros = SIM_MAX_PREDICTION_MICROS;
+    float horizonMS = ((float)horizonMicros) / 1000.0f;
+    if (previousSensedTimeStamp && sensedTimeStamp != previousSensedTimeStamp) {
+      float scale = horizonMS / ((float)(sensedTimeStamp - previousSensedTimeStamp));
+      predicted.x += (sensedPose.x - previousSensedPose.x) * scale;
+      predicted.y += (sensedPose.y - previousSensedPose.y) * scale;
+      predicted.heading = wrapAngle(predicted.heading + (wrapAngle(sensedPose.heading - previousSensedPose.heading) * scale));
+    }
+    return predicted;
+  }
+
+  //as TrajectoryCommand::updateInputs()
+  void updateInputs(const SimPose* trackedPose, TrajectoryReference* reference)
+  {
+    float deltaX = reference->x - trackedPose->x;
+    float deltaY = reference->y - trackedPose->y;
+    float alongTrackError = (deltaX * sinf(trackedPose->heading)) + (deltaY * cosf(trackedPose->heading));
+    float crossTrackError = (deltaX * cosf(trackedPose->heading)) - (deltaY * sinf(trackedPose->heading));
+    float headingError = wrapAngle(reference->heading - trackedPose->heading);
+    linearInput = -alongTrackError;
+    angularInput = -(headingError + atan2f(crossTrackError, SIM_LOOK_AHEAD_DISTANCE));
+  }
+
+  //as TrajectoryCommand::loop(), but with or without prediction; returns false once the command has completed
+  bool controlStep()
+  {
+    unsigned long stepStartMicros = nowMicros;
+    unsigned long actuationTimeMicros = stepStartMicros + SIM_STEP_MICROS;
+
+    //without prediction, the command tracks the latest pose against the reference for the start of the step
+    SimPose trackedPose = prediction ? predict(actuationTimeMicros) : sensedPose;
+    unsigned long stepMicros = prediction ? actuationTimeMicros : stepStartMicros;
+    long elapsedTimeMicros = (long)(stepMicros - startTimeMicros);
+    if (elapsedTimeMicros < 0)
+      elapsedTimeMicros = 0;
+
+    TrajectoryReference reference;
+    if (!trajectory.evaluate(((float)elapsedTimeMicros) / 1000000.0f, &reference)) {
+      TrajectoryPoint* endPoint = trajectory.getEndPoint();
+      float deltaX = endPoint->x - trackedPose.x;
+      float deltaY = endPoint->y - trackedPose.y;
+      if ((deltaX*deltaX) + (deltaY*deltaY) < SIM_POSITION_EPSILON_2 ||
+          elapsedTimeMicros > (long)(trajectory.getDuration() * 1000000.0f) + SIM_SETTLE_TIMEOUT_MICROS)
+      {
+        output(actuationTimeMicros, 0.0f, 0.0f);
+        return false;
+      }
+    }
+
+    updateInputs(&trackedPose, &reference);
+    if (!tracking) {
+      linearPID.reset(Fixed16(linearInput), Fixed16(0.0f));
+      angularPID.reset(Fixed16(angularInput), Fixed16(0.0f));
+      previousStepMicros = stepMicros;
+      tracking = true;
+    }
+
+    long deltaMicros = (long)(stepMicros - previousStepMicros);
+    previousStepMicros = stepMicros;
+    Fixed16 deltaSeconds(deltaMicros > 0 ? ((float)deltaMicros) / 1000000.0f : 0.0f);
+    float linearOutput = linearPID.update(Fixed16(0.0f), Fixed16(linearInput), deltaSeconds).toFloat();
+    float angularOutput = angularPID.update(Fixed16(0.0f), Fixed16(angularInput), deltaSeconds).toFloat();
+
+    //as MotorDriver::setVelocity(), without the limits on the wheels, which the speeds here never reach
+    float linearVelocity = (reference.velocity * cosf(reference.heading - trackedPose.heading)) + linearOutput;
+    float angularVelocity = reference.angularVelocity + angularOutput;
+    output(actuationTimeMicros, linearVelocity + (angularVelocity * SIM_WHEEL_BASE_MM / 2.0f),
+           linearVelocity - (angularVelocity * SIM_WHEEL_BASE_MM / 2.0f));
+    return true;
+  }
+
+  void output(unsigned long atMicros, float left, float right)
+  {
+    outputPending = true;
+    actuationMicros = atMicros;
+    pendingLeftVelocity = left;
+    pendingRightVelocity = right;
+  }
+
+public:
+  SimRobot(bool p, unsigned long seed, unsigned long latencyMicros, float maxVelocity)
+    : prediction(p),
+      noise(seed),
+      nowMicros(1000000),
+      stepCount(0),
+      leftVelocity(0.0f),
+      rightVelocity(0.0f),
+      commandedLeftVelocity(0.0f),
+      commandedRightVelocity(0.0f),
+      outputPending(false),
+      actuationMicros(0),
+      pendingLeftVelocity(0.0f),
+      pendingRightVelocity(0.0f),
+      poseTimeMicros(0),
+      sensedTimeStamp(0),
+      previousSensedTimeStamp(0),
+      senseLatencyMicros(latencyMicros),
+      startTimeMicros(0),
+      previousStepMicros(0),
+      tracking(false),
+      linearInput(0.0f),
+      angularInput(0.0f)
+  {
+    place(0.0f, 0.0f, 0.0f);
+    memset(&sensedPose, 0, sizeof(sensedPose));
+    memset(&previousSensedPose, 0, sizeof(previousSensedPose));
+    trajectory.setMaxVelocity(maxVelocity);
+  }
+
+  const SimPose* getPose() { return &pose; }
+  Trajectory* getTrajectory() { return &trajectory; }
+  void place(float x, float y, float heading)
+  {
+    pose.x = x;
+    pose.y = y;
+    pose.heading = heading;
+    for (int i = 0; i < SIM_HISTORY_LENGTH; i++)
+      history[i] = pose;
+  }
+
+  //runs the planned trajectory to completion and for a while after, calling back with the true pose after every step of the
+  //physics so that the scenario can measure it
+  template<typename Observer>
+  void run(Observer* observer)
+  {
+    //a couple of poses to predict from before the command starts
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < SIM_POSE_INTERVAL_MICROS; j += SIM_PHYSICS_MICROS)
+        physicsStep();
+      sense();
+    }
+
+    startTimeMicros = nowMicros;
+    int posesSinceControlStep = SIM_POSE_DECIMATION-1;
+    unsigned long nextPoseMicros = nowMicros;
+    unsigned long coastUntilMicros = 0;
+    bool running = true;
+    while (running || (long)(nowMicros - coastUntilMicros) < 0) {
+      if ((long)(nowMicros - nextPoseMicros) >= 0) {
+        nextPoseMicros += SIM_POSE_INTERVAL_MICROS;
+        sense();
+        if (running && ++posesSinceControlStep >= SIM_POSE_DECIMATION) {
+          posesSinceControlStep = 0;
+          running = controlStep();
+          if (!running)
+            coastUntilMicros = nowMicros + SIM_COAST_MICROS;
+        }
+      }
+      physicsStep();
+      observer->observe(&pose);
+    }
+  }
+
+};
+
+struct StopObserver
+{
+  float endY;
+  float overshoot;
+
+  void observe(const SimPose* pose)
+  {
+    if (pose->y - endY > overshoot)
+      overshoot = pose->y - endY;
+  }
+};
+
+struct OffsetObserver
+{
+  float overshoot;
+
+  void observe(const SimPose* pose)
+  {
+    if (pose->x > overshoot)
+      overshoot = pose->x;
+  }
+};
+
+struct CornerObserver
+{
+  float overshoot;
+
+  void observe(const SimPose* pose)
+  {
+    if (pose->y - SIM_CORNER_LEG_MM > overshoot)
+      overshoot = pose->y - SIM_CORNER_LEG_MM;
+  }
+};
+
+//from the origin facing +y, straight ahead for SIM_STOP_DISTANCE_MM
+float runStop(bool prediction, unsigned long seed, unsigned long latencyMicros, float maxVelocity)
+{
+  SimRobot robot(prediction, seed, latencyMicros, maxVelocity);
+  robot.getTrajectory()->reset(0.0f, 0.0f);
+  robot.getTrajectory()->addWaypoint(0.0f, SIM_STOP_DISTANCE_MM);
+  robot.getTrajectory()->plan();
+  StopObserver observer = { SIM_STOP_DISTANCE_MM, 0.0f };
+  robot.run(&observer);
+  return observer.overshoot;
+}
+
+//along +y from the origin, having started SIM_OFFSET_MM to the left of it
+float runOffset(bool prediction, unsigned long seed, unsigned long latencyMicros, float maxVelocity)
+{
+  SimRobot robot(prediction, seed, latencyMicros, maxVelocity);
+  robot.place(-SIM_OFFSET_MM, 0.0f, 0.0f);
+  robot.getTrajectory()->reset(0.0f, 0.0f);
+  robot.getTrajectory()->addWaypoint(0.0f, SIM_OFFSET_PATH_MM);
+  robot.getTrajectory()->plan();
+  OffsetObserver observer = { 0.0f };
+  robot.run(&observer);
+  return observer.overshoot;
+}
+
+//up +y and then right along +x, with the corner blended by the trajectory
+float runCorner(bool prediction, unsigned long seed, unsigned long latencyMicros, float maxVelocity)
+{
+  SimRobot robot(prediction, seed, latencyMicros, maxVelocity);
+  robot.getTrajectory()->reset(0.0f, 0.0f);
+  robot.getTrajectory()->addWaypoint(0.0f, SIM_CORNER_LEG_MM);
+  robot.getTrajectory()->addWaypoint(SIM_CORNER_LEG_MM, SIM_CORNER_LEG_MM);
+  robot.getTrajectory()->plan();
+  CornerObserver observer = { 0.0f };
+  robot.run(&observer);
+  return observer.overshoot;
+}
+
+int main()
+{
+  const unsigned long latencies[] = { 10000, 25000, 45000 };
+  const float velocities[] = { 150.0f, 300.0f, 450.0f };
+  struct { const char* name; float (*run)(bool, unsigned long, unsigned long, float); } scenarios[] = {
+    { "stop", runStop },
+    { "offset", runOffset },
+    { "corner", runCorner },
+  };
+
+  printf("%-8s %9s %11s %13s %13s\n", "scenario", "velocity", "latency", "without (mm)", "with (mm)");
+  for (size_t s = 0; s < sizeof(scenarios) / sizeof(scenarios[0]); s++) {
+    for (size_t v = 0; v < sizeof(velocities) / sizeof(velocities[0]); v++) {
+      for (size_t l = 0; l < sizeof(latencies) / sizeof(latencies[0]); l++) {
+        float without = 0.0f;
+        float with = 0.0f;
+        for (unsigned long seed = 1; seed <= SIM_SEED_COUNT; seed++) {
+          without += scenarios[s].run(false, seed, latencies[l], velocities[v]);
+          with += scenarios[s].run(true, seed, latencies[l], velocities[v]);
+        }
+        printf("%-8s %4.0f mm/s %8.0f ms %13.1f %13.1f\n", scenarios[s].name, velocities[v],
+               ((float)(latencies[l] + SIM_STEP_MICROS)) / 1000.0f, without / SIM_SEED_COUNT, with / SIM_SEED_COUNT);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,279 @@
+
+/**
+ * Speaks the protocol to the robot's PtyTransport over a real pseudo-terminal, the way a host tool would talk to a robot on a
+ * USB port. The robot's end decodes with the same ProtocolDecoder and command table layout as the sketch, and acknowledges
+ * each packet as the sketch does; the host's end opens the other side of the pseudo-terminal and checks...
+ *
+ *   - that the link only counts as connected once the host has sent something, and until it closes its end
+ *   - that a packet of several frames is handled, and acknowledged with the first failure among them
+ *   - that a packet written a byte at a time, as a slow link would deliver it, still arrives whole
+ *   - that telemetry arrives as telemetry frames, and responses as protocol frames
+ *   - that nothing is sent once the host has closed its end
+ *
+ * Each case prints a line, and the exit code is the number of cases that failed. Build and run with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_pty_test zippy_pty_test.cpp ../ZippiesTinyScreen/PtyTransport.cpp \
+ *       ../ZippiesTinyScreen/Transport.cpp ../ZippiesTinyScreen/Protocol.cpp ../ZippiesTinyScreen/SerialFraming.cpp
+ *
+ *   zippy_pty_test
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "../ZippiesTinyScreen/PtyTransport.h"
+#include "../ZippiesTinyScreen/Protocol.h"
+#include "../ZippiesTinyScreen/SerialFraming.h"
+
+//the kernel moves bytes between the two ends of a pseudo-terminal in the background, so each end polls for a while
+#define TEST_POLL_MICROS          1000
+#define TEST_TIMEOUT_MICROS       1000000
+
+//what the robot's handlers were given
+unsigned long stopCount = 0;
+int32_t leftPower = 0;
+int32_t rightPower = 0;
+
+uint8_t handleStop(uint8_t, uint8_t*, uint8_t)
+{
+  stopCount++;
+  return PROTOCOL_OK;
+}
+
+uint8_t handleSetMotors(uint8_t, uint8_t* payload, uint8_t)
+{
+  memcpy(&leftPower, payload, sizeof(int32_t));
+  memcpy(&rightPower, payload+4, sizeof(int32_t));
+  return PROTOCOL_OK;
+}
+
+//only the first two commands are known, which is enough to exercise every outcome of a frame
+const ProtocolCommand TEST_COMMANDS[] = {
+  { 0, 0, handleStop },                                      //PROTOCOL_STOP
+  { 8, 8, handleSetMotors },                                 //PROTOCOL_SET_MOTORS
+};
+
+/**
+ * The robot's end of the link, serviced the way the sketch services its transports: every packet received is decoded, and
+ * acknowledged in a response on the same link.
+ */
+class TestRobot
+{
+
+private:
+  PtyTransport transport;
+  ProtocolDecoder decoder;
+  unsigned long packetCount;
+
+public:
+  TestRobot()
+    : decoder(TEST_COMMANDS, sizeof(TEST_COMMANDS) / sizeof(TEST_COMMANDS[0])),
+      packetCount(0)
+  {}
+
+  bool start() { return transport.start(); }
+  PtyTransport* getTransport() { return &transport; }
+  unsigned long getPacketCount() { return packetCount; }
+
+  void loop()
+  {
+    transport.loop();
+    ReceivedPacket* packet;
+    while ((packet = transport.peekReceivedPacket()) != NULL) {
+      if (decoder.decode(packet->data, packet->length)) {
+        packetCount++;
+        uint8_t ack[4];
+        decoder.getAck(ack);
+        ProtocolEncoder response;
+        response.addFrame(PROTOCOL_ACK, 0, ack, sizeof(ack));
+        transport.sendResponse(response.getPacket(), response.getPacketLength());
+      }
+      transport.releaseReceivedPacket();
+    }
+  }
+
+  //services the link until the robot has received the given number of packets in all
+  bool waitForPackets(unsigned long count)
+  {
+    for (long waited = 0; packetCount < count && waited < TEST_TIMEOUT_MICROS; waited += TEST_POLL_MICROS) {
+      loop();
+      if (packetCount < count)
+        usleep(TEST_POLL_MICROS);
+    }
+    return packetCount >= count;
+  }
+
+};
+
+//the host's end of the link, opened as a host tool opens a robot's USB port
+int openHostEnd(TestRobot* robot)
+{
+  int descriptor = open(robot->getTransport()->getSlaveName(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (descriptor < 0) {
+    perror(robot->getTransport()->getSlaveName());
+    return -1;
+  }
+
+  struct termios settings;
+  if (tcgetattr(descriptor, &settings) == 0) {
+    cfmakeraw(&settings);
+    tcsetattr(descriptor, TCSANOW, &settings);
+  }
+  return descriptor;
+}
+
+bool sendPacket(int descriptor, ProtocolEncoder* encoder, bool byteAtATime, TestRobot* robot)
+{
+  uint8_t encoded[SERIAL_ENCODED_LENGTH];
+  uint8_t encodedLength = encodeSerialFrame(SERIAL_FRAME_PROTOCOL, encoder->getPacket(), encoder->getPacketLength(), encoded);
+  if (!byteAtATime)
+    return write(descriptor, encoded, encodedLength) == encodedLength;
+
+  //the robot gets to look at the link between every byte, so that it sees the frame in pieces
+  for (uint8_t i = 0; i < encodedLength; i++) {
+    if (write(descriptor, encoded+i, 1) != 1)
+      return false;
+    usleep(TEST_POLL_MICROS);
+    robot->loop();
+  }
+  return true;
+}
+
+//reads until a frame of the given kind arrives, returning the length of its packet, or -1 if none arrives in time
+int receiveFrame(int descriptor, SerialFrameDecoder* decoder, uint8_t kind, uint8_t* packet)
+{
+  for (long waited = 0; waited < TEST_TIMEOUT_MICROS; waited += TEST_POLL_MICROS) {
+    uint8_t b;
+    while (read(descriptor, &b, 1) == 1) {
+      if (decoder->receive(b) && decoder->getKind() == kind) {
+        memcpy(packet, decoder->getPacket(), decoder->getPacketLength());
+        return decoder->getPacketLength();
+      }
+    }
+    usleep(TEST_POLL_MICROS);
+  }
+  return -1;
+}
+
+//checks that the response is a single acknowledgement with the given outcome
+bool isAck(uint8_t* packet, int length, uint8_t lastSequence, uint8_t handledCount, uint8_t failedSequence,
+           uint8_t failedError)
+{
+  uint8_t expected[] = { PROTOCOL_VERSION, PROTOCOL_ACK, 4, 0, lastSequence, handledCount, failedSequence, failedError };
+  return length == sizeof(expected) && !memcmp(packet, expected, sizeof(expected));
+}
+
+bool report(const char* name, bool passed, const char* detail)
+{
+  printf("%-12s %s  %s\n", name, passed ? "ok  " : "FAIL", detail);
+  return passed;
+}
+
+bool testConnect(TestRobot* robot, int* descriptor)
+{
+  //nothing may be sent into the pseudo-terminal until a host is there to read it
+  robot->loop();
+  bool passed = !robot->getTransport()->isConnected();
+  *descriptor = openHostEnd(robot);
+  robot->loop();
+  passed = passed && *descriptor >= 0 && !robot->getTransport()->isConnected();
+
+  ProtocolEncoder encoder;
+  encoder.addFrame(PROTOCOL_STOP, 1, NULL, 0);
+  passed = passed && sendPacket(*descriptor, &encoder, false, robot) && robot->waitForPackets(1) &&
+      robot->getTransport()->isConnected();
+
+  SerialFrameDecoder decoder;
+  uint8_t response[TRANSPORT_PACKET_LENGTH];
+  int length = receiveFrame(*descriptor, &decoder, SERIAL_FRAME_PROTOCOL, response);
+  passed = passed && isAck(response, length, 1, 1, 0, PROTOCOL_OK);
+  return report("connect", passed, robot->getTransport()->getSlaveName());
+}
+
+bool testFrames(TestRobot* robot, int descriptor)
+{
+  //a stop and motors in one packet, then a stop and motors with a short payload, which must fail at its own sequence number
+  int32_t power[2] = { 1200, -800 };
+  ProtocolEncoder encoder;
+  encoder.addFrame(PROTOCOL_STOP, 10, NULL, 0);
+  encoder.addFrame(PROTOCOL_SET_MOTORS, 11, (uint8_t*)power, sizeof(power));
+  unsigned long packetCount = robot->getPacketCount();
+  bool passed = sendPacket(descriptor, &encoder, false, robot) && robot->waitForPackets(packetCount + 1);
+
+  encoder.clear();
+  encoder.addFrame(PROTOCOL_STOP, 12, NULL, 0);
+  encoder.addFrame(PROTOCOL_SET_MOTORS, 13, (uint8_t*)power, 4);
+  passed = passed && sendPacket(descriptor, &encoder, false, robot) && robot->waitForPackets(packetCount + 2);
+
+  SerialFrameDecoder decoder;
+  uint8_t response[TRANSPORT_PACKET_LENGTH];
+  int length = receiveFrame(descriptor, &decoder, SERIAL_FRAME_PROTOCOL, response);
+  passed = passed && isAck(response, length, 11, 2, 0, PROTOCOL_OK);
+  length = receiveFrame(descriptor, &decoder, SERIAL_FRAME_PROTOCOL, response);
+  passed = passed && isAck(response, length, 13, 1, 13, PROTOCOL_ERROR_LENGTH);
+  passed = passed && stopCount == 3 && leftPower == 1200 && rightPower == -800;
+
+  char detail[128];
+  snprintf(detail, sizeof(detail), "%lu stops, motors %d, %d", stopCount, (int)leftPower, (int)rightPower);
+  return report("frames", passed, detail);
+}
+
+bool testPieces(TestRobot* robot, int descriptor)
+{
+  int32_t power[2] = { -5, 5 };
+  ProtocolEncoder encoder;
+  encoder.addFrame(PROTOCOL_SET_MOTORS, 20, (uint8_t*)power, sizeof(power));
+  unsigned long packetCount = robot->getPacketCount();
+  bool passed = sendPacket(descriptor, &encoder, true, robot) && robot->waitForPackets(packetCount + 1);
+
+  SerialFrameDecoder decoder;
+  uint8_t response[TRANSPORT_PACKET_LENGTH];
+  int length = receiveFrame(descriptor, &decoder, SERIAL_FRAME_PROTOCOL, response);
+  passed = passed && isAck(response, length, 20, 1, 0, PROTOCOL_OK) && leftPower == -5 && rightPower == 5;
+  return report("pieces", passed, "one byte at a time");
+}
+
+bool testTelemetry(TestRobot* robot, int descriptor)
+{
+  uint8_t telemetry[TRANSPORT_PACKET_LENGTH];
+  for (uint8_t i = 0; i < sizeof(telemetry); i++)
+    telemetry[i] = 0xC0 + i;
+  bool passed = robot->getTransport()->sendTelemetry(telemetry, sizeof(telemetry));
+
+  SerialFrameDecoder decoder;
+  uint8_t received[TRANSPORT_PACKET_LENGTH];
+  int length = receiveFrame(descriptor, &decoder, SERIAL_FRAME_TELEMETRY, received);
+  passed = passed && length == sizeof(telemetry) && !memcmp(received, telemetry, sizeof(telemetry));
+  return report("telemetry", passed, "a full packet, with bytes that need escaping");
+}
+
+bool testDisconnect(TestRobot* robot, int descriptor)
+{
+  close(descriptor);
+  robot->loop();
+  uint8_t telemetry[4] = { 1, 2, 3, 4 };
+  bool passed = !robot->getTransport()->isConnected() && !robot->getTransport()->sendTelemetry(telemetry, sizeof(telemetry));
+  return report("disconnect", passed, "nothing sent once the host has gone");
+}
+
+int main()
+{
+  TestRobot robot;
+  if (!robot.start()) {
+    perror("posix_openpt");
+    return 1;
+  }
+
+  int descriptor = -1;
+  int failedCount = 0;
+  if (!testConnect(&robot, &descriptor))
+    return 1;
+  failedCount += !testFrames(&robot, descriptor);
+  failedCount += !testPieces(&robot, descriptor);
+  failedCount += !testTelemetry(&robot, descriptor);
+  failedCount += !testDisconnect(&robot, descriptor);
+  return failedCount;
+}
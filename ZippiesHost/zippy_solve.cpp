@@ -0,0 +1,101 @@
+
+/**
+ * Solves poses on the host from the sweeps streamed by a Zippy over USB serial or a pseudo-terminal, and prints them as CSV.
+ * Given a device, it subscribes to the sweeps and base station channels first; given a file recorded from one, it just replays
+ * it. Build with...
+ *
+ *   g++ -std=gnu++11 -O2 -o zippy_solve zippy_solve.cpp SweepSolver.cpp ../ZippiesTinyScreen/LighthouseGeometry.cpp \
+ *       ../ZippiesTinyScreen/TelemetryFormat.cpp ../ZippiesTinyScreen/SerialFraming.cpp ../ZippiesTinyScreen/Protocol.cpp \
+ *       ../ZippiesTinyScreen/KVector.cpp ../ZippiesTinyScreen/KQuaternion.cpp
+ *
+ *   zippy_solve /dev/ttyACM0 > poses.csv
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SweepSolver.h"
+#include "../ZippiesTinyScreen/Protocol.h"
+#include "../ZippiesTinyScreen/SerialFraming.h"
+
+//rate of the base station channel; the whole info block takes three records
+#define ZIPPY_SOLVE_BASE_STATION_RATE    3
+
+void printPose(SolvedPose* pose, void*)
+{
+  printf("%llu,%.1f,%.1f,%.4f,%.1f,%.1f,%.1f,%.1f,%d\n", pose->timeMicros, pose->x, pose->y, pose->heading,
+      pose->leftPosition.getX(), pose->leftPosition.getY(), pose->rightPosition.getX(), pose->rightPosition.getY(),
+      pose->afterGap ? 1 : 0);
+}
+
+bool subscribe(int descriptor)
+{
+  uint8_t channels[] = {
+    TELEMETRY_CHANNEL_SWEEPS, 1,
+    TELEMETRY_CHANNEL_BASE_STATION, ZIPPY_SOLVE_BASE_STATION_RATE,
+  };
+  ProtocolEncoder encoder;
+  encoder.addFrame(PROTOCOL_TELEMETRY_SUBSCRIBE, 1, channels, sizeof(channels));
+
+  uint8_t encoded[SERIAL_ENCODED_LENGTH];
+  uint8_t encodedLength = encodeSerialFrame(SERIAL_FRAME_PROTOCOL, encoder.getPacket(), encoder.getPacketLength(), encoded);
+  return write(descriptor, encoded, encodedLength) == encodedLength;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <device or recording>\n", argv[0]);
+    return 1;
+  }
+
+  int descriptor = open(argv[1], O_RDWR | O_NOCTTY);
+  if (descriptor < 0)
+    descriptor = open(argv[1], O_RDONLY);
+  if (descriptor < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  //only a live robot needs to be asked for sweeps
+  bool live = isatty(descriptor);
+  if (live) {
+    struct termios settings;
+    if (tcgetattr(descriptor, &settings) == 0) {
+      cfmakeraw(&settings);
+      tcsetattr(descriptor, TCSANOW, &settings);
+    }
+    if (!subscribe(descriptor)) {
+      perror("subscribe");
+      return 1;
+    }
+  }
+
+  SweepSolver solver;
+  solver.setPoseHandler(printPose, NULL);
+  SerialFrameDecoder decoder;
+  printf("time_us,x_mm,y_mm,heading_rad,left_x_mm,left_y_mm,right_x_mm,right_y_mm,after_gap\n");
+
+  uint8_t buffer[256];
+  ssize_t readLength;
+  while ((readLength = read(descriptor, buffer, sizeof(buffer))) > 0) {
+    //when the packets are arriving now, the time they arrive shows gaps in the sweeps that the hit times can't
+    unsigned long long receivedMicros = 0;
+    struct timespec now;
+    if (live && clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+      receivedMicros = (((unsigned long long)now.tv_sec) * 1000000ULL) + (now.tv_nsec / 1000);
+    for (ssize_t i = 0; i < readLength; i++) {
+      if (decoder.receive(buffer[i]) && decoder.getKind() == SERIAL_FRAME_TELEMETRY)
+        solver.receiveTelemetry(decoder.getPacket(), decoder.getPacketLength(), receivedMicros);
+    }
+    fflush(stdout);
+  }
+
+  fprintf(stderr, "%lu sweeps, %lu poses, %lu gaps, %lu frame errors\n", solver.getSweepCount(), solver.getPoseCount(),
+      solver.getGapCount(), decoder.getErrorCount());
+  close(descriptor);
+  return 0;
+}
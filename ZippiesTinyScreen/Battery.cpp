@@ -0,0 +1,68 @@
+
+#include <Arduino.h>
+#include "Battery.h"
+
+//written by the interrupt handler and read by the sketch; the filtered result is kept scaled up by BATTERY_FILTER_SHIFT
+volatile uint32_t batteryFilteredResult = 0;
+volatile unsigned long batterySampleCount = 0;
+
+void Battery::start()
+{
+  //http://atmel.force.com/support/articles/en_US/FAQ/ADC-example
+  SYSCTRL->VREF.reg |= SYSCTRL_VREF_BGOUTEN;
+
+  ADC->CTRLA.bit.ENABLE = 0;
+  while (ADC->STATUS.bit.SYNCBUSY == 1);
+
+  //the bandgap against half the supply, with the input halved to match, so that a full-scale result is the supply voltage
+  ADC->REFCTRL.reg = ADC_REFCTRL_REFSEL_INTVCC1;
+  ADC->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS_BANDGAP | ADC_INPUTCTRL_MUXNEG_GND | ADC_INPUTCTRL_GAIN_DIV2;
+  while (ADC->STATUS.bit.SYNCBUSY == 1);
+
+  //the bandgap is a weak source, so sample it for as long as possible; that also keeps the interrupts few and far between
+  ADC->SAMPCTRL.reg = ADC_SAMPCTRL_SAMPLEN(0x3F);
+  ADC->AVGCTRL.reg = ADC_AVGCTRL_SAMPLENUM_16 | ADC_AVGCTRL_ADJRES(4);
+  ADC->CTRLB.reg = ADC_CTRLB_PRESCALER_DIV512 | ADC_CTRLB_RESSEL_16BIT | ADC_CTRLB_FREERUN;
+  while (ADC->STATUS.bit.SYNCBUSY == 1);
+
+  ADC->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+  ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
+  NVIC_SetPriority(ADC_IRQn, 3);
+  NVIC_EnableIRQ(ADC_IRQn);
+
+  ADC->CTRLA.bit.ENABLE = 1;
+  while (ADC->STATUS.bit.SYNCBUSY == 1);
+  ADC->SWTRIG.bit.START = 1;
+}
+
+bool Battery::hasVoltage()
+{
+  return batterySampleCount > 1;
+}
+
+unsigned long Battery::getMillivolts()
+{
+  uint32_t filteredResult = batteryFilteredResult;
+  if (!filteredResult)
+    return 0;
+
+  return ((BATTERY_BANDGAP_MILLIVOLTS * BATTERY_RESULT_SCALE) << BATTERY_FILTER_SHIFT) / filteredResult;
+}
+
+unsigned long Battery::getSampleCount()
+{
+  return batterySampleCount;
+}
+
+void ADC_Handler()
+{
+  //reading the result clears the interrupt flag
+  uint32_t result = ADC->RESULT.reg;
+
+  //the first result after the reference is changed must not be used; the next one starts the filter off
+  if (batterySampleCount == 1)
+    batteryFilteredResult = result << BATTERY_FILTER_SHIFT;
+  else if (batterySampleCount > 1)
+    batteryFilteredResult += result - (batteryFilteredResult >> BATTERY_FILTER_SHIFT);
+  batterySampleCount++;
+}
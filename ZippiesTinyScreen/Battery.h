@@ -0,0 +1,33 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Keeps a filtered measurement of the supply voltage, sampled in the background by the ADC. The ADC measures the internal
+ * 1.1V bandgap against the supply and averages 16 conversions in hardware for each result; its interrupt handler then
+ * smooths the results further, so the sketch only ever reads the latest value.
+ */
+
+//the bandgap reference, in millivolts, and the resolution of the averaged results
+#define BATTERY_BANDGAP_MILLIVOLTS    1100UL
+#define BATTERY_RESULT_SCALE          4096UL
+//each new result moves the filtered value 1/128th of the way towards it; with a result every few milliseconds, this settles
+//over about a second, which rides out the dips while the motors start up
+#define BATTERY_FILTER_SHIFT             7
+
+class Battery
+{
+
+public:
+  Battery() {}
+
+  void start();
+
+  //false until the ADC has delivered its first usable result
+  bool hasVoltage();
+  unsigned long getMillivolts();
+  //number of results from the ADC so far
+  unsigned long getSampleCount();
+
+};
@@ -0,0 +1,165 @@
+
+#include <math.h>
+#include "Behavior.h"
+
+BehaviorInterpreter::BehaviorInterpreter()
+  : programCounter(0),
+    running(false),
+    minArcRadius(0.0f)
+{
+  memset(program, BEHAVIOR_END, BEHAVIOR_PROGRAM_SIZE);
+  memset(counters, 0, sizeof(counters));
+}
+
+bool BehaviorInterpreter::write(uint16_t offset, uint8_t* data, uint8_t dataLength)
+{
+  running = false;
+  if (offset + dataLength > BEHAVIOR_PROGRAM_SIZE)
+    return false;
+
+  memcpy(program+offset, data, dataLength);
+  return true;
+}
+
+void BehaviorInterpreter::run()
+{
+  programCounter = 0;
+  memset(counters, 0, sizeof(counters));
+  running = true;
+}
+
+bool BehaviorInterpreter::readUInt8(uint8_t* value)
+{
+  if (programCounter + 1 > BEHAVIOR_PROGRAM_SIZE)
+    return false;
+
+  *value = program[programCounter++];
+  return true;
+}
+
+bool BehaviorInterpreter::readInt16(int16_t* value)
+{
+  if (programCounter + 2 > BEHAVIOR_PROGRAM_SIZE)
+    return false;
+
+  memcpy(value, program+programCounter, sizeof(int16_t));
+  programCounter += 2;
+  return true;
+}
+
+bool BehaviorInterpreter::jump(uint16_t target)
+{
+  if (target >= BEHAVIOR_PROGRAM_SIZE)
+    return false;
+
+  programCounter = target;
+  return true;
+}
+
+uint8_t BehaviorInterpreter::next(const BehaviorPose* pose, BehaviorAction* action)
+{
+  for (int i = 0; running && i < BEHAVIOR_INSTRUCTION_BUDGET; i++) {
+    uint16_t instructionStart = programCounter;
+    uint8_t opcode;
+    int16_t a, b, c, d, target;
+    uint8_t counter;
+    if (!readUInt8(&opcode)) {
+      running = false;
+      break;
+    }
+
+    switch (opcode) {
+      case BEHAVIOR_MOVE:
+        if (!readInt16(&a) || !readInt16(&b))
+          break;
+        action->type = BEHAVIOR_MOVE;
+        action->a = a;
+        action->b = b;
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_MOVE_RELATIVE:
+        if (!readInt16(&a) || !readInt16(&b))
+          break;
+        //forward is (sin, cos) of the heading and right is (cos, -sin)
+        action->type = BEHAVIOR_MOVE;
+        action->a = pose->x + (a * sinf(pose->heading)) + (b * cosf(pose->heading));
+        action->b = pose->y + (a * cosf(pose->heading)) - (b * sinf(pose->heading));
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_PAUSE:
+        if (!readInt16(&a))
+          break;
+        action->type = BEHAVIOR_PAUSE;
+        action->a = ((float)(uint16_t)a) / 1000.0f;
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_TURN:
+        if (!readInt16(&a))
+          break;
+        action->type = BEHAVIOR_TURN;
+        action->a = ((float)a) / 1000.0f;
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_TURN_RELATIVE:
+        if (!readInt16(&a))
+          break;
+        action->type = BEHAVIOR_TURN;
+        action->a = pose->heading + (((float)a) / 1000.0f);
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_DRIVE_DISTANCE:
+        if (!readInt16(&a))
+          break;
+        action->type = BEHAVIOR_DRIVE_DISTANCE;
+        action->a = a;
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_DRIVE_ARC:
+        if (!readInt16(&a) || !readInt16(&b) || a <= 0 || a < minArcRadius)
+          break;
+        action->type = BEHAVIOR_DRIVE_ARC;
+        action->a = a;
+        action->b = ((float)b) / 1000.0f;
+        return BEHAVIOR_RESULT_COMMAND;
+
+      case BEHAVIOR_WAIT_SIGNAL:
+        if (!pose->hasSignal) {
+          //try this instruction again next time
+          programCounter = instructionStart;
+          return BEHAVIOR_RESULT_WAITING;
+        }
+        continue;
+
+      case BEHAVIOR_SET_COUNTER:
+        if (!readUInt8(&counter) || counter >= BEHAVIOR_COUNTER_COUNT || !readInt16(&a))
+          break;
+        counters[counter] = a;
+        continue;
+
+      case BEHAVIOR_LOOP:
+        if (!readUInt8(&counter) || counter >= BEHAVIOR_COUNTER_COUNT || !readInt16(&target))
+          break;
+        counters[counter]--;
+        if (counters[counter] > 0 && !jump((uint16_t)target))
+          break;
+        continue;
+
+      case BEHAVIOR_JUMP:
+        if (!readInt16(&target) || !jump((uint16_t)target))
+          break;
+        continue;
+
+      case BEHAVIOR_JUMP_IF_IN_ZONE:
+        if (!readInt16(&a) || !readInt16(&b) || !readInt16(&c) || !readInt16(&d) || !readInt16(&target))
+          break;
+        if (pose->x >= a && pose->y >= b && pose->x <= c && pose->y <= d && !jump((uint16_t)target))
+          break;
+        continue;
+    }
+
+    //either the end of the program or a malformed instruction
+    running = false;
+  }
+
+  return running ? BEHAVIOR_RESULT_WAITING : BEHAVIOR_RESULT_ENDED;
+}
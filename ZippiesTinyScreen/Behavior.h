@@ -0,0 +1,108 @@
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Bytecode for on-board decision logic. Each instruction is an opcode byte followed by little-endian operands; jump targets
+ * are byte offsets from the start of the program. Distances are in mm and angles in milliradians, clockwise from +y.
+ *
+ *   0x00 END
+ *   0x01 MOVE              x int16, y int16              drive to an absolute point
+ *   0x02 MOVE_RELATIVE     forward int16, right int16    drive to a point relative to the current pose
+ *   0x03 PAUSE             duration uint16 (ms)
+ *   0x04 TURN              heading int16                 rotate to an absolute heading
+ *   0x05 TURN_RELATIVE     angle int16                   rotate relative to the current heading
+ *   0x06 WAIT_SIGNAL                                     wait until the lighthouse signal is available
+ *   0x07 SET_COUNTER       counter uint8, value int16
+ *   0x08 LOOP              counter uint8, target uint16  decrement the counter and jump if it is still above zero
+ *   0x09 JUMP              target uint16
+ *   0x0A JUMP_IF_IN_ZONE   minX int16, minY int16, maxX int16, maxY int16, target uint16
+ *   0x0B DRIVE_DISTANCE    distance int16                drive straight ahead, or back up if the distance is negative
+ *   0x0C DRIVE_ARC         radius int16, angle int16     drive along an arc leaving tangent to the current heading
+ *
+ * Instructions that move the robot yield an action and resume with the next instruction once it completes. Any malformed
+ * instruction ends the program, as does an arc whose radius is below the minimum the robot can drive. Like Protocol.h, this
+ * has no Arduino dependencies; the sketch turns each action into a ZippyCommand, while host tools can assemble programs and
+ * run them against a model of the robot.
+ */
+#define BEHAVIOR_END                 0x00
+#define BEHAVIOR_MOVE                0x01
+#define BEHAVIOR_MOVE_RELATIVE       0x02
+#define BEHAVIOR_PAUSE               0x03
+#define BEHAVIOR_TURN                0x04
+#define BEHAVIOR_TURN_RELATIVE       0x05
+#define BEHAVIOR_WAIT_SIGNAL         0x06
+#define BEHAVIOR_SET_COUNTER         0x07
+#define BEHAVIOR_LOOP                0x08
+#define BEHAVIOR_JUMP                0x09
+#define BEHAVIOR_JUMP_IF_IN_ZONE     0x0A
+#define BEHAVIOR_DRIVE_DISTANCE      0x0B
+#define BEHAVIOR_DRIVE_ARC           0x0C
+
+#define BEHAVIOR_PROGRAM_SIZE        256
+#define BEHAVIOR_COUNTER_COUNT         4
+//the most instructions executed on each call to next(), so that a tight loop in a program can never stall the sketch
+#define BEHAVIOR_INSTRUCTION_BUDGET   16
+
+//results of BehaviorInterpreter::next()
+#define BEHAVIOR_RESULT_COMMAND        0
+#define BEHAVIOR_RESULT_WAITING        1
+#define BEHAVIOR_RESULT_ENDED          2
+
+//where the robot is when the program asks; headings are in radians, clockwise from +y
+typedef struct _BehaviorPose
+{
+  float x;
+  float y;
+  float heading;
+  bool hasSignal;
+} BehaviorPose;
+
+/**
+ * An action yielded by a program, with its operands in mm, radians and seconds; relative moves and turns are resolved against
+ * the pose, so every action is one of...
+ *
+ *   BEHAVIOR_MOVE              a is x, b is y
+ *   BEHAVIOR_PAUSE             a is the duration
+ *   BEHAVIOR_TURN              a is the heading, which is not wrapped
+ *   BEHAVIOR_DRIVE_DISTANCE    a is the distance
+ *   BEHAVIOR_DRIVE_ARC         a is the radius, b is the angle
+ */
+typedef struct _BehaviorAction
+{
+  uint8_t type;
+  float a;
+  float b;
+} BehaviorAction;
+
+class BehaviorInterpreter
+{
+
+private:
+  uint8_t program[BEHAVIOR_PROGRAM_SIZE];
+  uint16_t programCounter;
+  int16_t counters[BEHAVIOR_COUNTER_COUNT];
+  bool running;
+  float minArcRadius;
+
+  bool readInt16(int16_t* value);
+  bool readUInt8(uint8_t* value);
+  bool jump(uint16_t target);
+
+public:
+  BehaviorInterpreter();
+
+  //copies part of a program into place; any running program is stopped
+  bool write(uint16_t offset, uint8_t* data, uint8_t dataLength);
+  void run();
+  void stop() { running = false; }
+  bool isRunning() { return running; }
+  //in mm; arcs must have a positive radius of at least this much
+  void setMinArcRadius(float r) { minArcRadius = r; }
+
+  //executes instructions until one of them yields an action
+  uint8_t next(const BehaviorPose* pose, BehaviorAction* action);
+
+};
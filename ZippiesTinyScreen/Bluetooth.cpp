@@ -4,6 +4,7 @@
 #include <STBLE.h>
 
 #include "Bluetooth.h"
+#include "SpiBus.h"
 
 //UUIDs for the bluetooth services published by the Zippy; note that they are in little-endian byte order per the BLE spec
 //5BF1CEC2-EFC2-44D2-81AE-73FCFD5F7A13
@@ -16,6 +17,10 @@ const uint8_t sensorRightReceiveUUID[16] =       { 0xD0, 0xE0, 0x78, 0xE7, 0x30,
 const uint8_t sensorLeftReceiveUUID[16] =       { 0xB5, 0xF4, 0xE1, 0xE5, 0x29, 0xA3, 0x0F, 0x99, 0xC9, 0x44, 0xD5, 0x2B, 0x2D, 0x2C, 0x37, 0x53 };
 //7965B674-B7AE-4E02-B334-872ABBE5999D
 const uint8_t computedDataReceiveUUID[16] =  { 0x9D, 0x99, 0xE5, 0xBB, 0x2A, 0x87, 0x34, 0xB3, 0x02, 0x4E, 0xAE, 0xB7, 0x74, 0xB6, 0x65, 0x79 };
+//A2F5D3B8-6C1E-4E0B-9F47-1D2C3B4A5E60
+const uint8_t responseReceiveUUID[16] =      { 0x60, 0x5E, 0x4A, 0x3B, 0x2C, 0x1D, 0x47, 0x9F, 0x0B, 0x4E, 0x1E, 0x6C, 0xB8, 0xD3, 0xF5, 0xA2 };
+//4D2A9C61-0B7E-4F3A-8E5D-7C19A2B64F08
+const uint8_t telemetryReceiveUUID[16] =     { 0x08, 0x4F, 0xB6, 0xA2, 0x19, 0x7C, 0x5D, 0x8E, 0x3A, 0x4F, 0x7E, 0x0B, 0x61, 0x9C, 0x2A, 0x4D };
 
 //debug output adds extra flash and memory requirements
 #define BLE_DEBUG false
@@ -25,6 +30,9 @@ const uint8_t computedDataReceiveUUID[16] =  { 0x9D, 0x99, 0xE5, 0xBB, 0x2A, 0x8
 
 Bluetooth* currentBluetooth = NULL;
 
+//the display shares the SPI bus with the BlueNRG
+extern SpiBus spiBus;
+
 Bluetooth::Bluetooth()
   : started(false),
     serviceHandle(0),
@@ -32,10 +40,15 @@ Bluetooth::Bluetooth()
     sensorRightReceiveHandle(0),
     sensorLeftReceiveHandle(0),
     computedDataReceiveHandle(0),
+    responseReceiveHandle(0),
+    telemetryReceiveHandle(0),
+    transmitBlocked(false),
     discoveryEnabled(false),
     connectionHandle(0),
-    receivedData(NULL),
-    receivedDataLength(0)
+    connectedMS(0),
+    connectionUpdateRequested(false),
+    connectionInterval(0),
+    slaveLatency(0)
 {
 }
 
@@ -143,6 +156,23 @@ bool Bluetooth::start()
     return false;
   }
 
+  //create the response characteristic, which carries protocol frames such as acknowledgements and the mission status
+  ret = aci_gatt_add_char(serviceHandle, UUID_TYPE_128, responseReceiveUUID, BLE_PACKET_LENGTH, CHAR_PROP_INDICATE, ATTR_PERMISSION_NONE, 0,
+                           16, 1, &responseReceiveHandle);
+  if (ret != BLE_STATUS_SUCCESS) {
+//    SerialUSB.println("Bluetooth failed to add response characteristic.");
+    return false;
+  }
+
+  //create the telemetry characteristic; unlike the others, it uses notifications, which need no confirmation from the client, so
+  //that many packets can be sent in each connection interval
+  ret = aci_gatt_add_char(serviceHandle, UUID_TYPE_128, telemetryReceiveUUID, BLE_PACKET_LENGTH, CHAR_PROP_NOTIFY, ATTR_PERMISSION_NONE, 0,
+                           16, 1, &telemetryReceiveHandle);
+  if (ret != BLE_STATUS_SUCCESS) {
+//    SerialUSB.println("Bluetooth failed to add telemetry characteristic.");
+    return false;
+  }
+
   if (!enableDiscovery()) {
 //    SerialUSB.println("Bluetooth failed to enable discovery.");
     return false;
@@ -184,53 +214,111 @@ bool Bluetooth::enableDiscovery()
 
 tBleStatus Bluetooth::sendSensor0(uint8_t* sendBuffer)
 {
-  return aci_gatt_update_char_value(serviceHandle, sensorRightReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  if (!spiBus.acquire(SPI_CLIENT_RADIO))
+    return BLE_STATUS_BUSY;
+
+  unsigned long startMicros = micros();
+  tBleStatus ret = aci_gatt_update_char_value(serviceHandle, sensorRightReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  stats.busyMicros += micros() - startMicros;
+  spiBus.release(SPI_CLIENT_RADIO);
+  return ret;
 }
 
 tBleStatus Bluetooth::sendSensor1(uint8_t* sendBuffer)
 {
-  return aci_gatt_update_char_value(serviceHandle, sensorLeftReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  if (!spiBus.acquire(SPI_CLIENT_RADIO))
+    return BLE_STATUS_BUSY;
+
+  unsigned long startMicros = micros();
+  tBleStatus ret = aci_gatt_update_char_value(serviceHandle, sensorLeftReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  stats.busyMicros += micros() - startMicros;
+  spiBus.release(SPI_CLIENT_RADIO);
+  return ret;
 }
 
 tBleStatus Bluetooth::sendComputedData(uint8_t* sendBuffer)
 {
-  return aci_gatt_update_char_value(serviceHandle, computedDataReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  if (!spiBus.acquire(SPI_CLIENT_RADIO))
+    return BLE_STATUS_BUSY;
+
+  unsigned long startMicros = micros();
+  tBleStatus ret = aci_gatt_update_char_value(serviceHandle, computedDataReceiveHandle, 0, SENSOR_DATA_LENGTH, sendBuffer);
+  stats.busyMicros += micros() - startMicros;
+  spiBus.release(SPI_CLIENT_RADIO);
+  return ret;
+}
+
+bool Bluetooth::sendResponse(uint8_t* packet, uint8_t length)
+{
+  //acks aren't sent again if this fails, so wait for the bus instead; at most one display band
+  spiBus.acquireWaiting(SPI_CLIENT_RADIO);
+
+  unsigned long startMicros = micros();
+  tBleStatus ret = aci_gatt_update_char_value(serviceHandle, responseReceiveHandle, 0, length, packet);
+  stats.busyMicros += micros() - startMicros;
+  spiBus.release(SPI_CLIENT_RADIO);
+  return ret == BLE_STATUS_SUCCESS;
+}
+
+bool Bluetooth::sendTelemetry(uint8_t* packet, uint8_t length)
+{
+  //once the radio runs out of transmit buffers, wait for it to tell us that it has room again rather than retrying every loop
+  if (transmitBlocked || !spiBus.acquire(SPI_CLIENT_RADIO))
+    return false;
+
+  unsigned long startMicros = micros();
+  tBleStatus ret = aci_gatt_update_char_value(serviceHandle, telemetryReceiveHandle, 0, length, packet);
+  stats.busyMicros += micros() - startMicros;
+  spiBus.release(SPI_CLIENT_RADIO);
+  if (ret == BLE_STATUS_INSUFFICIENT_RESOURCES)
+    transmitBlocked = true;
+  return ret == BLE_STATUS_SUCCESS;
 }
 
-void Bluetooth::packetReceived(uint8_t dataLength, uint8_t *data)
+bool Bluetooth::isConnectionUpdateDue()
 {
-  //received a bluetooth packet; create a buffer to hold it
-  if (receivedData)
-    free(receivedData);
-  receivedData = (uint8_t*)malloc(dataLength);
-
-  //now copy the data over
-  memcpy(receivedData, data, dataLength);
-//  for (int i = 0; i < data_length; i++)
-//    bluetoothReceiveBuffer[i] = att_data[i];
-  receivedDataLength = dataLength;
+  return connectionHandle != 0 && !connectionUpdateRequested && millis() - connectedMS >= BLE_CONNECTION_UPDATE_DELAY_MS;
 }
 
-uint8_t Bluetooth::loop()
+void Bluetooth::loop()
 {
   if (!started)
-    return 0;
+    return;
 
-  if (receivedData) {
-    free(receivedData);
-    receivedData = NULL;
-    receivedDataLength = 0;
+  //the BlueNRG holds its IRQ line high while it has events for us, and the library's interrupt handler moves them into the HCI
+  //queue; with neither, there is nothing for HCI_Process() to do but take the SPI interrupt on and off again
+  if (HCI_Queue_Empty() && !BlueNRG_DataPresent() && !isConnectionUpdateDue()) {
+    stats.idleCount++;
+    return;
   }
-  
+
+  //if the display has the bus, asking for it keeps the display from starting another band until we've had our turn
+  if (!spiBus.acquire(SPI_CLIENT_RADIO))
+    return;
+
+  //one pass each time through the sketch; HCI_Process() handles only the events already read, which are bounded by the
+  //library's packet pool, and anything that arrives meanwhile waits for the next pass
+  unsigned long startMicros = micros();
   HCI_Process();
 
+  if (isConnectionUpdateDue()) {
+    //only ask once; if the client refuses, we live with what it chose
+    connectionUpdateRequested = true;
+    aci_l2cap_connection_parameter_update_request(connectionHandle, BLE_CONNECTION_INTERVAL_MIN, BLE_CONNECTION_INTERVAL_MAX,
+                                                  BLE_CONNECTION_SLAVE_LATENCY, BLE_CONNECTION_SUPERVISION_TIMEOUT);
+  }
+
 //  /*
   if (HCI_Queue_Empty()) {
 //    Enter_LP_Sleep_Mode();
   }
 //  */
 
-  return receivedDataLength;
+  stats.lastLoopMicros = micros() - startMicros;
+  stats.maxLoopMicros = max(stats.maxLoopMicros, stats.lastLoopMicros);
+  stats.busyMicros += stats.lastLoopMicros;
+  stats.processCount++;
+  spiBus.release(SPI_CLIENT_RADIO);
 }
 
 bool Bluetooth::isConnected()
@@ -266,6 +354,21 @@ void HCI_Event_CB(void *blePacket)
               //capture the connection handle
               evt_le_connection_complete *cc = (evt_le_connection_complete *)evt->data;
               currentBluetooth->connectionHandle = cc->handle;
+              currentBluetooth->connectedMS = millis();
+              currentBluetooth->connectionUpdateRequested = false;
+              currentBluetooth->connectionInterval = cc->interval;
+              currentBluetooth->slaveLatency = cc->latency;
+            }
+            break;
+
+          case EVT_LE_CONN_UPDATE_COMPLETE:
+            {
+              //the client changed the connection parameters, possibly in response to our request
+              evt_le_connection_update_complete *cu = (evt_le_connection_update_complete *)evt->data;
+              if (cu->status == BLE_STATUS_SUCCESS) {
+                currentBluetooth->connectionInterval = cu->interval;
+                currentBluetooth->slaveLatency = cu->latency;
+              }
             }
             break;
         }
@@ -280,7 +383,7 @@ void HCI_Event_CB(void *blePacket)
           //read request; a little unclear what exactly what this means
           case EVT_BLUE_GATT_READ_PERMIT_REQ:
             {
-              SerialUSB.println("Bluetooth read requested.");
+//              SerialUSB.println("Bluetooth read requested.");
               evt_gatt_read_permit_req *pr = (evt_gatt_read_permit_req *)blue_evt->data;
               aci_gatt_allow_read(pr->attr_handle);
             }
@@ -290,10 +393,16 @@ void HCI_Event_CB(void *blePacket)
           case EVT_BLUE_GATT_ATTRIBUTE_MODIFIED:
             {
               evt_gatt_attr_modified_IDB05A1 *evt = (evt_gatt_attr_modified_IDB05A1*)blue_evt->data;
+              //received a bluetooth packet; copy it straight out of the HCI buffer
               if (evt->attr_handle == currentBluetooth->characteristicTransmitHandle + 1)
-                currentBluetooth->packetReceived(evt->data_length, evt->att_data);
+                currentBluetooth->receivedPackets.push(evt->att_data, evt->data_length, micros());
             }
             break;
+
+          //the radio has freed up transmit buffers
+          case EVT_BLUE_GATT_TX_POOL_AVAILABLE:
+            currentBluetooth->transmitBlocked = false;
+            break;
         }
       }
       break;
@@ -303,6 +412,9 @@ void HCI_Event_CB(void *blePacket)
       //evt_disconn_complete *evt = (void *)event_pckt->data;
 //      SerialUSB.println("Bluetooth device disconnected.");
       currentBluetooth->connectionHandle = 0;
+      currentBluetooth->connectionInterval = 0;
+      currentBluetooth->slaveLatency = 0;
+      currentBluetooth->transmitBlocked = false;
     
       //make the device discoverable again
       currentBluetooth->enableDiscovery();
@@ -2,10 +2,36 @@
 #pragma once
 #include <STBLE.h>
 #include <arduino_bluenrg_ble.h>
+#include "Transport.h"
 
 #define SENSOR_DATA_LENGTH 20
 
-class Bluetooth
+//the longest write the transmit characteristic accepts, and the longest packet sent on the response and telemetry
+//characteristics
+#define BLE_PACKET_LENGTH          TRANSPORT_PACKET_LENGTH
+
+//after connecting, we ask the client for the shortest connection interval it will allow (in 1.25ms units) with no slave
+//latency, so that commands reach us, and telemetry reaches the client, within a few milliseconds; the supervision timeout is
+//in 10ms units
+#define BLE_CONNECTION_INTERVAL_MIN            6
+#define BLE_CONNECTION_INTERVAL_MAX           12
+#define BLE_CONNECTION_SLAVE_LATENCY           0
+#define BLE_CONNECTION_SUPERVISION_TIMEOUT   200
+//many clients ignore parameter requests made while they are still discovering our services
+#define BLE_CONNECTION_UPDATE_DELAY_MS      1000
+
+typedef struct _BluetoothStats
+{
+  //time spent in the radio library, in loop() and sending, which the rest of the sketch doesn't get
+  unsigned long busyMicros = 0;
+  unsigned long lastLoopMicros = 0;
+  unsigned long maxLoopMicros = 0;
+  //passes through loop() that processed HCI events, and those that found nothing to process
+  unsigned long processCount = 0;
+  unsigned long idleCount = 0;
+} BluetoothStats;
+
+class Bluetooth : public Transport
 {
 private:
   bool started;
@@ -14,28 +40,47 @@ private:
   uint16_t sensorRightReceiveHandle;
   uint16_t sensorLeftReceiveHandle;
   uint16_t computedDataReceiveHandle;
+  uint16_t responseReceiveHandle;
+  uint16_t telemetryReceiveHandle;
+  bool transmitBlocked;
   bool discoveryEnabled;
   uint16_t connectionHandle;
+  unsigned long connectedMS;
+  bool connectionUpdateRequested;
+  uint16_t connectionInterval;
+  uint16_t slaveLatency;
 
-  uint8_t* receivedData;
-  uint8_t receivedDataLength;
+  //written by HCI_Event_CB and read by the sketch
+  PacketQueue receivedPackets;
+
+  BluetoothStats stats;
 
   bool enableDiscovery();
+  bool isConnectionUpdateDue();
   friend void HCI_Event_CB(void *pckt);
-  void packetReceived(uint8_t dataLength, uint8_t *data);
 
 public:
   Bluetooth();
   
   bool start();
-  uint8_t loop();
+  void loop();
   tBleStatus sendSensor0(uint8_t* sendBuffer);
   tBleStatus sendSensor1(uint8_t* sendBuffer);
   tBleStatus sendComputedData(uint8_t* sendBuffer);
-  uint8_t getReceivedDataLength() { return receivedDataLength; }
-  uint8_t* getReceivedData() { return receivedData; }
+  bool sendResponse(uint8_t* packet, uint8_t length);
+  //fails while the radio has no room for more packets
+  bool sendTelemetry(uint8_t* packet, uint8_t length);
+
+  ReceivedPacket* peekReceivedPacket() { return receivedPackets.peek(); }
+  void releaseReceivedPacket() { receivedPackets.release(); }
+  unsigned long getDroppedPacketCount() { return receivedPackets.getDroppedCount(); }
   void stop();
 
   bool isConnected();
+  //the parameters the client actually chose, in the units above
+  uint16_t getConnectionInterval() { return connectionInterval; }
+  uint16_t getSlaveLatency() { return slaveLatency; }
+
+  BluetoothStats* getStats() { return &stats; }
 };
 
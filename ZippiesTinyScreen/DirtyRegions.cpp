@@ -0,0 +1,122 @@
+
+#include "DirtyRegions.h"
+
+bool rectsIntersect(const ScreenRect* a, const ScreenRect* b)
+{
+  return a->x < b->x + b->width && b->x < a->x + a->width && a->y < b->y + b->height && b->y < a->y + a->height;
+}
+
+//true if the rectangles overlap or share an edge, so that their union covers nothing that neither of them does
+bool rectsTouch(const ScreenRect* a, const ScreenRect* b)
+{
+  bool touchX = a->x <= b->x + b->width && b->x <= a->x + a->width;
+  bool touchY = a->y <= b->y + b->height && b->y <= a->y + a->height;
+  if (!touchX || !touchY)
+    return false;
+
+  //rectangles that only meet at a corner, or side by side with different extents, would take in pixels neither has
+  if (a->x == b->x + b->width || b->x == a->x + a->width)
+    return a->y == b->y && a->height == b->height;
+  if (a->y == b->y + b->height || b->y == a->y + a->height)
+    return a->x == b->x && a->width == b->width;
+  return rectsIntersect(a, b);
+}
+
+void unionRect(const ScreenRect* a, const ScreenRect* b, ScreenRect* result)
+{
+  uint8_t left = a->x < b->x ? a->x : b->x;
+  uint8_t top = a->y < b->y ? a->y : b->y;
+  int right = a->x + a->width > b->x + b->width ? a->x + a->width : b->x + b->width;
+  int bottom = a->y + a->height > b->y + b->height ? a->y + a->height : b->y + b->height;
+  result->x = left;
+  result->y = top;
+  result->width = right - left;
+  result->height = bottom - top;
+}
+
+unsigned int rectArea(const ScreenRect* rect)
+{
+  return rect->width * rect->height;
+}
+
+DirtyRegions::DirtyRegions(uint8_t w, uint8_t h)
+  : screenWidth(w),
+    screenHeight(h),
+    regionCount(0)
+{
+}
+
+void DirtyRegions::mark(int x, int y, int width, int height)
+{
+  if (x < 0) {
+    width += x;
+    x = 0;
+  }
+  if (y < 0) {
+    height += y;
+    y = 0;
+  }
+  if (x + width > screenWidth)
+    width = screenWidth - x;
+  if (y + height > screenHeight)
+    height = screenHeight - y;
+  if (width <= 0 || height <= 0)
+    return;
+
+  ScreenRect rect;
+  rect.x = x;
+  rect.y = y;
+  rect.width = width;
+  rect.height = height;
+  add(&rect);
+}
+
+void DirtyRegions::add(ScreenRect* rect)
+{
+  //absorb every region the new one overlaps; the union may then overlap others, so keep going until none do
+  for (uint8_t i = 0; i < regionCount; ) {
+    if (rectsTouch(&regions[i], rect)) {
+      unionRect(&regions[i], rect, rect);
+      regions[i] = regions[--regionCount];
+      i = 0;
+    }
+    else
+      i++;
+  }
+
+  if (regionCount < DIRTY_REGION_COUNT) {
+    regions[regionCount++] = *rect;
+    return;
+  }
+
+  //out of room, so merge with whichever region grows the least
+  uint8_t best = 0;
+  unsigned int bestGrowth = 0xFFFFFFFF;
+  for (uint8_t i = 0; i < regionCount; i++) {
+    ScreenRect merged;
+    unionRect(&regions[i], rect, &merged);
+    unsigned int growth = rectArea(&merged) - rectArea(&regions[i]);
+    if (growth < bestGrowth) {
+      best = i;
+      bestGrowth = growth;
+    }
+  }
+  unionRect(&regions[best], rect, rect);
+  regions[best] = regions[--regionCount];
+  add(rect);
+}
+
+bool DirtyRegions::take(ScreenRect* region)
+{
+  if (!regionCount)
+    return false;
+
+  uint8_t top = 0;
+  for (uint8_t i = 1; i < regionCount; i++) {
+    if (regions[i].y < regions[top].y)
+      top = i;
+  }
+  *region = regions[top];
+  regions[top] = regions[--regionCount];
+  return true;
+}
@@ -0,0 +1,48 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Keeps track of the parts of the screen that no longer match what was last sent to the display, as a handful of rectangles,
+ * so that only those are sent again. Overlapping or touching rectangles are merged as they are marked, and once there is no
+ * room for another, the new one is merged into whichever existing rectangle grows the least by taking it in. Like
+ * FlashDevice.h, this file has no Arduino dependencies.
+ */
+//must be at least one
+#define DIRTY_REGION_COUNT              4
+
+typedef struct _ScreenRect
+{
+  uint8_t x;
+  uint8_t y;
+  uint8_t width;
+  uint8_t height;
+} ScreenRect;
+
+class DirtyRegions
+{
+
+private:
+  uint8_t screenWidth;
+  uint8_t screenHeight;
+  ScreenRect regions[DIRTY_REGION_COUNT];
+  uint8_t regionCount;
+
+  void add(ScreenRect* rect);
+
+public:
+  DirtyRegions(uint8_t screenWidth, uint8_t screenHeight);
+
+  //the rectangle is clipped to the screen
+  void mark(int x, int y, int width, int height);
+  void markAll() { mark(0, 0, screenWidth, screenHeight); }
+  bool isEmpty() { return regionCount == 0; }
+  //takes the region nearest the top of the screen; returns false if there are none
+  bool take(ScreenRect* region);
+  void clear() { regionCount = 0; }
+
+};
+
+bool rectsIntersect(const ScreenRect* a, const ScreenRect* b);
+void unionRect(const ScreenRect* a, const ScreenRect* b, ScreenRect* result);
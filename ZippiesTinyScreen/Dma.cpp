@@ -0,0 +1,61 @@
+
+#include <Arduino.h>
+#include "Dma.h"
+
+//the controller reads the descriptor for a channel from the first table, and writes back the state of a suspended transfer to
+//the second; both must be 16-byte aligned
+__attribute__((__aligned__(16))) DmacDescriptor dmaDescriptors[DMA_CHANNEL_COUNT];
+__attribute__((__aligned__(16))) DmacDescriptor dmaWriteBack[DMA_CHANNEL_COUNT];
+bool dmaStarted = false;
+
+void dmaStart()
+{
+  if (dmaStarted)
+    return;
+
+  PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+  PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+
+  DMAC->CTRL.reg = 0;
+  DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+  DMAC->BASEADDR.reg = (uint32_t)(uintptr_t)dmaDescriptors;
+  DMAC->WRBADDR.reg = (uint32_t)(uintptr_t)dmaWriteBack;
+  DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+  dmaStarted = true;
+}
+
+void dmaStartTransfer(uint8_t channel, uint8_t trigger, const volatile void* source, bool incrementSource,
+                      volatile void* destination, bool incrementDestination, uint16_t beatCount)
+{
+  DMAC->CHID.reg = DMAC_CHID_ID(channel);
+  DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+  DMAC->CHCTRLA.reg = DMAC_CHCTRLA_SWRST;
+  DMAC->CHCTRLB.reg = DMAC_CHCTRLB_LVL(0) | DMAC_CHCTRLB_TRIGSRC(trigger) | DMAC_CHCTRLB_TRIGACT_BEAT;
+  DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR;
+
+  //an address that advances is given as the end of the block, not the start
+  uint32_t sourceAddress = (uint32_t)(uintptr_t)source;
+  uint32_t destinationAddress = (uint32_t)(uintptr_t)destination;
+  DmacDescriptor* descriptor = &dmaDescriptors[channel];
+  descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_BLOCKACT_NOACT;
+  if (incrementSource) {
+    descriptor->BTCTRL.reg |= DMAC_BTCTRL_SRCINC;
+    sourceAddress += beatCount;
+  }
+  if (incrementDestination) {
+    descriptor->BTCTRL.reg |= DMAC_BTCTRL_DSTINC;
+    destinationAddress += beatCount;
+  }
+  descriptor->BTCNT.reg = beatCount;
+  descriptor->SRCADDR.reg = sourceAddress;
+  descriptor->DSTADDR.reg = destinationAddress;
+  descriptor->DESCADDR.reg = 0;
+
+  DMAC->CHCTRLA.reg |= DMAC_CHCTRLA_ENABLE;
+}
+
+bool dmaIsComplete(uint8_t channel)
+{
+  DMAC->CHID.reg = DMAC_CHID_ID(channel);
+  return DMAC->CHINTFLAG.reg & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR);
+}
@@ -0,0 +1,21 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Moves data between memory and peripherals through the SAMD21's DMA controller, so that the CPU only has to start a transfer
+ * and later check that it finished. The controller keeps a descriptor for every channel in one table in RAM; each user of it
+ * is given a channel of its own below.
+ */
+#define DMA_CHANNEL_DISPLAY           0
+#define DMA_CHANNEL_COUNT             1
+
+//sets up the controller; safe to call more than once
+void dmaStart();
+//moves beatCount bytes, one each time the trigger fires; the source and destination each either advance through memory or
+//stay on a peripheral register
+void dmaStartTransfer(uint8_t channel, uint8_t trigger, const volatile void* source, bool incrementSource,
+                      volatile void* destination, bool incrementDestination, uint16_t beatCount);
+//true once the transfer has finished, or failed
+bool dmaIsComplete(uint8_t channel);
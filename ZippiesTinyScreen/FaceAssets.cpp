@@ -0,0 +1,206 @@
+
+#include <stddef.h>
+#include "FaceAssets.h"
+
+//written by zippy_faces from faces/faces.txt; change the artwork and run it again rather than editing this
+
+const uint8_t FACE_PALETTE[] = {
+  0x1b,0x17,0x09,0x00,0x12,0x05,0x0e,0x0d,0x04,0x24,0x29,0xdf,0xff,0x6d,0x92,0x76,0x9b,0x16,0xbb,0x2d,0x96,0x72,0xb7,0xdb,
+  0xb6,0x49,0x4d,0x52,0x77,0x56,0x57,0x97,
+};
+
+const uint16_t FACE_IMAGE_HAPPY_ROWS[] = {
+  0, 2, 14, 31, 46, 62, 74, 86, 97, 119, 144, 171, 201, 228, 253, 283,
+  314, 343, 372, 402, 426, 452, 476, 504, 531, 556, 579, 590, 601, 613, 625, 637,
+  648, 659, 670, 680, 692, 704, 716, 728, 739, 751, 763, 774, 785, 797, 808, 820,
+  832, 843, 855, 867, 883, 898, 915, 936, 947, 959, 961, 966, 979, 992, 1004, 1013,
+};
+
+const uint8_t FACE_IMAGE_HAPPY_RUNS[] = {
+  0x07,0x59,0x07,0x19,0x08,0x10,0x19,0x20,0x08,0x07,0x0e,0x0d,0x07,0x18,0x07,0x16,0x08,0x10,0x1f,0x01,0x28,0x20,0x07,0x09,
+  0x20,0x1f,0x01,0x10,0x20,0x07,0x15,0x07,0x15,0x10,0x1f,0x05,0x30,0x07,0x08,0x10,0x1f,0x03,0x28,0x08,0x07,0x13,0x07,0x14,
+  0x10,0x1f,0x06,0x20,0x07,0x08,0x08,0x21,0x38,0x1f,0x02,0x20,0x07,0x12,0x07,0x14,0x1d,0x40,0x25,0x08,0x07,0x0f,0x30,0x1e,
+  0x07,0x12,0x07,0x14,0x1b,0x28,0x08,0x07,0x19,0x10,0x1c,0x20,0x07,0x11,0x07,0x14,0x1a,0x28,0x07,0x1c,0x20,0x1b,0x10,0x07,
+  0x11,0x07,0x0a,0x20,0x28,0x40,0x20,0x05,0x40,0x18,0x28,0x06,0x08,0x28,0x40,0x10,0x07,0x13,0x38,0x1a,0x08,0x07,0x11,0x07,
+  0x08,0x08,0x40,0x1b,0x10,0x04,0x20,0x40,0x06,0x08,0x19,0x48,0x50,0x20,0x07,0x06,0x21,0x08,0x07,0x03,0x40,0x19,0x07,0x12,
+  0x07,0x07,0x08,0x1b,0x40,0x30,0x40,0x08,0x07,0x06,0x1a,0x58,0x60,0x50,0x07,0x05,0x10,0x19,0x40,0x08,0x07,0x02,0x20,0x18,
+  0x20,0x07,0x12,0x07,0x07,0x10,0x18,0x30,0x08,0x19,0x08,0x07,0x07,0x30,0x1a,0x68,0x70,0x18,0x20,0x07,0x03,0x20,0x19,0x79,
+  0x10,0x08,0x07,0x08,0x38,0x11,0x20,0x07,0x0a,0x07,0x06,0x20,0x18,0x30,0x01,0x1a,0x07,0x07,0x1e,0x10,0x07,0x03,0x40,0x19,
+  0x58,0x80,0x18,0x10,0x07,0x07,0x10,0x1b,0x40,0x08,0x07,0x08,0x07,0x06,0x19,0x02,0x1a,0x38,0x07,0x05,0x20,0x1e,0x40,0x07,
+  0x02,0x08,0x1a,0x49,0x19,0x07,0x07,0x88,0x21,0x1b,0x08,0x07,0x07,0x07,0x06,0x18,0x40,0x02,0x18,0x28,0x40,0x18,0x38,0x07,
+  0x04,0x10,0x1e,0x38,0x07,0x02,0x88,0x1e,0x20,0x07,0x08,0x38,0x18,0x10,0x30,0x18,0x10,0x07,0x07,0x07,0x06,0x20,0x03,0x18,
+  0x10,0x90,0x48,0x18,0x10,0x07,0x03,0x08,0x1e,0x08,0x07,0x02,0x88,0x1e,0x10,0x07,0x07,0x20,0x19,0x10,0x00,0x38,0x18,0x20,
+  0x07,0x06,0x07,0x0b,0x18,0x28,0x60,0x58,0x98,0x18,0x40,0x08,0x07,0x01,0x08,0x1d,0x28,0x07,0x03,0x88,0x1e,0x38,0x07,0x06,
+  0x30,0x1a,0x20,0x01,0x19,0x07,0x06,0x07,0x0b,0x19,0x62,0x70,0x19,0x88,0x07,0x01,0x10,0x1c,0x08,0x07,0x03,0x08,0x1e,0x08,
+  0x07,0x04,0x08,0x10,0x19,0x40,0x18,0x02,0x38,0x10,0x07,0x06,0x07,0x0b,0x19,0x63,0xa0,0x40,0x18,0x10,0x08,0x06,0x10,0x19,
+  0x10,0x88,0x07,0x05,0x10,0x1c,0x28,0x07,0x04,0x20,0x40,0x18,0x40,0x90,0x50,0x18,0x07,0x0b,0x07,0x0b,0x19,0x64,0x58,0x98,
+  0x19,0x10,0x08,0x07,0x10,0x40,0x1b,0x88,0x07,0x02,0x20,0x40,0x19,0xa8,0x61,0x19,0x07,0x0b,0x07,0x0b,0x19,0x66,0xb0,0x50,
+  0x19,0x10,0x20,0x07,0x0f,0x38,0x18,0x10,0x88,0x06,0x08,0x30,0x1a,0x50,0xb8,0x62,0x18,0x40,0x07,0x0b,0x07,0x0b,0x19,0x67,
+  0x02,0xc0,0xc8,0x19,0x40,0x20,0x08,0x07,0x15,0x20,0x28,0x19,0x40,0xd0,0xb8,0x64,0x18,0x30,0x07,0x0b,0x07,0x0b,0x10,0x18,
+  0x67,0x04,0x90,0xd8,0x40,0x1a,0x30,0x20,0x07,0x0d,0x08,0x20,0x30,0x40,0x1a,0x50,0x78,0x58,0x65,0x90,0x18,0x30,0x07,0x0b,
+  0x07,0x0b,0x30,0x18,0x67,0x06,0x58,0xe0,0xd0,0x40,0x1b,0x40,0x30,0x27,0x06,0x10,0x1d,0x50,0xa8,0x58,0x67,0x02,0xd8,0x18,
+  0x30,0x07,0x0b,0x07,0x0b,0x30,0x18,0x67,0x09,0x58,0x80,0xe8,0xc8,0x40,0x1f,0x0a,0x50,0xd0,0xf0,0x90,0x58,0x67,0x05,0x68,
+  0x18,0x30,0x07,0x0b,0x07,0x0b,0x30,0x18,0x67,0x0d,0x58,0xb9,0x90,0xd8,0xcf,0x01,0xd8,0x90,0xb9,0x58,0x67,0x0a,0x68,0x18,
+  0x08,0x07,0x0b,0x07,0x0b,0x30,0x18,0xb8,0x67,0x2f,0x68,0x18,0x07,0x0c,0x07,0x0b,0x30,0x18,0xd8,0x67,0x2f,0xc8,0x18,0x07,
+  0x0c,0x07,0x0b,0x30,0x18,0x68,0x67,0x2e,0x58,0x40,0x18,0x07,0x0c,0x07,0x0b,0x30,0x18,0x68,0x67,0x2e,0xb8,0x18,0x10,0x07,
+  0x0c,0x07,0x0b,0x08,0x18,0x68,0x67,0x2e,0xb8,0x18,0x20,0x07,0x0c,0x07,0x0c,0x18,0x68,0x67,0x2e,0x80,0x18,0x30,0x07,0x0c,
+  0x07,0x0c,0x18,0xc8,0x67,0x2e,0xd8,0x18,0x20,0x07,0x0c,0x07,0x0c,0x18,0x40,0x58,0x67,0x2d,0xc8,0x18,0x07,0x0d,0x07,0x0c,
+  0x19,0xb8,0x67,0x2d,0xc8,0x18,0x07,0x0d,0x07,0x0c,0x30,0x18,0xb8,0x67,0x2c,0x58,0x40,0x18,0x07,0x0d,0x07,0x0c,0x20,0x18,
+  0x80,0x67,0x2c,0xb8,0x18,0x10,0x07,0x0d,0x07,0x0c,0x30,0x18,0xd8,0x67,0x2c,0x80,0x18,0x20,0x07,0x0d,0x07,0x0c,0x08,0x18,
+  0xc8,0x67,0x2c,0xd8,0x18,0x20,0x07,0x0d,0x07,0x0d,0x18,0x40,0x58,0x67,0x2b,0xc8,0x18,0x07,0x0e,0x07,0x0d,0x10,0x18,0xb8,
+  0x67,0x2a,0x58,0x40,0x18,0x07,0x0e,0x07,0x0d,0x20,0x18,0x78,0x67,0x2a,0xf8,0x18,0x20,0x07,0x0e,0x07,0x0e,0x18,0x50,0x67,
+  0x2a,0x98,0x18,0x88,0x07,0x0e,0x07,0x0e,0x28,0x18,0xb8,0x67,0x29,0x48,0x40,0x07,0x0f,0x07,0x0e,0x20,0x18,0xd0,0x67,0x28,
+  0xa0,0x18,0x30,0x07,0x0f,0x07,0x0f,0x19,0xb8,0x67,0x27,0x50,0x18,0x08,0x07,0x0f,0x07,0x0f,0x20,0x18,0xc8,0x67,0x26,0xf8,
+  0x18,0x10,0x07,0x10,0x07,0x10,0x28,0x18,0xa0,0x67,0x25,0x28,0x18,0x08,0x07,0x10,0x07,0x11,0x19,0xc0,0x67,0x23,0xd8,0x18,
+  0x38,0x07,0x11,0x07,0x11,0x20,0x19,0xc0,0x67,0x21,0xc0,0x18,0x28,0x07,0x12,0x07,0x12,0x20,0x19,0xa0,0x67,0x1f,0x70,0x18,
+  0x40,0x07,0x13,0x07,0x13,0x88,0x40,0x18,0x98,0x80,0x67,0x1b,0x58,0x98,0x18,0x40,0x08,0x07,0x13,0x07,0x15,0x10,0x19,0x98,
+  0x80,0x67,0x17,0x58,0xa8,0x40,0x18,0x10,0x07,0x15,0x07,0x16,0x08,0x10,0x19,0x40,0xd0,0x78,0x58,0x67,0x11,0xa0,0xd0,0x1a,
+  0x20,0x07,0x16,0x07,0x18,0x08,0x38,0x1b,0x10,0xd8,0x71,0x80,0x58,0x67,0x06,0x80,0x70,0xd8,0x10,0x1a,0x40,0x30,0x07,0x18,
+  0x07,0x1b,0x08,0x38,0x10,0x1f,0x11,0x10,0x20,0x07,0x1a,0x07,0x20,0x08,0x38,0x14,0x40,0x1d,0x28,0x12,0x30,0x07,0x1f,0x07,
+  0x59,0x07,0x1d,0x08,0x07,0x34,0x07,0x1d,0x18,0x40,0x20,0x08,0x07,0x08,0x20,0x28,0x08,0x07,0x1f,0x07,0x1d,0x38,0x1a,0x40,
+  0x10,0x27,0x04,0x10,0x1a,0x20,0x07,0x1f,0x07,0x1f,0x08,0x10,0x40,0x1f,0x06,0x40,0x10,0x08,0x07,0x20,0x07,0x23,0x0a,0x20,
+  0x1b,0x20,0x0a,0x07,0x23,0x07,0x59,
+};
+
+const FaceImage FACE_IMAGE_HAPPY = { 0, 0, 96, 64, FACE_PALETTE, FACE_IMAGE_HAPPY_ROWS, FACE_IMAGE_HAPPY_RUNS };
+
+const uint16_t FACE_IMAGE_BLINK_HALF_OVER_HAPPY_ROWS[] = {
+  0, 2, 4, 6, 8, 10, 14,
+};
+
+const uint8_t FACE_IMAGE_BLINK_HALF_OVER_HAPPY_RUNS[] = {
+  0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,0x1f,0x02,0x07,0x0b,0x10,0x1e,0x38,0x07,0x02,0x1f,0x02,
+};
+
+const FaceImage FACE_IMAGE_BLINK_HALF_OVER_HAPPY = { 34, 8, 27, 7, FACE_PALETTE, FACE_IMAGE_BLINK_HALF_OVER_HAPPY_ROWS, FACE_IMAGE_BLINK_HALF_OVER_HAPPY_RUNS };
+
+const uint16_t FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY_ROWS[] = {
+  0, 2, 4, 6, 8, 10, 12, 17, 24, 28, 30, 32, 34,
+};
+
+const uint8_t FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY_RUNS[] = {
+  0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,0x18,0x06,0x18,0x07,0x0b,0x00,0x1e,0x07,0x03,0x18,0x06,0x18,
+  0x07,0x0c,0x1e,0x00,0x07,0x14,0x07,0x14,0x07,0x14,0x07,0x14,
+};
+
+const FaceImage FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY = { 34, 8, 27, 13, FACE_PALETTE, FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY_ROWS, FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY_RUNS };
+
+const uint16_t FACE_IMAGE_LOOK_LEFT_OVER_HAPPY_ROWS[] = {
+  0, 7, 18, 30, 45, 57, 67, 76, 85, 94, 104, 115, 121,
+};
+
+const uint8_t FACE_IMAGE_LOOK_LEFT_OVER_HAPPY_RUNS[] = {
+  0x02,0x08,0x28,0x40,0x10,0x07,0x0f,0x01,0x08,0x19,0x48,0x50,0x20,0x07,0x06,0x21,0x08,0x04,0x01,0x1a,0x58,0x60,0x50,0x07,
+  0x05,0x10,0x19,0x40,0x08,0x03,0x00,0x30,0x1a,0x68,0x70,0x18,0x20,0x07,0x03,0x20,0x19,0x79,0x10,0x08,0x02,0x00,0x1e,0x10,
+  0x07,0x03,0x40,0x19,0x58,0x80,0x18,0x10,0x02,0x20,0x1e,0x40,0x07,0x02,0x08,0x1a,0x49,0x19,0x02,0x10,0x1e,0x38,0x07,0x02,
+  0x88,0x1e,0x20,0x01,0x08,0x1e,0x08,0x07,0x02,0x88,0x1e,0x10,0x01,0x08,0x1d,0x28,0x07,0x03,0x88,0x1e,0x38,0x01,0x00,0x10,
+  0x1c,0x08,0x07,0x03,0x08,0x1e,0x08,0x01,0x01,0x10,0x19,0x10,0x88,0x07,0x05,0x10,0x1c,0x28,0x02,0x07,0x0d,0x40,0x1b,0x88,
+  0x02,0x20,0x07,0x0d,0x38,0x18,0x10,0x88,0x03,
+};
+
+const FaceImage FACE_IMAGE_LOOK_LEFT_OVER_HAPPY = { 32, 8, 29, 13, FACE_PALETTE, FACE_IMAGE_LOOK_LEFT_OVER_HAPPY_ROWS, FACE_IMAGE_LOOK_LEFT_OVER_HAPPY_RUNS };
+
+const uint16_t FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY_ROWS[] = {
+  0, 7, 18, 30, 45, 57, 68, 77, 86, 95, 104, 115, 121,
+};
+
+const uint8_t FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY_RUNS[] = {
+  0x04,0x08,0x28,0x40,0x10,0x07,0x0d,0x03,0x08,0x19,0x48,0x50,0x20,0x07,0x06,0x21,0x08,0x02,0x03,0x1a,0x58,0x60,0x50,0x07,
+  0x05,0x10,0x19,0x40,0x08,0x01,0x02,0x30,0x1a,0x68,0x70,0x18,0x20,0x07,0x03,0x20,0x19,0x79,0x10,0x08,0x00,0x02,0x1e,0x10,
+  0x07,0x03,0x40,0x19,0x58,0x80,0x18,0x10,0x00,0x01,0x20,0x1e,0x40,0x07,0x02,0x08,0x1a,0x49,0x19,0x00,0x01,0x10,0x1e,0x38,
+  0x07,0x02,0x88,0x1e,0x20,0x01,0x08,0x1e,0x08,0x07,0x02,0x88,0x1e,0x10,0x01,0x08,0x1d,0x28,0x07,0x03,0x88,0x1e,0x38,0x02,
+  0x10,0x1c,0x08,0x07,0x03,0x08,0x1e,0x08,0x03,0x10,0x19,0x10,0x88,0x07,0x05,0x10,0x1c,0x28,0x00,0x07,0x0f,0x40,0x1b,0x88,
+  0x00,0x07,0x10,0x38,0x18,0x10,0x88,0x01,
+};
+
+const FaceImage FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY = { 34, 8, 29, 13, FACE_PALETTE, FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY_ROWS, FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY_RUNS };
+
+const uint16_t FACE_IMAGE_SLEEPY_ROWS[] = {
+  0, 2, 14, 31, 46, 62, 74, 86, 97, 114, 129, 144, 159, 178, 201, 231,
+  262, 291, 320, 350, 374, 400, 424, 452, 479, 504, 527, 538, 549, 561, 573, 585,
+  596, 607, 618, 628, 640, 652, 664, 676, 687, 699, 711, 722, 733, 745, 756, 768,
+  780, 791, 803, 815, 831, 846, 863, 884, 895, 907, 909, 914, 927, 940, 952, 961,
+};
+
+const uint8_t FACE_IMAGE_SLEEPY_RUNS[] = {
+  0x07,0x59,0x07,0x19,0x08,0x10,0x19,0x20,0x08,0x07,0x0e,0x0d,0x07,0x18,0x07,0x16,0x08,0x10,0x1f,0x01,0x28,0x20,0x07,0x09,
+  0x20,0x1f,0x01,0x10,0x20,0x07,0x15,0x07,0x15,0x10,0x1f,0x05,0x30,0x07,0x08,0x10,0x1f,0x03,0x28,0x08,0x07,0x13,0x07,0x14,
+  0x10,0x1f,0x06,0x20,0x07,0x08,0x08,0x21,0x38,0x1f,0x02,0x20,0x07,0x12,0x07,0x14,0x1d,0x40,0x25,0x08,0x07,0x0f,0x30,0x1e,
+  0x07,0x12,0x07,0x14,0x1b,0x28,0x08,0x07,0x19,0x10,0x1c,0x20,0x07,0x11,0x07,0x14,0x1a,0x28,0x07,0x1c,0x20,0x1b,0x10,0x07,
+  0x11,0x07,0x0a,0x20,0x28,0x40,0x20,0x05,0x40,0x18,0x28,0x07,0x1e,0x38,0x1a,0x08,0x07,0x11,0x07,0x08,0x08,0x40,0x1b,0x10,
+  0x04,0x20,0x40,0x07,0x20,0x40,0x19,0x07,0x12,0x07,0x07,0x08,0x1b,0x40,0x30,0x40,0x08,0x07,0x26,0x20,0x18,0x20,0x07,0x12,
+  0x07,0x07,0x10,0x18,0x30,0x08,0x19,0x08,0x07,0x2f,0x38,0x11,0x20,0x07,0x0a,0x07,0x06,0x20,0x18,0x30,0x01,0x1a,0x07,0x07,
+  0x1f,0x01,0x07,0x18,0x10,0x1b,0x40,0x08,0x07,0x08,0x07,0x06,0x19,0x02,0x1a,0x38,0x07,0x05,0x20,0x1e,0x40,0x07,0x02,0x1f,
+  0x01,0x07,0x07,0x88,0x21,0x1b,0x08,0x07,0x07,0x07,0x06,0x18,0x40,0x02,0x18,0x28,0x40,0x18,0x38,0x07,0x04,0x10,0x1e,0x38,
+  0x07,0x02,0x88,0x1e,0x20,0x07,0x08,0x38,0x18,0x10,0x30,0x18,0x10,0x07,0x07,0x07,0x06,0x20,0x03,0x18,0x10,0x90,0x48,0x18,
+  0x10,0x07,0x03,0x08,0x1e,0x08,0x07,0x02,0x88,0x1e,0x10,0x07,0x07,0x20,0x19,0x10,0x00,0x38,0x18,0x20,0x07,0x06,0x07,0x0b,
+  0x18,0x28,0x60,0x58,0x98,0x18,0x40,0x08,0x07,0x01,0x08,0x1d,0x28,0x07,0x03,0x88,0x1e,0x38,0x07,0x06,0x30,0x1a,0x20,0x01,
+  0x19,0x07,0x06,0x07,0x0b,0x19,0x62,0x70,0x19,0x88,0x07,0x01,0x10,0x1c,0x08,0x07,0x03,0x08,0x1e,0x08,0x07,0x04,0x08,0x10,
+  0x19,0x40,0x18,0x02,0x38,0x10,0x07,0x06,0x07,0x0b,0x19,0x63,0xa0,0x40,0x18,0x10,0x08,0x06,0x10,0x19,0x10,0x88,0x07,0x05,
+  0x10,0x1c,0x28,0x07,0x04,0x20,0x40,0x18,0x40,0x90,0x50,0x18,0x07,0x0b,0x07,0x0b,0x19,0x64,0x58,0x98,0x19,0x10,0x08,0x07,
+  0x10,0x40,0x1b,0x88,0x07,0x02,0x20,0x40,0x19,0xa8,0x61,0x19,0x07,0x0b,0x07,0x0b,0x19,0x66,0xb0,0x50,0x19,0x10,0x20,0x07,
+  0x0f,0x38,0x18,0x10,0x88,0x06,0x08,0x30,0x1a,0x50,0xb8,0x62,0x18,0x40,0x07,0x0b,0x07,0x0b,0x19,0x67,0x02,0xc0,0xc8,0x19,
+  0x40,0x20,0x08,0x07,0x15,0x20,0x28,0x19,0x40,0xd0,0xb8,0x64,0x18,0x30,0x07,0x0b,0x07,0x0b,0x10,0x18,0x67,0x04,0x90,0xd8,
+  0x40,0x1a,0x30,0x20,0x07,0x0d,0x08,0x20,0x30,0x40,0x1a,0x50,0x78,0x58,0x65,0x90,0x18,0x30,0x07,0x0b,0x07,0x0b,0x30,0x18,
+  0x67,0x06,0x58,0xe0,0xd0,0x40,0x1b,0x40,0x30,0x27,0x06,0x10,0x1d,0x50,0xa8,0x58,0x67,0x02,0xd8,0x18,0x30,0x07,0x0b,0x07,
+  0x0b,0x30,0x18,0x67,0x09,0x58,0x80,0xe8,0xc8,0x40,0x1f,0x0a,0x50,0xd0,0xf0,0x90,0x58,0x67,0x05,0x68,0x18,0x30,0x07,0x0b,
+  0x07,0x0b,0x30,0x18,0x67,0x0d,0x58,0xb9,0x90,0xd8,0xcf,0x01,0xd8,0x90,0xb9,0x58,0x67,0x0a,0x68,0x18,0x08,0x07,0x0b,0x07,
+  0x0b,0x30,0x18,0xb8,0x67,0x2f,0x68,0x18,0x07,0x0c,0x07,0x0b,0x30,0x18,0xd8,0x67,0x2f,0xc8,0x18,0x07,0x0c,0x07,0x0b,0x30,
+  0x18,0x68,0x67,0x2e,0x58,0x40,0x18,0x07,0x0c,0x07,0x0b,0x30,0x18,0x68,0x67,0x2e,0xb8,0x18,0x10,0x07,0x0c,0x07,0x0b,0x08,
+  0x18,0x68,0x67,0x2e,0xb8,0x18,0x20,0x07,0x0c,0x07,0x0c,0x18,0x68,0x67,0x2e,0x80,0x18,0x30,0x07,0x0c,0x07,0x0c,0x18,0xc8,
+  0x67,0x2e,0xd8,0x18,0x20,0x07,0x0c,0x07,0x0c,0x18,0x40,0x58,0x67,0x2d,0xc8,0x18,0x07,0x0d,0x07,0x0c,0x19,0xb8,0x67,0x2d,
+  0xc8,0x18,0x07,0x0d,0x07,0x0c,0x30,0x18,0xb8,0x67,0x2c,0x58,0x40,0x18,0x07,0x0d,0x07,0x0c,0x20,0x18,0x80,0x67,0x2c,0xb8,
+  0x18,0x10,0x07,0x0d,0x07,0x0c,0x30,0x18,0xd8,0x67,0x2c,0x80,0x18,0x20,0x07,0x0d,0x07,0x0c,0x08,0x18,0xc8,0x67,0x2c,0xd8,
+  0x18,0x20,0x07,0x0d,0x07,0x0d,0x18,0x40,0x58,0x67,0x2b,0xc8,0x18,0x07,0x0e,0x07,0x0d,0x10,0x18,0xb8,0x67,0x2a,0x58,0x40,
+  0x18,0x07,0x0e,0x07,0x0d,0x20,0x18,0x78,0x67,0x2a,0xf8,0x18,0x20,0x07,0x0e,0x07,0x0e,0x18,0x50,0x67,0x2a,0x98,0x18,0x88,
+  0x07,0x0e,0x07,0x0e,0x28,0x18,0xb8,0x67,0x29,0x48,0x40,0x07,0x0f,0x07,0x0e,0x20,0x18,0xd0,0x67,0x28,0xa0,0x18,0x30,0x07,
+  0x0f,0x07,0x0f,0x19,0xb8,0x67,0x27,0x50,0x18,0x08,0x07,0x0f,0x07,0x0f,0x20,0x18,0xc8,0x67,0x26,0xf8,0x18,0x10,0x07,0x10,
+  0x07,0x10,0x28,0x18,0xa0,0x67,0x25,0x28,0x18,0x08,0x07,0x10,0x07,0x11,0x19,0xc0,0x67,0x23,0xd8,0x18,0x38,0x07,0x11,0x07,
+  0x11,0x20,0x19,0xc0,0x67,0x21,0xc0,0x18,0x28,0x07,0x12,0x07,0x12,0x20,0x19,0xa0,0x67,0x1f,0x70,0x18,0x40,0x07,0x13,0x07,
+  0x13,0x88,0x40,0x18,0x98,0x80,0x67,0x1b,0x58,0x98,0x18,0x40,0x08,0x07,0x13,0x07,0x15,0x10,0x19,0x98,0x80,0x67,0x17,0x58,
+  0xa8,0x40,0x18,0x10,0x07,0x15,0x07,0x16,0x08,0x10,0x19,0x40,0xd0,0x78,0x58,0x67,0x11,0xa0,0xd0,0x1a,0x20,0x07,0x16,0x07,
+  0x18,0x08,0x38,0x1b,0x10,0xd8,0x71,0x80,0x58,0x67,0x06,0x80,0x70,0xd8,0x10,0x1a,0x40,0x30,0x07,0x18,0x07,0x1b,0x08,0x38,
+  0x10,0x1f,0x11,0x10,0x20,0x07,0x1a,0x07,0x20,0x08,0x38,0x14,0x40,0x1d,0x28,0x12,0x30,0x07,0x1f,0x07,0x59,0x07,0x1d,0x08,
+  0x07,0x34,0x07,0x1d,0x18,0x40,0x20,0x08,0x07,0x08,0x20,0x28,0x08,0x07,0x1f,0x07,0x1d,0x38,0x1a,0x40,0x10,0x27,0x04,0x10,
+  0x1a,0x20,0x07,0x1f,0x07,0x1f,0x08,0x10,0x40,0x1f,0x06,0x40,0x10,0x08,0x07,0x20,0x07,0x23,0x0a,0x20,0x1b,0x20,0x0a,0x07,
+  0x23,0x07,0x59,
+};
+
+const FaceImage FACE_IMAGE_SLEEPY = { 0, 0, 96, 64, FACE_PALETTE, FACE_IMAGE_SLEEPY_ROWS, FACE_IMAGE_SLEEPY_RUNS };
+
+const uint16_t FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY_ROWS[] = {
+  0, 2, 4, 9, 16, 20, 22, 24, 26,
+};
+
+const uint8_t FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY_RUNS[] = {
+  0x07,0x14,0x07,0x14,0x18,0x06,0x18,0x07,0x0b,0x00,0x1e,0x07,0x03,0x18,0x06,0x18,0x07,0x0c,0x1e,0x00,0x07,0x14,0x07,0x14,
+  0x07,0x14,0x07,0x14,
+};
+
+const FaceImage FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY = { 34, 12, 27, 9, FACE_PALETTE, FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY_ROWS, FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY_RUNS };
+
+const FaceFrame FACE_HAPPY_FRAMES[] = {
+  { NULL, 3500 },
+  { &FACE_IMAGE_BLINK_HALF_OVER_HAPPY, 50 },
+  { &FACE_IMAGE_BLINK_CLOSED_OVER_HAPPY, 100 },
+  { &FACE_IMAGE_BLINK_HALF_OVER_HAPPY, 50 },
+};
+
+const FaceExpression FACE_HAPPY = { &FACE_IMAGE_HAPPY, FACE_HAPPY_FRAMES, 4 };
+
+const FaceFrame FACE_SIGNAL_LOST_FRAMES[] = {
+  { NULL, 600 },
+  { &FACE_IMAGE_LOOK_LEFT_OVER_HAPPY, 900 },
+  { NULL, 300 },
+  { &FACE_IMAGE_LOOK_RIGHT_OVER_HAPPY, 900 },
+};
+
+const FaceExpression FACE_SIGNAL_LOST = { &FACE_IMAGE_HAPPY, FACE_SIGNAL_LOST_FRAMES, 4 };
+
+const FaceFrame FACE_LOW_BATTERY_FRAMES[] = {
+  { NULL, 4000 },
+  { &FACE_IMAGE_BLINK_CLOSED_OVER_SLEEPY, 600 },
+};
+
+const FaceExpression FACE_LOW_BATTERY = { &FACE_IMAGE_SLEEPY, FACE_LOW_BATTERY_FRAMES, 2 };
+
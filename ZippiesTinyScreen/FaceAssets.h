@@ -0,0 +1,10 @@
+
+#pragma once
+
+#include "FaceImage.h"
+
+//written by zippy_faces from faces/faces.txt; change the artwork and run it again rather than editing this
+
+extern const FaceExpression FACE_HAPPY;
+extern const FaceExpression FACE_SIGNAL_LOST;
+extern const FaceExpression FACE_LOW_BATTERY;
@@ -0,0 +1,33 @@
+
+#include <string.h>
+#include "FaceImage.h"
+
+void drawFaceImageRow(const FaceImage* image, uint8_t y, uint8_t x, uint8_t width, uint8_t* pixels)
+{
+  if (y < image->y || y >= image->y + image->height)
+    return;
+
+  //only the columns covered by both the image and the request are drawn
+  int left = x > image->x ? x : image->x;
+  int right = x + width < image->x + image->width ? x + width : image->x + image->width;
+  if (left >= right)
+    return;
+
+  const uint8_t* run = image->runs + image->rowOffsets[y - image->y];
+  int column = image->x;
+  while (column < right) {
+    uint8_t code = *run++;
+    int length = (code & FACE_RUN_LONG) + 1;
+    if ((code & FACE_RUN_LONG) == FACE_RUN_LONG)
+      length = *run++ + FACE_RUN_LONG;
+
+    //runs wholly to the left of the request are just skipped over
+    int end = column + length;
+    if (end > left) {
+      int start = column > left ? column : left;
+      int stop = end < right ? end : right;
+      memset(pixels + (start - x), image->palette[code >> 3], stop - start);
+    }
+    column = end;
+  }
+}
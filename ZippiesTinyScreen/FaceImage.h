@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Compressed face images, and the animations made from them. Images are converted from the artwork in ZippiesHost/faces by
+ * zippy_faces, which writes FaceAssets.h and .cpp; nothing here is ever decompressed into a whole frame, just into whatever part of a
+ * row the display is about to be sent. This file has no Arduino dependencies, so that zippy_faces can check its output with
+ * the same decoder the robot uses.
+ *
+ * Each row of an image is a run of bytes of its own, found through a table of offsets, so that any part of any row can be
+ * decoded without the rows above it. Each byte of a row is IIIIILLL; the top five bits index the palette, and the bottom three
+ * are the length of the run of that color, less one, up to 7 pixels. When the length bits are all set, the next byte holds the
+ * length of the run less 7, for runs from 7 to 262 pixels.
+ */
+
+//the most colors a palette may hold
+#define FACE_PALETTE_SIZE 32
+#define FACE_RUN_LONG     0x07
+
+typedef struct _FaceImage
+{
+  //the part of the screen the image covers; the whole screen for the base image of an expression, and only the part that
+  //differs from it for the rest of its frames
+  uint8_t x;
+  uint8_t y;
+  uint8_t width;
+  uint8_t height;
+  //8-bit BBBGGGRR pixels; the images zippy_faces writes all share one
+  const uint8_t* palette;
+  const uint16_t* rowOffsets;
+  const uint8_t* runs;
+} FaceImage;
+
+typedef struct _FaceFrame
+{
+  //drawn over the base image of the expression; NULL for just the base image
+  const FaceImage* image;
+  uint16_t durationMillis;
+} FaceFrame;
+
+typedef struct _FaceExpression
+{
+  const FaceImage* base;
+  const FaceFrame* frames;
+  uint8_t frameCount;
+} FaceExpression;
+
+//decodes the columns of one row of the screen from x to x+width-1 into pixels, which holds the pixel for column x; only the
+//pixels the image actually covers are written, so that frames can be drawn over their base image
+void drawFaceImageRow(const FaceImage* image, uint8_t y, uint8_t x, uint8_t width, uint8_t* pixels);
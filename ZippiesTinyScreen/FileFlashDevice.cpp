@@ -0,0 +1,84 @@
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "FileFlashDevice.h"
+
+FileFlashDevice::FileFlashDevice()
+  : descriptor(-1),
+    rowCount(0),
+    eraseCount(0),
+    writeCount(0)
+{
+}
+
+FileFlashDevice::~FileFlashDevice()
+{
+  close();
+}
+
+bool FileFlashDevice::open(const char* path, uint16_t rows)
+{
+  close();
+  descriptor = ::open(path, O_RDWR | O_CREAT, 0644);
+  if (descriptor < 0)
+    return false;
+
+  //anything beyond the end of the file reads as erased
+  struct stat status;
+  if (fstat(descriptor, &status) != 0) {
+    close();
+    return false;
+  }
+  rowCount = rows;
+  for (uint16_t row = (uint16_t)(status.st_size / FLASH_ROW_SIZE); row < rowCount; row++) {
+    if (!eraseRow(row)) {
+      close();
+      return false;
+    }
+  }
+  eraseCount = 0;
+  return true;
+}
+
+void FileFlashDevice::close()
+{
+  if (descriptor >= 0)
+    ::close(descriptor);
+  descriptor = -1;
+}
+
+void FileFlashDevice::read(uint32_t offset, void* data, uint32_t length)
+{
+  if (pread(descriptor, data, length, offset) != (ssize_t)length)
+    memset(data, 0xFF, length);
+}
+
+bool FileFlashDevice::eraseRow(uint16_t row)
+{
+  uint8_t erased[FLASH_ROW_SIZE];
+  memset(erased, 0xFF, sizeof(erased));
+  if (pwrite(descriptor, erased, sizeof(erased), row * FLASH_ROW_SIZE) != (ssize_t)sizeof(erased))
+    return false;
+  eraseCount++;
+  return true;
+}
+
+bool FileFlashDevice::writePage(uint16_t page, const uint8_t* data)
+{
+  //programming flash can only clear bits
+  uint8_t contents[FLASH_PAGE_SIZE];
+  read(page * FLASH_PAGE_SIZE, contents, sizeof(contents));
+  for (uint8_t i = 0; i < FLASH_PAGE_SIZE; i++)
+    contents[i] &= data[i];
+  if (pwrite(descriptor, contents, sizeof(contents), page * FLASH_PAGE_SIZE) != (ssize_t)sizeof(contents))
+    return false;
+  writeCount++;
+  return true;
+}
+
+#endif
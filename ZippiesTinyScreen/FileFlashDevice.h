@@ -0,0 +1,42 @@
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "FlashDevice.h"
+
+/**
+ * Keeps the contents of a FlashDevice in a file, so that host tools and tests can run the KeyValueStore against the same
+ * rules as the real flash; writes can only clear bits, never set them, until the row is erased again. Only compiled on Linux;
+ * the Arduino build skips it.
+ */
+class FileFlashDevice : public FlashDevice
+{
+
+private:
+  int descriptor;
+  uint16_t rowCount;
+  unsigned long eraseCount;
+  unsigned long writeCount;
+
+public:
+  FileFlashDevice();
+  ~FileFlashDevice();
+
+  //opens the file, creating it with every row erased if it is missing or shorter than rowCount rows; returns false if the
+  //file can't be opened or extended
+  bool open(const char* path, uint16_t rowCount);
+  void close();
+
+  uint16_t getRowCount() { return rowCount; }
+  void read(uint32_t offset, void* data, uint32_t length);
+  //each fails if the file can't be written in full, such as when the disk is full
+  bool eraseRow(uint16_t row);
+  bool writePage(uint16_t page, const uint8_t* data);
+
+  unsigned long getEraseCount() { return eraseCount; }
+  unsigned long getWriteCount() { return writeCount; }
+
+};
+
+#endif
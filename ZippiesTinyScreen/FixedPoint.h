@@ -0,0 +1,54 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Signed fixed-point number stored in 32 bits with the given number of fractional bits. The SAMD21 has no FPU, so integer
+ * arithmetic is considerably cheaper than software floating point for the control math that runs on every tick. Division is
+ * the exception; it takes a 64-bit divide, which the Cortex-M0+ does in a library call, so it is best kept out of hot paths.
+ */
+template<int FRACTION_BITS>
+class FixedPoint
+{
+
+private:
+  int32_t value;
+
+public:
+  FixedPoint() : value(0) {}
+  FixedPoint(float f) : value((int32_t)((f * (float)(1L << FRACTION_BITS)) + (f >= 0.0f ? 0.5f : -0.5f))) {}
+  //from another precision; values out of range saturate
+  template<int F>
+  explicit FixedPoint(FixedPoint<F> f)
+  {
+    int64_t raw = F < FRACTION_BITS ? ((int64_t)f.getRaw()) << (F < FRACTION_BITS ? FRACTION_BITS - F : 0) :
+        ((int64_t)f.getRaw()) >> (F < FRACTION_BITS ? 0 : F - FRACTION_BITS);
+    value = raw > INT32_MAX ? INT32_MAX : (raw < INT32_MIN ? INT32_MIN : (int32_t)raw);
+  }
+
+  static FixedPoint fromRaw(int32_t raw) { FixedPoint f; f.value = raw; return f; }
+  int32_t getRaw() const { return value; }
+  float toFloat() const { return ((float)value) / (float)(1L << FRACTION_BITS); }
+
+  FixedPoint operator-() const { return fromRaw(-value); }
+  FixedPoint operator+(FixedPoint f) const { return fromRaw(value + f.value); }
+  FixedPoint operator-(FixedPoint f) const { return fromRaw(value - f.value); }
+  FixedPoint operator*(FixedPoint f) const { return fromRaw((int32_t)((((int64_t)value) * f.value) >> FRACTION_BITS)); }
+  FixedPoint operator/(FixedPoint f) const { return fromRaw((int32_t)((((int64_t)value) << FRACTION_BITS) / f.value)); }
+  FixedPoint& operator+=(FixedPoint f) { value += f.value; return *this; }
+  FixedPoint& operator-=(FixedPoint f) { value -= f.value; return *this; }
+
+  bool operator<(FixedPoint f) const { return value < f.value; }
+  bool operator>(FixedPoint f) const { return value > f.value; }
+  bool operator<=(FixedPoint f) const { return value <= f.value; }
+  bool operator>=(FixedPoint f) const { return value >= f.value; }
+  bool operator==(FixedPoint f) const { return value == f.value; }
+  bool operator!=(FixedPoint f) const { return value != f.value; }
+
+};
+
+//Q16.16; range of +/-32768 with a resolution of ~0.000015
+typedef FixedPoint<16> Fixed16;
+//Q8.24; range of +/-128 with a resolution of ~0.00000006
+typedef FixedPoint<24> Fixed24;
@@ -0,0 +1,28 @@
+
+#pragma once
+
+#include <stdint.h>
+#include "Nvm.h"
+
+/**
+ * Flash memory as the KeyValueStore sees it: a number of rows, each erased as a whole to 0xFF, made up of pages that are each
+ * written whole, once, after their row has been erased. NvmFlashDevice puts it in the SAMD21's own flash, and
+ * FileFlashDevice in a file on a Linux host, so that the store can be exercised off the robot. Like Transport.h, this file has
+ * no Arduino dependencies; NvmFlashDevice is kept in a header of its own, so that host builds never reference the NVM code.
+ */
+#define FLASH_PAGE_SIZE              NVM_PAGE_SIZE
+#define FLASH_ROW_SIZE               NVM_ROW_SIZE
+#define FLASH_PAGES_PER_ROW          (FLASH_ROW_SIZE / FLASH_PAGE_SIZE)
+
+class FlashDevice
+{
+
+public:
+  virtual uint16_t getRowCount() = 0;
+  //offsets are in bytes from the start of the device
+  virtual void read(uint32_t offset, void* data, uint32_t length) = 0;
+  //each returns false if the device reports that it failed, in which case the row or page is in an unknown state
+  virtual bool eraseRow(uint16_t row) = 0;
+  virtual bool writePage(uint16_t page, const uint8_t* data) = 0;
+
+};
@@ -1,5 +1,8 @@
 
+//host tools build these without the Arduino core, which is only needed for debug output
+#if defined(ARDUINO)
 #include <Tinyscreen.h>
+#endif
 #include <math.h>
 #include "KQuaternion.h"
 
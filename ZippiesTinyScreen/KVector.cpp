@@ -1,5 +1,8 @@
 
+//host tools build these without the Arduino core, which is only needed for debug output
+#if defined(ARDUINO)
 #include <Tinyscreen.h>
+#endif
 #include <math.h>
 #include "KVector.h"
 
@@ -188,9 +191,11 @@ void KVector2::rotate(double angleRadians)
 
 void KVector2::printDebug()
 {
+#if defined(ARDUINO)
   SerialUSB.print(x, 10);
   SerialUSB.print("  ");
   SerialUSB.print(y, 10);
+#endif
 }
 
 KVector3::KVector3()
@@ -386,10 +391,12 @@ void KVector3::setD(double newD) {
 
 void KVector3::printDebug()
 {
+#if defined(ARDUINO)
     SerialUSB.print(x, 10);
     SerialUSB.print("  ");
     SerialUSB.print(y, 10);
     SerialUSB.print("  ");
     SerialUSB.println(z, 10);
+#endif
 }
 
@@ -0,0 +1,315 @@
+
+#include <stddef.h>
+#include <string.h>
+#include "KeyValueStore.h"
+
+#define KV_NO_ROW                  -1
+#define KV_ERASED_SEQUENCE         0xFFFFFFFFUL
+#define KV_ERASED_KEY              0xFFFF
+
+//layout of the start of each page, as described in KeyValueStore.h
+typedef struct _KeyValueRecordHeader
+{
+  uint32_t sequence;
+  uint16_t key;
+  uint8_t length;
+  uint8_t reserved;
+  uint16_t crc;
+  uint16_t reserved2;
+} KeyValueRecordHeader;
+
+static_assert(sizeof(KeyValueRecordHeader) == KV_HEADER_LENGTH, "the record header must match KV_HEADER_LENGTH");
+
+//CRC-16/CCITT, over the header up to the CRC and then the value
+uint16_t kvCrc16(const uint8_t* data, uint8_t length, uint16_t crc)
+{
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= ((uint16_t)data[i]) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+uint16_t kvRecordCrc(const uint8_t* page)
+{
+  const KeyValueRecordHeader* header = (const KeyValueRecordHeader*)page;
+  uint16_t crc = kvCrc16(page, offsetof(KeyValueRecordHeader, crc), 0xFFFF);
+  return kvCrc16(page + KV_HEADER_LENGTH, header->length, crc);
+}
+
+KeyValueStore::KeyValueStore(FlashDevice* d)
+  : device(d),
+    pageCount(0),
+    indexCount(0),
+    headPage(0),
+    nextSequence(1),
+    reclaimRow(KV_NO_ROW),
+    reclaimPage(0),
+    queuedReclaimRow(KV_NO_ROW),
+    pendingHead(0),
+    pendingTail(0)
+{
+}
+
+int KeyValueStore::findIndex(uint16_t key)
+{
+  for (uint8_t i = 0; i < indexCount; i++) {
+    if (indexKeys[i] == key)
+      return i;
+  }
+  return -1;
+}
+
+void KeyValueStore::updateIndex(uint16_t key, uint16_t page, uint32_t sequence)
+{
+  int i = findIndex(key);
+  if (i < 0) {
+    if (indexCount >= KV_MAX_KEYS)
+      return;
+    i = indexCount++;
+    indexKeys[i] = key;
+  }
+  else if (indexSequences[i] > sequence)
+    return;
+
+  indexPages[i] = page;
+  indexSequences[i] = sequence;
+}
+
+//reads the whole page; returns true if it holds a valid record
+bool KeyValueStore::readRecord(uint16_t page, uint8_t* data)
+{
+  device->read(page * FLASH_PAGE_SIZE, data, FLASH_PAGE_SIZE);
+  const KeyValueRecordHeader* header = (const KeyValueRecordHeader*)data;
+  return header->sequence != KV_ERASED_SEQUENCE && header->key != KV_ERASED_KEY && header->length <= KV_VALUE_MAX_LENGTH &&
+      header->crc == kvRecordCrc(data);
+}
+
+bool KeyValueStore::isPageErased(uint16_t page)
+{
+  uint8_t data[FLASH_PAGE_SIZE];
+  device->read(page * FLASH_PAGE_SIZE, data, FLASH_PAGE_SIZE);
+  for (uint8_t i = 0; i < FLASH_PAGE_SIZE; i++) {
+    if (data[i] != 0xFF)
+      return false;
+  }
+  return true;
+}
+
+bool KeyValueStore::isRowErased(uint16_t row)
+{
+  for (uint8_t i = 0; i < FLASH_PAGES_PER_ROW; i++) {
+    if (!isPageErased((row * FLASH_PAGES_PER_ROW) + i))
+      return false;
+  }
+  return true;
+}
+
+bool KeyValueStore::hasCurrentRecords(uint16_t row)
+{
+  for (uint8_t i = 0; i < indexCount; i++) {
+    if (indexPages[i] / FLASH_PAGES_PER_ROW == row)
+      return true;
+  }
+  return false;
+}
+
+void KeyValueStore::begin()
+{
+  pageCount = device->getRowCount() * FLASH_PAGES_PER_ROW;
+  indexCount = 0;
+  nextSequence = 1;
+
+  //the newest record of all marks the head of the log
+  int32_t newestPage = -1;
+  uint8_t data[FLASH_PAGE_SIZE];
+  for (uint16_t page = 0; page < pageCount; page++) {
+    if (!readRecord(page, data)) {
+      if (!isPageErased(page))
+        stats.corruptPageCount++;
+      continue;
+    }
+
+    const KeyValueRecordHeader* header = (const KeyValueRecordHeader*)data;
+    updateIndex(header->key, page, header->sequence);
+    if (header->sequence >= nextSequence) {
+      nextSequence = header->sequence + 1;
+      newestPage = page;
+    }
+  }
+
+  //skip past anything left in the rest of the head row by a write that was cut short
+  headPage = (newestPage + 1) % pageCount;
+  while (headPage % FLASH_PAGES_PER_ROW && !isPageErased(headPage))
+    headPage = (headPage + 1) % pageCount;
+
+  //a reset between reclaiming a row and erasing it leaves only copies of records that are current elsewhere; a row with
+  //anything current in it can't be erased, though, so in that case the log moves on to the next row instead
+  uint16_t rowCount = device->getRowCount();
+  for (uint16_t i = 0; i < rowCount && headPage % FLASH_PAGES_PER_ROW == 0; i++) {
+    uint16_t headRow = headPage / FLASH_PAGES_PER_ROW;
+    if (isRowErased(headRow))
+      break;
+    if (!hasCurrentRecords(headRow)) {
+      if (device->eraseRow(headRow)) {
+        stats.eraseCount++;
+        break;
+      }
+      stats.failedCount++;
+    }
+    headPage = (headPage + FLASH_PAGES_PER_ROW) % pageCount;
+  }
+
+  //the next row must be ready before the head reaches it
+  reclaimRow = ((headPage / FLASH_PAGES_PER_ROW) + 1) % rowCount;
+  reclaimPage = 0;
+  queuedReclaimRow = KV_NO_ROW;
+}
+
+bool KeyValueStore::put(uint16_t key, const void* value, uint8_t length)
+{
+  if (length > KV_VALUE_MAX_LENGTH || key == KV_ERASED_KEY) {
+    stats.rejectedCount++;
+    return false;
+  }
+
+  //a value already waiting for the same key is simply replaced
+  PendingValue* slot = NULL;
+  for (uint8_t i = pendingHead; i != pendingTail; i++) {
+    if (pending[i & (KV_PENDING_WRITES-1)].key == key) {
+      slot = &pending[i & (KV_PENDING_WRITES-1)];
+      break;
+    }
+  }
+
+  if (slot == NULL) {
+    //every key that has been written has to fit in the index
+    uint8_t newKeyCount = 0;
+    for (uint8_t i = pendingHead; i != pendingTail; i++) {
+      if (findIndex(pending[i & (KV_PENDING_WRITES-1)].key) < 0)
+        newKeyCount++;
+    }
+    if ((uint8_t)(pendingTail - pendingHead) >= KV_PENDING_WRITES ||
+        (findIndex(key) < 0 && indexCount + newKeyCount >= KV_MAX_KEYS))
+    {
+      stats.rejectedCount++;
+      return false;
+    }
+    slot = &pending[pendingTail & (KV_PENDING_WRITES-1)];
+    pendingTail++;
+  }
+
+  slot->key = key;
+  slot->length = length;
+  memcpy(slot->value, value, length);
+  return true;
+}
+
+int KeyValueStore::get(uint16_t key, void* value, uint8_t maxLength)
+{
+  for (uint8_t i = pendingHead; i != pendingTail; i++) {
+    PendingValue* slot = &pending[i & (KV_PENDING_WRITES-1)];
+    if (slot->key == key) {
+      memcpy(value, slot->value, slot->length < maxLength ? slot->length : maxLength);
+      return slot->length;
+    }
+  }
+
+  int i = findIndex(key);
+  if (i < 0)
+    return -1;
+
+  uint8_t data[FLASH_PAGE_SIZE];
+  if (!readRecord(indexPages[i], data))
+    return -1;
+  uint8_t length = ((KeyValueRecordHeader*)data)->length;
+  memcpy(value, data + KV_HEADER_LENGTH, length < maxLength ? length : maxLength);
+  return length;
+}
+
+//returns false if the device failed to write the page, which is then skipped like a page torn by a reset
+bool KeyValueStore::writeRecord(uint16_t key, const uint8_t* value, uint8_t length)
+{
+  uint8_t data[FLASH_PAGE_SIZE];
+  memset(data, 0xFF, sizeof(data));
+  KeyValueRecordHeader* header = (KeyValueRecordHeader*)data;
+  header->sequence = nextSequence++;
+  header->key = key;
+  header->length = length;
+  memcpy(data + KV_HEADER_LENGTH, value, length);
+  header->crc = kvRecordCrc(data);
+
+  bool written = device->writePage(headPage, data);
+  if (written) {
+    stats.writeCount++;
+    updateIndex(key, headPage, header->sequence);
+  }
+  else
+    stats.failedCount++;
+  advanceHead();
+  return written;
+}
+
+void KeyValueStore::advanceHead()
+{
+  headPage = (headPage + 1) % pageCount;
+
+  //the head has moved into the row that was reclaimed last; the one after it is next
+  if (headPage % FLASH_PAGES_PER_ROW == 0)
+    queuedReclaimRow = ((headPage / FLASH_PAGES_PER_ROW) + 1) % device->getRowCount();
+}
+
+void KeyValueStore::reclaimStep()
+{
+  //copy forward the first current record left in the row, if any
+  while (reclaimPage < FLASH_PAGES_PER_ROW) {
+    uint16_t page = (reclaimRow * FLASH_PAGES_PER_ROW) + reclaimPage++;
+    for (uint8_t i = 0; i < indexCount; i++) {
+      if (indexPages[i] != page)
+        continue;
+
+      //the row can't be erased until the copy has been made
+      uint8_t data[FLASH_PAGE_SIZE];
+      readRecord(page, data);
+      if (writeRecord(indexKeys[i], data + KV_HEADER_LENGTH, ((KeyValueRecordHeader*)data)->length))
+        stats.relocationCount++;
+      else
+        reclaimPage--;
+      return;
+    }
+  }
+
+  //then erase it, unless it has never been written since it was last erased
+  if (!isRowErased(reclaimRow)) {
+    //tried again on the next call; the head must never reach a row that hasn't been erased
+    if (!device->eraseRow(reclaimRow)) {
+      stats.failedCount++;
+      return;
+    }
+    stats.eraseCount++;
+  }
+  reclaimRow = KV_NO_ROW;
+}
+
+void KeyValueStore::loop()
+{
+  if (reclaimRow == KV_NO_ROW && queuedReclaimRow != KV_NO_ROW) {
+    reclaimRow = queuedReclaimRow;
+    reclaimPage = 0;
+    queuedReclaimRow = KV_NO_ROW;
+  }
+
+  //reclaiming always comes first, so that the head never reaches a row that hasn't been erased
+  if (reclaimRow != KV_NO_ROW) {
+    reclaimStep();
+    return;
+  }
+
+  if (pendingHead == pendingTail)
+    return;
+
+  PendingValue* slot = &pending[pendingHead & (KV_PENDING_WRITES-1)];
+  if (writeRecord(slot->key, slot->value, slot->length))
+    pendingHead++;
+}
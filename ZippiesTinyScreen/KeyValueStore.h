@@ -0,0 +1,114 @@
+
+#pragma once
+
+#include <stdint.h>
+#include "FlashDevice.h"
+
+/**
+ * Small key-value store for settings that must survive a reboot, kept as a log in flash. Each value is appended as a record in
+ * a page of its own...
+ *
+ *   [sequence u32][key u16][length u8][reserved u8][crc u16][reserved u16][value...]
+ *
+ * ...and the newest record with a valid CRC for each key wins. The log wraps around the device, so every row is erased
+ * equally often. The row after the one being filled is always reclaimed before the log reaches it; whichever of its records
+ * are still current are copied to the head of the log, and then it is erased. At startup, begin() scans the device to build
+ * an index, in RAM, of where the current record for each key is.
+ *
+ * put() only queues a value. loop() then does at most one flash operation per call, either writing one page or erasing one
+ * row, so that the sketch never stalls for longer than a single row erase. Values queued but not yet written are still
+ * returned by get(). The device needs at least (KV_MAX_KEYS / FLASH_PAGES_PER_ROW) + 3 rows. Like FlashDevice.h, this file
+ * has no Arduino dependencies.
+ */
+#define KV_HEADER_LENGTH              12
+#define KV_VALUE_MAX_LENGTH           (FLASH_PAGE_SIZE - KV_HEADER_LENGTH)
+#define KV_MAX_KEYS                   16
+//must be a power of two
+#define KV_PENDING_WRITES              4
+
+//keys used by the sketch; a key must never be reused for a different kind of value
+#define KV_KEY_PARAMETERS         0x0001  //float32 for each parameter, in order of id; see Parameters.h
+#define KV_KEY_BASE_STATION       0x0002  //the base station info block last received from the lighthouse
+
+typedef struct _KeyValueStats
+{
+  unsigned long writeCount = 0;
+  unsigned long eraseCount = 0;
+  //records copied forward out of a row that was about to be erased
+  unsigned long relocationCount = 0;
+  //pages found at startup that were neither erased nor valid records, such as writes cut short by a reset, or a region that
+  //has never been erased at all
+  unsigned long corruptPageCount = 0;
+  //values refused because the queue or the index was full
+  unsigned long rejectedCount = 0;
+  //writes and erases that the device reported as failed; each is tried again, a write at the next page
+  unsigned long failedCount = 0;
+} KeyValueStats;
+
+typedef struct _PendingValue
+{
+  uint16_t key;
+  uint8_t length;
+  uint8_t value[KV_VALUE_MAX_LENGTH];
+} PendingValue;
+
+class KeyValueStore
+{
+
+private:
+  FlashDevice* device;
+  uint16_t pageCount;
+
+  //the page holding the current record for each key, and its sequence number
+  uint16_t indexKeys[KV_MAX_KEYS];
+  uint16_t indexPages[KV_MAX_KEYS];
+  uint32_t indexSequences[KV_MAX_KEYS];
+  uint8_t indexCount;
+
+  //the next page to be written, and the sequence number it will get
+  uint16_t headPage;
+  uint32_t nextSequence;
+
+  //the row being reclaimed, and the next of its pages to examine; another row may be waiting to be reclaimed after it
+  int32_t reclaimRow;
+  uint8_t reclaimPage;
+  int32_t queuedReclaimRow;
+
+  //values waiting to be written; both indexes only ever increase and are reduced when the ring is accessed
+  PendingValue pending[KV_PENDING_WRITES];
+  uint8_t pendingHead;
+  uint8_t pendingTail;
+
+  KeyValueStats stats;
+
+  int findIndex(uint16_t key);
+  void updateIndex(uint16_t key, uint16_t page, uint32_t sequence);
+  bool readRecord(uint16_t page, uint8_t* data);
+  bool isPageErased(uint16_t page);
+  bool isRowErased(uint16_t row);
+  bool hasCurrentRecords(uint16_t row);
+  bool writeRecord(uint16_t key, const uint8_t* value, uint8_t length);
+  void advanceHead();
+  void reclaimStep();
+
+public:
+  KeyValueStore(FlashDevice* device);
+
+  //scans the device and builds the index; this may erase a row left half-reclaimed by a reset, so it should be called once
+  //from setup()
+  void begin();
+
+  //queues the value to be written; returns false if it is too long, or if there is no room for it in the queue or the index
+  bool put(uint16_t key, const void* value, uint8_t length);
+  //copies the current value into the buffer, up to maxLength bytes; returns its full length, or -1 if there is none
+  int get(uint16_t key, void* value, uint8_t maxLength);
+
+  //does at most one flash operation
+  void loop();
+  bool isIdle() { return reclaimRow < 0 && queuedReclaimRow < 0 && pendingHead == pendingTail; }
+  //writes everything queued; this blocks for as long as it takes
+  void flush() { while (!isIdle()) loop(); }
+
+  KeyValueStats* getStats() { return &stats; }
+
+};
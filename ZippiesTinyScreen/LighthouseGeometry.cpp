@@ -0,0 +1,148 @@
+
+#include <math.h>
+#include <string.h>
+#include "LighthouseGeometry.h"
+
+#define M_2PI_3 2.094395102393195d
+#define M_PI_3 1.047197551196598d
+
+/**
+   Convert a 16-bit IEEE floating point number to a 32-bit IEEE floating point number.
+*/
+float float16ToFloat32(uint16_t half)
+{
+  union {
+    uint32_t u;
+    float f;
+  } val;
+  val.u = (half & 0x7fff) << 13 | (half & 0x8000) << 16;
+  if ((half & 0x7c00) != 0x7c00)
+    return val.f * 0x1p112;
+  val.u |= 0x7f800000;
+  return val.f;
+}
+
+/**
+ * Calculate the orientation and position of the lighthouse relative to the ground plane.
+ *
+ * From this accelerometer reading, calculate a quaternion that represents the lighthouse rotation in a coordinate system where the
+ * x and y axes are parallel to the ground, positive x is to the right from the lighthouse, positive y is forward from the lighthouse,
+ * and positive z represents height.
+ */
+void LighthouseGeometry::calculate(const uint8_t* baseStationInfoBlock, double lighthouseHeightMM, double diodeHeightMM)
+{
+  /*
+   * Lighthouse factory calibration data for the lighthouse being used for beta testing and development.
+   * 
+   * X Rotor Factory Calibration:
+   *   Phase (degrees):         1.116435
+   *   Tilt (degrees):          0.312331
+   *   Curve (degrees):        -0.070105
+   *   Gibbous Phase (?):       1.673828
+   *   Gibbous Magnitude (?):   0.025238
+   *
+   * Y Rotor Factory Calibration:
+   *   Phase (degrees):         0.568272
+   *   Tilt (degrees):         -0.130265
+   *   Curve (degrees):         0.133325
+   *   Gibbous Phase (?):       0.238892
+   *   Gibbous Magnitude (?):  -0.007553
+   */
+
+  const BaseStationInfoBlock* info = (const BaseStationInfoBlock*)baseStationInfoBlock;
+
+  //capture the factory calibration data for the x rotor
+  xRotor.phase = float16ToFloat32(info->fcal_0_phase);
+  xRotor.tilt = float16ToFloat32(info->fcal_0_tilt);
+  xRotor.curve = float16ToFloat32(info->fcal_0_curve);
+  xRotor.gibbousPhase = float16ToFloat32(info->fcal_0_gibphase);
+  xRotor.gibbousMagnitude = float16ToFloat32(info->fcal_0_gibmag);
+
+  //capture the factory calibration data for the y rotor
+  yRotor.phase = float16ToFloat32(info->fcal_1_phase);
+  yRotor.tilt = float16ToFloat32(info->fcal_1_tilt);
+  yRotor.curve = float16ToFloat32(info->fcal_1_curve);
+  yRotor.gibbousPhase = float16ToFloat32(info->fcal_1_gibphase);
+  yRotor.gibbousMagnitude = float16ToFloat32(info->fcal_1_gibmag);
+
+  //The accelerometer reading from the lighthouse gives us a vector that represents the lighthouse "up" direction in a coordinate system
+  //where the x and z axes are parallel to the ground, positive x is to the lighthouse "left", positive z is "forward, and positive y is
+  //"up". This means swapping the y and z axes of the accelerometer and flipping the x axis to put them into our global coordinate system.
+  KVector3 rotationUnitVector(-info->accel_dir_x, info->accel_dir_z, info->accel_dir_y, 1.0d);
+  //rotationUnitVector.printDebug();
+
+  //now calculate the angle of rotation from the "up" normal in our global coordinate system (0,0,1) to the rotation unit vector
+  //this calculation ultimately reduces to the inverse cosine of the z axis of the rotation unit vector
+  double angleOfRotation = acos(rotationUnitVector.getZ());
+  //SerialUSB.println((angleOfRotation / M_PI) * 180.0d, 2);
+
+  //now cross the "up" vector of the lighthouse with the "up" normal of the global coordinate system to obtain the axis of rotation for
+  //our quaternion; this calculation ultimately reduces to the y axis from the rotation unit vector becoming the x axis and the x axis
+  //becoming the negative y axis; then obtain the unit vector of the result
+  rotationUnitVector.set(rotationUnitVector.getY(), -rotationUnitVector.getX(), 0.0d, 1.0d);
+
+  //now that we have both the axis and angle of rotation, we can calculate our quaternion
+  lighthouseOrientation.set(rotationUnitVector.getX(), rotationUnitVector.getY(), rotationUnitVector.getZ(), angleOfRotation);
+
+  //take the forward unit vector in the lighthouse's coordinate system (0,1,0), and un-rotate it to get it into the global coordinate system
+  KVector3 lighthouseForwardVector(0.0d, 1.0d, 0.0d);
+  lighthouseForwardVector.unrotate(&lighthouseOrientation);
+  //KVector3 lighthouseForwardVector(getAccelDirX(), getAccelDirY(), -getAccelDirZ(), 1.0d);
+  //lighthouseForwardVector.printDebug();
+
+  //determine the height of the lighthouse from the diode plane
+  double lighthouseDistanceFromDiodePlane = lighthouseHeightMM - diodeHeightMM;
+
+  //now we intersect the "forward" vector from the lighthouse with the diode plane to determine the relative x/y location where it's pointing
+  //that location becomes our origin point in our global coordinate system; the lighthouse is considered to be offset from that location
+  double t = -lighthouseDistanceFromDiodePlane / lighthouseForwardVector.getZ();
+  lighthousePosition.set(-lighthouseForwardVector.getX() * t,
+                         -lighthouseForwardVector.getY() * t,
+                         lighthouseDistanceFromDiodePlane);
+  //lighthousePosition.printDebug();
+}
+
+double tickCountToAngle(double tickCount, RotorFactoryCalibrationData* fcalData)
+{
+  double angleFromLighthouse = tickCount / ((double)SWEEP_DURATION_TICKS);
+  double vectorFromLighthouse = tan(((angleFromLighthouse - 0.5d) * M_2PI_3) - fcalData->phase);
+  return vectorFromLighthouse;
+}
+
+/*
+ * Translates combined x and y tick counts into a vector from the lighthouse to the sensor, and intersects it with the plane of the
+ * diodes to get the position of the sensor in the global coordinate system.
+ */
+void LighthouseGeometry::calculateSensorPosition(unsigned long xSweepTicks, unsigned long ySweepTicks, KVector2* position)
+{
+  //Step 1: Calculate the vector from the lighthouse in its reference frame to the diode.
+  //start by normalizing the angle on each axis from the lighthouse to be from 0.0 to 1.0
+  double angleFromLighthouseX = (((double)xSweepTicks) / ((double)SWEEP_DURATION_TICKS));
+  double angleFromLighthouseZ = (((double)ySweepTicks) / ((double)SWEEP_DURATION_TICKS));
+  //  SerialUSB.println(angleFromLighthouseX, 2);
+
+  //at y=1, we want the x and z coordinates of our direction vector; since the tangent is TAN = O / A, then O = TAN / A; given that
+  //our adjacent is 1.0, then the opposite (the length of each leg of the vector from our lighthouse) is simple the TAN of the angle
+  //along the x and z axes scaled to an angle from -60 degrees to +60 degrees, which is the field of view of the lighthouse
+  //TODO: eventually account for lighthouse factory calibration data
+  //  double vectorFromLighthouseX = tan((angleFromLighthouseX - 0.5d) * M_2PI_3);
+  //  double vectorFromLighthouseZ = tan((angleFromLighthouseZ - 0.5d) * M_2PI_3);
+  double vectorFromLighthouseX = tan(((angleFromLighthouseX - 0.5d) * M_2PI_3) + xRotor.phase);
+  double vectorFromLighthouseZ = tan(((angleFromLighthouseZ - 0.5d) * M_2PI_3) + yRotor.phase);
+
+  //Step 2: Convert the vector from the lighthouse in its local coordinate system to our global coordinate system.
+  //flip the x axis; it appears that our tick counts get greater from left-to-right when facing the lighthouse; this is contrary to
+  //some animations online which illustrate the horizontal beam sweeping from right-to-left
+  KVector3 directionFromLighthouse(-vectorFromLighthouseX, 1.0d, vectorFromLighthouseZ);
+  directionFromLighthouse.unrotate(&lighthouseOrientation);
+  directionFromLighthouse.normalize();
+  //  directionFromLighthouse.printDebug();
+
+  //now intersect with the plane of the diodes on the robot; since our diode plane is defined by the normal 0,0,1, and we have a
+  //vector which identifies the position of the lighthouse from 0,0,0, the entire formula for our ground-plane intersection reduces
+  //to the following
+  double t = -lighthousePosition.getZ() / directionFromLighthouse.getZ();
+
+  position->set(lighthousePosition.getX() + (directionFromLighthouse.getX() * t),
+      lighthousePosition.getY() + (directionFromLighthouse.getY() * t));
+}
@@ -0,0 +1,95 @@
+
+#pragma once
+
+#include <stdint.h>
+#include "KVector.h"
+#include "KQuaternion.h"
+
+/**
+ * The math that turns sweep tick counts into positions on the floor, given the base station info block from the lighthouse. This
+ * file has no Arduino dependencies, so that host tools can solve exactly the same positions from sweeps streamed off the robot.
+ */
+
+//height of the lighthouse from the floor
+//mounted on surface of entertainment center
+#define LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM 940.0d
+//mounted on top of TV
+//#define LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM 1950.0d
+//height of the diode sensors from the floor
+#define ROBOT_DIODE_HEIGHT_MM 38.0d
+
+//each laser rotates 180 degrees every 400,000 ticks but is only visible for 120 degrees of that sweep
+//so the visible portion of the laser sweep starts at 30/180 * 400,000 = 66,667 ticks
+#define SWEEP_START_TICKS 66667
+//and the duration of the visible portion of the laser sweep is 120/180 * 400,000 = 266,667 ticks
+#define SWEEP_DURATION_TICKS 266667
+
+#define BASE_STATION_INFO_BLOCK_SIZE 33
+
+//we need the base station info block struct to be byte-aligned; otherwise it'll be aligned according to the MCU
+//we're running on (32 bits for SAMD21) and the data we want from it will be unintelligible; hence these pragmas
+#pragma pack(push)
+#pragma pack(1)
+typedef struct _BaseStationInfoBlock {
+  uint16_t fw_version;
+  uint32_t id;
+  //several of these values are actually 16-bit floating point numbers, but since our platform doesn't have those, we treat them
+  //as unsigned integers for the purpose of allocating space and will have to manually convert them later
+  uint16_t fcal_0_phase;
+  uint16_t fcal_1_phase;
+  uint16_t fcal_0_tilt;
+  uint16_t fcal_1_tilt;
+  uint8_t sys_unlock_count;
+  uint8_t hw_version;
+  uint16_t fcal_0_curve;
+  uint16_t fcal_1_curve;
+  //  */
+  //the following three values indicate the "up" vector of the lighthouse
+  //x axis is right (-) to left (+) from the perspective of the lighthouse
+  int8_t accel_dir_x;
+  //y axis is down (-) to up (+)
+  int8_t accel_dir_y;
+  //z axis is back (-) to front (+)
+  int8_t accel_dir_z;
+  //so for example, a perfectly upright lighthouse would have an accel vector of 0, 127, 0
+  //the front faces 0, 0, 127 from the lighthouse internal coordinate system
+  //-x , z, y
+  uint16_t fcal_0_gibphase;
+  uint16_t fcal_1_gibphase;
+  uint16_t fcal_0_gibmag;
+  uint16_t fcal_1_gibmag;
+  uint8_t mode_current;
+  uint8_t sys_faults;
+} BaseStationInfoBlock;
+#pragma pack(pop)
+
+typedef struct _RotorFactoryCalibrationData
+{
+  double phase = 0.0d;
+  double curve = 0.0d;
+  double tilt = 0.0d;
+  double gibbousPhase = 0.0d;
+  double gibbousMagnitude = 0.0d;
+} RotorFactoryCalibrationData;
+
+class LighthouseGeometry
+{
+
+private:
+  RotorFactoryCalibrationData xRotor;
+  RotorFactoryCalibrationData yRotor;
+  KVector3 lighthousePosition;
+  KQuaternion lighthouseOrientation;
+
+public:
+  LighthouseGeometry() {}
+
+  //heights are from the floor
+  void calculate(const uint8_t* baseStationInfoBlock, double lighthouseHeightMM, double diodeHeightMM);
+  void calculateSensorPosition(unsigned long xSweepTicks, unsigned long ySweepTicks, KVector2* position);
+
+  RotorFactoryCalibrationData* getXRotor() { return &xRotor; }
+  RotorFactoryCalibrationData* getYRotor() { return &yRotor; }
+  KVector3* getLighthousePosition() { return &lighthousePosition; }
+
+};
@@ -1,25 +1,14 @@
 
 #include "LighthouseSensor.h"
-
-//height of the lighthouse from the floor
-//mounted on surface of entertainment center
-#define LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM 940.0d
-//mounted on top of TV
-//#define LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM 1950.0d
-//height of the diode sensors from the floor
-#define ROBOT_DIODE_HEIGHT_MM 38.0d
+#include "Parameters.h"
 
 //#define LIGHTHOUSE_DEBUG_SIGNAL 1
 //#define LIGHTHOUSE_DEBUG_ERRORS 1
-#define M_2PI_3 2.094395102393195d
-#define M_PI_3 1.047197551196598d
+//never extrapolate the pose further than this into the future
+#define LIGHTHOUSE_MAX_PREDICTION_MICROS 50000
 
 //timings for 48 MHz
-//each laser rotates 180 degrees every 400,000 ticks but is only visible for 120 degrees of that sweep
-//so the visible portion of the laser sweep starts at 30/180 * 400,000 = 66,667 ticks
-#define SWEEP_START_TICKS 66667
-//and the duration of the visible portion of the laser sweep is 120/180 * 400,000 = 266,667 ticks
-#define SWEEP_DURATION_TICKS 266667
+#define TICKS_PER_MICROSECOND 48
 //x axis, OOTX bit 0
 #define SYNC_PULSE_J0_MIN 2950
 //y axis, OOTX bit 0
@@ -30,58 +19,7 @@
 #define SYNC_PULSE_K1_MIN 4450
 #define NONSYNC_PULSE_J2_MIN 4950
 
-//we need the base station info block struct to be byte-aligned; otherwise it'll be aligned according to the MCU
-//we're running on (32 bits for SAMD21) and the data we want from it will be unintelligible; hence these pragmas
-#pragma pack(push)
-#pragma pack(1)
-typedef struct _BaseStationInfoBlock {
-  uint16_t fw_version;
-  uint32_t id;
-  //several of these values are actually 16-bit floating point numbers, but since our platform doesn't have those, we treat them
-  //as unsigned integers for the purpose of allocating space and will have to manually convert them later
-  uint16_t fcal_0_phase;
-  uint16_t fcal_1_phase;
-  uint16_t fcal_0_tilt;
-  uint16_t fcal_1_tilt;
-  uint8_t sys_unlock_count;
-  uint8_t hw_version;
-  uint16_t fcal_0_curve;
-  uint16_t fcal_1_curve;
-  //  */
-  //the following three values indicate the "up" vector of the lighthouse
-  //x axis is right (-) to left (+) from the perspective of the lighthouse
-  int8_t accel_dir_x;
-  //y axis is down (-) to up (+)
-  int8_t accel_dir_y;
-  //z axis is back (-) to front (+)
-  int8_t accel_dir_z;
-  //so for example, a perfectly upright lighthouse would have an accel vector of 0, 127, 0
-  //the front faces 0, 0, 127 from the lighthouse internal coordinate system
-  //-x , z, y
-  uint16_t fcal_0_gibphase;
-  uint16_t fcal_1_gibphase;
-  uint16_t fcal_0_gibmag;
-  uint16_t fcal_1_gibmag;
-  uint8_t mode_current;
-  uint8_t sys_faults;
-} BaseStationInfoBlock;
-#pragma pack(pop)
-
-/**
-   Convert a 16-bit IEEE floating point number to a 32-bit IEEE floating point number.
-*/
-float float16ToFloat32(uint16_t half)
-{
-  union {
-    uint32_t u;
-    float f;
-  } val;
-  val.u = (half & 0x7fff) << 13 | (half & 0x8000) << 16;
-  if ((half & 0x7c00) != 0x7c00)
-    return val.f * 0x1p112;
-  val.u |= 0x7f800000;
-  return val.f;
-}
+extern Parameters parameters;
 
 Lighthouse* currentLighthouse = NULL;
 LighthouseSensor* rightSensor = NULL;
@@ -353,6 +291,8 @@ void TCC0_Handler()
     else
       rightSensorInput.hitTickWritePtr++;
   }
+  else
+    rightSensorInput.droppedTickCount++;
 }
 
 void TCC1_Handler()
@@ -370,12 +310,112 @@ void TCC1_Handler()
     else
       leftSensorInput.hitTickWritePtr++;
   }
+  else
+    leftSensorInput.droppedTickCount++;
+}
+
+unsigned int calculateDeltaTicks(unsigned int startTicks, unsigned int endTicks)
+{
+  //calculate the delta between the ticks; they are derived from a 24-bit counter, so there is a weird hoop to jump through when it rolls over
+  if (startTicks > endTicks)
+    return (0x01000000 - startTicks) + endTicks;
+  else
+    return endTicks - startTicks;
+}
+
+unsigned int readTimerTicks(Tcc* timer)
+{
+  //the count register must be synchronized before it can be read
+  timer->CTRLBSET.reg = TCC_CTRLBSET_CMD_READSYNC;
+  while (timer->SYNCBUSY.bit.CTRLB);
+  while (timer->SYNCBUSY.bit.COUNT);
+  return timer->COUNT.reg;
 }
 
-void Lighthouse::loop()
+bool Lighthouse::loop()
 {
   rightSensor.loop();
   leftSensor.loop();
+
+  //timestamp any new sweep hits against the timer which captured them; the right sensor is captured by TCC0 and the left by TCC1
+  if (rightSensor.newSweepEventCount || leftSensor.newSweepEventCount) {
+    unsigned long currentMicros = micros();
+    queueSweepEvents(&rightSensor, readTimerTicks(TCC0), currentMicros);
+    queueSweepEvents(&leftSensor, readTimerTicks(TCC1), currentMicros);
+  }
+
+  //wait until both sensors have seen a new sweep
+  if (rightSensor.sweepHitCount == rightSweepHitCount || leftSensor.sweepHitCount == leftSweepHitCount)
+    return false;
+
+  rightSweepHitCount = rightSensor.sweepHitCount;
+  leftSweepHitCount = leftSensor.sweepHitCount;
+
+  //determine how long ago each sweep hit actually occurred from the timer which captured it; the right sensor is captured by
+  //TCC0 and the left by TCC1
+  unsigned long currentMicros = micros();
+  unsigned int rightAgeTicks = calculateDeltaTicks(rightSensor.latestSweepHitTicks, readTimerTicks(TCC0));
+  unsigned int leftAgeTicks = calculateDeltaTicks(leftSensor.latestSweepHitTicks, readTimerTicks(TCC1));
+  poseTimeMicros = currentMicros - (max(rightAgeTicks, leftAgeTicks) / TICKS_PER_MICROSECOND);
+  poseCount++;
+
+  return true;
+}
+
+void Lighthouse::queueSweepEvents(LighthouseSensor* sensor, unsigned int currentTicks, unsigned long currentMicros)
+{
+  for (uint8_t i = 0; i < sensor->newSweepEventCount; i++) {
+    if ((uint8_t)(sweepEventTail - sweepEventHead) >= LIGHTHOUSE_SWEEP_EVENT_QUEUE_SIZE) {
+      droppedSweepEventCount++;
+      continue;
+    }
+
+    SweepEvent* event = &sweepEvents[sweepEventTail & (LIGHTHOUSE_SWEEP_EVENT_QUEUE_SIZE-1)];
+    *event = sensor->newSweepEvents[i];
+    event->hitMicros = currentMicros - (calculateDeltaTicks(event->hitTicks, currentTicks) / TICKS_PER_MICROSECOND);
+    sweepEventTail++;
+  }
+  sensor->newSweepEventCount = 0;
+}
+
+void Lighthouse::enableSweepEvents(bool enabled)
+{
+  sweepEventsEnabled = enabled;
+  rightSensor.recordSweepEvents = enabled;
+  leftSensor.recordSweepEvents = enabled;
+  if (!enabled) {
+    rightSensor.newSweepEventCount = 0;
+    leftSensor.newSweepEventCount = 0;
+    sweepEventHead = sweepEventTail;
+  }
+}
+
+const uint8_t* Lighthouse::getBaseStationInfoBlock()
+{
+  //a block just received from the lighthouse wins over one restored from flash
+  if (leftSensor.getBaseStationInfoCount())
+    return leftSensor.getBaseStationInfoBlock();
+  else if (rightSensor.getBaseStationInfoCount())
+    return rightSensor.getBaseStationInfoBlock();
+  else if (leftSensor.hasBaseStationInfo())
+    return leftSensor.getBaseStationInfoBlock();
+  else if (rightSensor.hasBaseStationInfo())
+    return rightSensor.getBaseStationInfoBlock();
+  return NULL;
+}
+
+void Lighthouse::restoreBaseStationInfo(const uint8_t* baseStationInfoBlock)
+{
+  leftSensor.restoreBaseStationInfo(baseStationInfoBlock);
+  rightSensor.restoreBaseStationInfo(baseStationInfoBlock);
+}
+
+void Lighthouse::recalculateGeometry()
+{
+  if (leftSensor.hasBaseStationInfo())
+    leftSensor.calculateLighthousePosition();
+  if (rightSensor.hasBaseStationInfo())
+    rightSensor.calculateLighthousePosition();
 }
 
 void Lighthouse::recalculate()
@@ -430,6 +470,29 @@ void Lighthouse::recalculate()
   rightSensor.recalculateVelocity(&previousOrientationVector, &orientationVector, combinedPositionTimeStamp);
 }
 
+void Lighthouse::predictPose(unsigned long actuationTimeMicros)
+{
+  predictedTimeMicros = actuationTimeMicros;
+  predictedPositionVector.set(&positionVector);
+  predictedOrientationVector.set(&orientationVector);
+
+  //time from when the pose was sensed until it will be acted upon
+  double horizonMS = ((double)min(actuationTimeMicros - poseTimeMicros, (unsigned long)LIGHTHOUSE_MAX_PREDICTION_MICROS)) / 1000.0d;
+
+  //continue along the most recent change in position...
+  if (previousPositionTimeStamp && positionTimeStamp != previousPositionTimeStamp) {
+    double positionScale = horizonMS / ((double)(positionTimeStamp - previousPositionTimeStamp));
+    predictedPositionVector.set(positionVector.getX() + ((positionVector.getX() - previousPositionVector.getX()) * positionScale),
+        positionVector.getY() + ((positionVector.getY() - previousPositionVector.getY()) * positionScale));
+  }
+
+  //...and the most recent change in orientation
+  if (previousOrientationTimeStamp && orientationTimeStamp != previousOrientationTimeStamp) {
+    double orientationScale = horizonMS / ((double)(orientationTimeStamp - previousOrientationTimeStamp));
+    predictedOrientationVector.rotate(previousOrientationVector.angleToVector(&orientationVector) * orientationScale);
+  }
+}
+
 void Lighthouse::stop()
 {
   REG_TCC0_CTRLA &= ~TCC_CTRLA_ENABLE;
@@ -466,112 +529,43 @@ int8_t LighthouseSensor::getAccelDirZ() {
 }
 
 /**
- * Calculate the orientation and position of the lighthouse relative to the ground plane.
- *
- * From this accelerometer reading, calculate a quaternion that represents the lighthouse rotation in a coordinate system where the
- * x and y axes are parallel to the ground, positive x is to the right from the lighthouse, positive y is forward from the lighthouse,
- * and positive z represents height.
+ * Calculate the orientation and position of the lighthouse relative to the ground plane, from the base station info block we
+ * just received.
  */
 void LighthouseSensor::calculateLighthousePosition()
 {
-  /*
-   * Lighthouse factory calibration data for the lighthouse being used for beta testing and development.
-   * 
-   * X Rotor Factory Calibration:
-   *   Phase (degrees):         1.116435
-   *   Tilt (degrees):          0.312331
-   *   Curve (degrees):        -0.070105
-   *   Gibbous Phase (?):       1.673828
-   *   Gibbous Magnitude (?):   0.025238
-   *
-   * Y Rotor Factory Calibration:
-   *   Phase (degrees):         0.568272
-   *   Tilt (degrees):         -0.130265
-   *   Curve (degrees):         0.133325
-   *   Gibbous Phase (?):       0.238892
-   *   Gibbous Magnitude (?):  -0.007553
-   */
-
-  //capture the factory calibration data for the x rotor
-  xRotor.phase = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_0_phase);
-  xRotor.tilt = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_0_tilt);
-  xRotor.curve = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_0_curve);
-  xRotor.gibbousPhase = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_0_gibphase);
-  xRotor.gibbousMagnitude = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_0_gibmag);
-
-  //capture the factory calibration data for the y rotor
-  yRotor.phase = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_1_phase);
-  yRotor.tilt = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_1_tilt);
-  yRotor.curve = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_1_curve);
-  yRotor.gibbousPhase = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_1_gibphase);
-  yRotor.gibbousMagnitude = float16ToFloat32(((BaseStationInfoBlock*)baseStationInfoBlock)->fcal_1_gibmag);
+  geometry.calculate(baseStationInfoBlock, parameters.get(PARAMETER_LIGHTHOUSE_HEIGHT), parameters.get(PARAMETER_DIODE_HEIGHT));
 
 #ifdef LIGHTHOUSE_DEBUG_SIGNAL
+  RotorFactoryCalibrationData* xRotor = geometry.getXRotor();
+  RotorFactoryCalibrationData* yRotor = geometry.getYRotor();
   SerialUSB.println("X Rotor Factory Calibration:");
-  SerialUSB.println((xRotor.phase / M_PI) * 180.0d, 6);
-  SerialUSB.println((xRotor.tilt / M_PI) * 180.0d, 6);
-  SerialUSB.println((xRotor.curve / M_PI) * 180.0d, 6);
-  SerialUSB.println(xRotor.gibbousPhase, 6);
-  SerialUSB.println(xRotor.gibbousMagnitude, 6);
+  SerialUSB.println((xRotor->phase / M_PI) * 180.0d, 6);
+  SerialUSB.println((xRotor->tilt / M_PI) * 180.0d, 6);
+  SerialUSB.println((xRotor->curve / M_PI) * 180.0d, 6);
+  SerialUSB.println(xRotor->gibbousPhase, 6);
+  SerialUSB.println(xRotor->gibbousMagnitude, 6);
   SerialUSB.println();
 
   SerialUSB.println("Y Rotor Factory Calibration:");
-  SerialUSB.println((yRotor.phase / M_PI) * 180.0d, 6);
-  SerialUSB.println((yRotor.tilt / M_PI) * 180.0d, 6);
-  SerialUSB.println((yRotor.curve / M_PI) * 180.0d, 6);
-  SerialUSB.println(yRotor.gibbousPhase, 6);
-  SerialUSB.println(yRotor.gibbousMagnitude, 6);
+  SerialUSB.println((yRotor->phase / M_PI) * 180.0d, 6);
+  SerialUSB.println((yRotor->tilt / M_PI) * 180.0d, 6);
+  SerialUSB.println((yRotor->curve / M_PI) * 180.0d, 6);
+  SerialUSB.println(yRotor->gibbousPhase, 6);
+  SerialUSB.println(yRotor->gibbousMagnitude, 6);
   SerialUSB.println();
 #endif
 
-  //The accelerometer reading from the lighthouse gives us a vector that represents the lighthouse "up" direction in a coordinate system
-  //where the x and z axes are parallel to the ground, positive x is to the lighthouse "left", positive z is "forward, and positive y is
-  //"up". This means swapping the y and z axes of the accelerometer and flipping the x axis to put them into our global coordinate system.
-  KVector3 rotationUnitVector(-getAccelDirX(), getAccelDirZ(), getAccelDirY(), 1.0d);
-  //rotationUnitVector.printDebug();
-
-  //now calculate the angle of rotation from the "up" normal in our global coordinate system (0,0,1) to the rotation unit vector
-  //this calculation ultimately reduces to the inverse cosine of the z axis of the rotation unit vector
-  double angleOfRotation = acos(rotationUnitVector.getZ());
-  //SerialUSB.println((angleOfRotation / M_PI) * 180.0d, 2);
-
-  //now cross the "up" vector of the lighthouse with the "up" normal of the global coordinate system to obtain the axis of rotation for
-  //our quaternion; this calculation ultimately reduces to the y axis from the rotation unit vector becoming the x axis and the x axis
-  //becoming the negative y axis; then obtain the unit vector of the result
-  rotationUnitVector.set(rotationUnitVector.getY(), -rotationUnitVector.getX(), 0.0d, 1.0d);
-
-  //now that we have both the axis and angle of rotation, we can calculate our quaternion
-  lighthouseOrientation.set(rotationUnitVector.getX(), rotationUnitVector.getY(), rotationUnitVector.getZ(), angleOfRotation);
-
-  //take the forward unit vector in the lighthouse's coordinate system (0,1,0), and un-rotate it to get it into the global coordinate system
-  KVector3 lighthouseForwardVector(0.0d, 1.0d, 0.0d);
-  lighthouseForwardVector.unrotate(&lighthouseOrientation);
-  //KVector3 lighthouseForwardVector(getAccelDirX(), getAccelDirY(), -getAccelDirZ(), 1.0d);
-  //lighthouseForwardVector.printDebug();
-
-  //determine the height of the lighthouse from the diode plane
-  double lighthouseDistanceFromDiodePlane = LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM - ROBOT_DIODE_HEIGHT_MM;
-
-  //now we intersect the "forward" vector from the lighthouse with the diode plane to determine the relative x/y location where it's pointing
-  //that location becomes our origin point in our global coordinate system; the lighthouse is considered to be offset from that location
-  double t = -lighthouseDistanceFromDiodePlane / lighthouseForwardVector.getZ();
-  lighthousePosition.set(-lighthouseForwardVector.getX() * t,
-                         -lighthouseForwardVector.getY() * t,
-                         lighthouseDistanceFromDiodePlane);
-  //lighthousePosition.printDebug();
-
   receivedLighthousePosition = true;
 }
 
-unsigned int calculateDeltaTicks(unsigned int startTicks, unsigned int endTicks)
+void LighthouseSensor::restoreBaseStationInfo(const uint8_t* block)
 {
-  //calculate the delta between the ticks; they are derived from a 24-bit counter, so there is a weird hoop to jump through when it rolls over
-  if (startTicks > endTicks)
-    return (0x01000000 - startTicks) + endTicks;
-  else
-    return endTicks - startTicks;
+  memcpy(baseStationInfoBlock, block, BASE_STATION_INFO_BLOCK_SIZE);
+  calculateLighthousePosition();
 }
 
+
 //returns true when the x or y tick counts are updated
 void LighthouseSensor::loop()
 {
@@ -650,7 +644,8 @@ void LighthouseSensor::processSyncSignal(unsigned int previousTickCount, unsigne
   }
 
   //found a sync pulse; extract the OOTX bit if we still need the base station info block
-  if (!receivedLighthousePosition)
+  //a block restored from flash at startup may be stale, so keep listening until the lighthouse sends one itself
+  if (!baseStationInfoCount)
     processOOTXBit(deltaTicks);
 
   //we got a hit from the sweep; so is the sync pulse X or Y?
@@ -704,6 +699,19 @@ void LighthouseSensor::processSweepHit(unsigned int previousTicks, unsigned int
   cycleData[currentCycle].pendingSyncTickCount = 0;
   cycleData[currentCycle].sweepTickCount = sweepTickCount;
   cycleData[currentCycle].sweepHitTimeStamp = millis();
+  cycleData[currentCycle].sweepHitTicks = currentTicks;
+  latestSweepHitTicks = currentTicks;
+  sweepHitCount++;
+
+  if (recordSweepEvents && newSweepEventCount < LIGHTHOUSE_SENSOR_MAX_SWEEP_EVENTS) {
+    SweepEvent* event = &newSweepEvents[newSweepEventCount++];
+    event->sensor = debugNumber;
+    event->axis = currentCycle;
+    event->syncTicks = cycleData[currentCycle].syncTickCount;
+    event->sweepTicks = sweepTickCount;
+    event->hitTicks = currentTicks;
+    event->hitMicros = 0;
+  }
 
   pendingCycleEdge = SweepFalling;
 }
@@ -783,6 +791,8 @@ void LighthouseSensor::processOOTXBit(unsigned int syncDelta)
 #endif
 
         //now calculation the position and orientation of the lighthouse
+        memcpy(baseStationInfoBlock, receivingInfoBlock, BASE_STATION_INFO_BLOCK_SIZE);
+        baseStationInfoCount++;
         calculateLighthousePosition();
       }
       return;
@@ -820,9 +830,9 @@ void LighthouseSensor::processOOTXBit(unsigned int syncDelta)
   }
   else if (readInfoBlockMask) {
     if (value)
-      baseStationInfoBlock[readInfoBlockIndex] |= readInfoBlockMask;
+      receivingInfoBlock[readInfoBlockIndex] |= readInfoBlockMask;
     else
-      baseStationInfoBlock[readInfoBlockIndex] &= ~readInfoBlockMask;
+      receivingInfoBlock[readInfoBlockIndex] &= ~readInfoBlockMask;
 
     readInfoBlockMask >>= 1;
     if (readInfoBlockMask == 0) {
@@ -833,15 +843,10 @@ void LighthouseSensor::processOOTXBit(unsigned int syncDelta)
   }
 }
 
-double tickCountToAngle(double tickCount, RotorFactoryCalibrationData* fcalData)
-{
-  double angleFromLighthouse = tickCount / ((double)SWEEP_DURATION_TICKS);
-  double vectorFromLighthouse = tan(((angleFromLighthouse - 0.5d) * M_2PI_3) - fcalData->phase);
-  return vectorFromLighthouse;
-}
+
 
 /*
- * Translates combined x and y tick counts into a vector from the lighthouse to the zippy in the global coordinate system.
+ * Translates combined x and y tick counts into the position of the sensor in the global coordinate system.
  */
 void LighthouseSensor::recalculatePosition()
 {
@@ -860,36 +865,7 @@ void LighthouseSensor::recalculatePosition()
   previousPositionVector.set(&positionVector);
   previousPositionTimeStamp = positionTimeStamp;
   
-  //Step 1: Calculate the vector from the lighthouse in its reference frame to the diode.
-  //start by normalizing the angle on each axis from the lighthouse to be from 0.0 to 1.0
-  double angleFromLighthouseX = (((double)cycleData[0].sweepTickCount) / ((double)SWEEP_DURATION_TICKS));
-  double angleFromLighthouseZ = (((double)cycleData[1].sweepTickCount) / ((double)SWEEP_DURATION_TICKS));
-  //  SerialUSB.println(angleFromLighthouseX, 2);
-
-  //at y=1, we want the x and z coordinates of our direction vector; since the tangent is TAN = O / A, then O = TAN / A; given that
-  //our adjacent is 1.0, then the opposite (the length of each leg of the vector from our lighthouse) is simple the TAN of the angle
-  //along the x and z axes scaled to an angle from -60 degrees to +60 degrees, which is the field of view of the lighthouse
-  //TODO: eventually account for lighthouse factory calibration data
-  //  double vectorFromLighthouseX = tan((angleFromLighthouseX - 0.5d) * M_2PI_3);
-  //  double vectorFromLighthouseZ = tan((angleFromLighthouseZ - 0.5d) * M_2PI_3);
-  double vectorFromLighthouseX = tan(((angleFromLighthouseX - 0.5d) * M_2PI_3) + xRotor.phase);
-  double vectorFromLighthouseZ = tan(((angleFromLighthouseZ - 0.5d) * M_2PI_3) + yRotor.phase);
-
-  //Step 2: Convert the vector from the lighthouse in its local coordinate system to our global coordinate system.
-  //flip the x axis; it appears that our tick counts get greater from left-to-right when facing the lighthouse; this is contrary to
-  //some animations online which illustrate the horizontal beam sweeping from right-to-left
-  KVector3 directionFromLighthouse(-vectorFromLighthouseX, 1.0d, vectorFromLighthouseZ);
-  directionFromLighthouse.unrotate(&lighthouseOrientation);
-  directionFromLighthouse.normalize();
-  //  directionFromLighthouse.printDebug();
-
-  //now intersect with the plane of the diodes on the robot; since our diode plane is defined by the normal 0,0,1, and we have a
-  //vector which identifies the position of the lighthouse from 0,0,0, the entire formula for our ground-plane intersection reduces
-  //to the following
-  double t = -lighthousePosition.getZ() / directionFromLighthouse.getZ();
-
-  positionVector.set(lighthousePosition.getX() + (directionFromLighthouse.getX() * t),
-      lighthousePosition.getY() + (directionFromLighthouse.getY() * t));
+  geometry.calculateSensorPosition(cycleData[0].sweepTickCount, cycleData[1].sweepTickCount, &positionVector);
   positionTimeStamp = newPositionTimeStamp;
 }
 
@@ -4,18 +4,13 @@
 #include <Arduino.h>
 #include "KVector.h"
 #include "KQuaternion.h"
+#include "LighthouseGeometry.h"
 
 #define BUFFER_SIZE 32
-#define BASE_STATION_INFO_BLOCK_SIZE 33
-
-typedef struct _RotorFactoryCalibrationData
-{
-  double phase = 0.0d;
-  double curve = 0.0d;
-  double tilt = 0.0d;
-  double gibbousPhase = 0.0d;
-  double gibbousMagnitude = 0.0d;
-} RotorFactoryCalibrationData;
+//at most one sweep hit is captured for every four edges in the input buffer
+#define LIGHTHOUSE_SENSOR_MAX_SWEEP_EVENTS (BUFFER_SIZE / 4)
+//must be a power of two
+#define LIGHTHOUSE_SWEEP_EVENT_QUEUE_SIZE 16
 
 typedef struct _LighthouseSensorInput
 {
@@ -23,6 +18,8 @@ typedef struct _LighthouseSensorInput
   unsigned int* const hitTickEndPtr = hitTickBuffer + BUFFER_SIZE - 1;
   unsigned int* volatile hitTickWritePtr = hitTickBuffer;
   unsigned int* volatile hitTickReadPtr = hitTickEndPtr;
+  //edges captured while the buffer was full, which were lost
+  volatile unsigned long droppedTickCount = 0;
 } LighthouseSensorInput;
 
 enum CycleEdge
@@ -41,8 +38,24 @@ typedef struct _SensorCycleData
 
   //updated each time a sweep hit is detected; set to zero when lighthouse signal is unavailable
   unsigned long sweepHitTimeStamp = 0;
+  //timer tick count at which the sweep hit was captured
+  unsigned int sweepHitTicks = 0;
 } SensorCycleData;
 
+//a sweep hit, forwarded as-is to host tools that solve poses themselves
+typedef struct _SweepEvent
+{
+  //0 is the right sensor and 1 the left; 0 is the x axis and 1 the y axis
+  uint8_t sensor;
+  uint8_t axis;
+  //width of the sync pulse that started the cycle, and ticks from the start of the visible sweep to the hit
+  uint16_t syncTicks;
+  uint32_t sweepTicks;
+  //timer tick count at which the hit was captured, and then the equivalent micros(), once the lighthouse has timestamped it
+  unsigned int hitTicks;
+  unsigned long hitMicros;
+} SweepEvent;
+
 class LighthouseSensor
 {
 
@@ -59,6 +72,10 @@ private:
   unsigned short payloadLength;
   unsigned short payloadReadMask;
   byte baseStationInfoBlock[BASE_STATION_INFO_BLOCK_SIZE];
+  //the block is read into here, and only copied over the one above once all of it has arrived
+  byte receivingInfoBlock[BASE_STATION_INFO_BLOCK_SIZE];
+  //number of blocks actually received from the lighthouse, as opposed to restored from flash
+  unsigned long baseStationInfoCount = 0;
   int readInfoBlockIndex;
   byte readInfoBlockMask;
   
@@ -66,14 +83,10 @@ private:
   void calculateLighthousePosition();
 
   //once the OOTX frame has been found and processed, the lighthouse position and orientation are calculated
-  KVector3 lighthousePosition;
-  KQuaternion lighthouseOrientation;
+  LighthouseGeometry geometry;
   //...and then this flag is set to true
   bool receivedLighthousePosition;
 
-  RotorFactoryCalibrationData xRotor;
-  RotorFactoryCalibrationData yRotor;
-
   //current cycle is one of the following:
   //  -1 : unknown/reacquiring sync signal
   //   0 : x axis
@@ -84,6 +97,13 @@ private:
   unsigned int previousTickCount;
   //captured data in each cycle for the x and y axes
   SensorCycleData cycleData[2];
+  //incremented each time a sweep hit is captured on either axis, along with the timer tick count of the most recent one
+  unsigned long sweepHitCount = 0;
+  unsigned int latestSweepHitTicks = 0;
+  //sweep hits captured since the lighthouse last collected them, if it wants them
+  bool recordSweepEvents = false;
+  SweepEvent newSweepEvents[LIGHTHOUSE_SENSOR_MAX_SWEEP_EVENTS];
+  uint8_t newSweepEventCount = 0;
 
   //historical data for calculating velocity
   KVector2 previousPositionVector;
@@ -112,6 +132,12 @@ public:
   void loop();
 
   //info about the lighthouse position received by this sensor
+  bool hasBaseStationInfo() { return receivedLighthousePosition; }
+  const uint8_t* getBaseStationInfoBlock() { return baseStationInfoBlock; }
+  unsigned long getBaseStationInfoCount() { return baseStationInfoCount; }
+  unsigned long getDroppedTickCount() { return sensorInput->droppedTickCount; }
+  //uses a block saved from an earlier run until the lighthouse sends a new one
+  void restoreBaseStationInfo(const uint8_t* baseStationInfoBlock);
   int8_t getAccelDirX();
   int8_t getAccelDirY();
   int8_t getAccelDirZ();
@@ -153,6 +179,27 @@ private:
   KVector2 positionVector;
   unsigned long positionTimeStamp = 0;
 
+  //a new pose is available each time both sensors have captured a new sweep hit
+  unsigned long leftSweepHitCount = 0;
+  unsigned long rightSweepHitCount = 0;
+  unsigned long poseCount = 0;
+  unsigned long poseTimeMicros = 0;
+
+  //the pose extrapolated forward to the time at which the motors are expected to act upon it
+  KVector2 predictedPositionVector;
+  KVector2 predictedOrientationVector;
+  unsigned long predictedTimeMicros = 0;
+
+  //sweep hits from both sensors waiting to be forwarded, when enabled; both indexes only ever increase and are reduced when the
+  //ring is accessed
+  bool sweepEventsEnabled = false;
+  SweepEvent sweepEvents[LIGHTHOUSE_SWEEP_EVENT_QUEUE_SIZE];
+  uint8_t sweepEventHead = 0;
+  uint8_t sweepEventTail = 0;
+  unsigned long droppedSweepEventCount = 0;
+
+  void queueSweepEvents(LighthouseSensor* sensor, unsigned int currentTicks, unsigned long currentMicros);
+
   void setupClock();
   void setupEIC();
   void connectPortPinsToInterrupts();
@@ -163,9 +210,14 @@ public:
   Lighthouse();
 
   void start();
-  void loop();
+  //returns true when a new pose is available
+  bool loop();
 
   bool hasLighthouseSignal() { return leftSensor.hasLighthouseSignal() && rightSensor.hasLighthouseSignal(); }
+  //number of poses that have been made available, and the time, in micros(), at which the oldest of the sweep hits that
+  //make up the most recent pose actually occurred
+  unsigned long getPoseCount() { return poseCount; }
+  unsigned long getPoseTimeMicros() { return poseTimeMicros; }
   void recalculate();
   LighthouseSensor* getLeftSensor() { return &leftSensor; }
   LighthouseSensor* getRightSensor() { return &rightSensor; }
@@ -173,6 +225,27 @@ public:
   KVector2* getPosition() { return &positionVector; }
   KVector2* getOrientation() { return &orientationVector; }
   double getRotationalVelocity();
+
+  //extrapolates the most recently calculated pose forward to the given time, in micros(); ZippiesHost/zippy_predict.cpp
+  //compares how far the robot overshoots with and without it
+  void predictPose(unsigned long actuationTimeMicros);
+  KVector2* getPredictedPosition() { return &predictedPositionVector; }
+  KVector2* getPredictedOrientation() { return &predictedOrientationVector; }
+  unsigned long getPredictedTimeMicros() { return predictedTimeMicros; }
+
+  //every sweep hit from either sensor, in the order each sensor saw them; events are only collected while enabled
+  void enableSweepEvents(bool enabled);
+  SweepEvent* peekSweepEvent() { return sweepEventHead == sweepEventTail ? NULL : &sweepEvents[sweepEventHead & (LIGHTHOUSE_SWEEP_EVENT_QUEUE_SIZE-1)]; }
+  void releaseSweepEvent() { if (sweepEventHead != sweepEventTail) sweepEventHead++; }
+  unsigned long getDroppedSweepEventCount() { return droppedSweepEventCount; }
+  //edges lost to a full input buffer, from both sensors
+  unsigned long getDroppedTickCount() { return leftSensor.getDroppedTickCount() + rightSensor.getDroppedTickCount(); }
+  //the base station info block received by either sensor, or NULL if neither has received it yet
+  const uint8_t* getBaseStationInfoBlock();
+  unsigned long getBaseStationInfoCount() { return leftSensor.getBaseStationInfoCount() + rightSensor.getBaseStationInfoCount(); }
+  void restoreBaseStationInfo(const uint8_t* baseStationInfoBlock);
+  //solves the position of the lighthouse again, once the heights from the floor have been changed
+  void recalculateGeometry();
   
   void stop();
   
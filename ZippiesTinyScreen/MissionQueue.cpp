@@ -0,0 +1,114 @@
+
+#include "MissionQueue.h"
+#include "Parameters.h"
+
+//bytes in each type of record, including the type byte
+#define MISSION_POINT_RECORD_LENGTH      5
+#define MISSION_VALUE_RECORD_LENGTH      3
+
+extern Parameters parameters;
+
+MissionQueue::MissionQueue()
+  : head(0),
+    tail(0),
+    lastSequence(0),
+    sequenceReceived(false),
+    consumedCount(0),
+    rejectedCount(0),
+    statusChanged(false)
+{
+}
+
+int missionRecordLength(uint8_t type)
+{
+  switch (type) {
+    case MISSION_SEGMENT_WAYPOINT:
+    case MISSION_SEGMENT_ARC:
+      return MISSION_POINT_RECORD_LENGTH;
+    case MISSION_SEGMENT_PAUSE:
+    case MISSION_SEGMENT_DISTANCE:
+    case MISSION_SEGMENT_HEADING:
+    case MISSION_SEGMENT_SPEED:
+      return MISSION_VALUE_RECORD_LENGTH;
+  }
+  return 0;
+}
+
+bool MissionQueue::receive(uint8_t sequence, uint8_t* data, uint8_t dataLength)
+{
+  //the client is always told the outcome, even for a resent frame
+  statusChanged = true;
+
+  //a resent frame that we already have
+  if (sequenceReceived && sequence == lastSequence)
+    return true;
+
+  //validate the whole frame before queueing any of it, including arcs too tight to drive; see DriveArc
+  float minArcRadius = parameters.get(PARAMETER_WHEEL_BASE) / 2.0f;
+  int recordCount = 0;
+  int position = 0;
+  while (position < dataLength) {
+    int length = missionRecordLength(data[position]);
+    if (!length || position + length > dataLength) {
+      rejectedCount++;
+      return false;
+    }
+    if (data[position] == MISSION_SEGMENT_ARC) {
+      int16_t radius;
+      memcpy(&radius, data+position+1, sizeof(int16_t));
+      if (radius < minArcRadius) {
+        rejectedCount++;
+        return false;
+      }
+    }
+    position += length;
+    recordCount++;
+  }
+  if (recordCount > getFreeCount()) {
+    rejectedCount++;
+    return false;
+  }
+
+  position = 0;
+  while (position < dataLength) {
+    MissionSegment* segment = &segments[tail & (MISSION_QUEUE_SIZE-1)];
+    segment->type = data[position];
+    memcpy(&segment->a, data+position+1, sizeof(int16_t));
+    if (missionRecordLength(segment->type) == MISSION_POINT_RECORD_LENGTH)
+      memcpy(&segment->b, data+position+3, sizeof(int16_t));
+    else
+      segment->b = 0;
+    position += missionRecordLength(segment->type);
+    tail++;
+  }
+
+  lastSequence = sequence;
+  sequenceReceived = true;
+  return true;
+}
+
+void MissionQueue::pop()
+{
+  if (isEmpty())
+    return;
+
+  head++;
+  consumedCount++;
+  statusChanged = true;
+}
+
+void MissionQueue::clear()
+{
+  head = tail;
+  //the next mission can start its sequence numbers anywhere, including at the one the last mission ended on
+  sequenceReceived = false;
+  statusChanged = true;
+}
+
+void MissionQueue::getStatus(uint8_t* status)
+{
+  status[0] = lastSequence;
+  status[1] = getFreeCount();
+  memcpy(status+2, &consumedCount, sizeof(uint16_t));
+  memcpy(status+4, &rejectedCount, sizeof(uint16_t));
+}
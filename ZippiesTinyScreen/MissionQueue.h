@@ -0,0 +1,77 @@
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * Missions are sent in PROTOCOL_MISSION_APPEND frames, whose payload is a list of records, each of which is a type byte
+ * followed by a little-endian payload...
+ *
+ *   0x01 waypoint   x int16 (mm), y int16 (mm)
+ *   0x02 pause      duration uint16 (ms)
+ *   0x03 heading    heading int16 (milliradians, clockwise from +y)
+ *   0x04 speed      maximum velocity uint16 (mm/s) for the waypoints that follow; zero restores the default
+ *   0x05 distance   distance int16 (mm) straight ahead, or backward if negative
+ *   0x06 arc        radius int16 (mm), at least half the wheel base; angle int16 (milliradians, positive clockwise)
+ *
+ * A frame is accepted only if all of its records fit in the queue; otherwise it is dropped in its entirety and the client
+ * should send it again, with the same sequence number, once the mission status shows enough free space. A frame with a
+ * record that cannot be driven, such as an arc tighter than half the wheel base, is dropped in the same way. A frame whose
+ * sequence number matches the last one accepted is acknowledged but otherwise ignored, so resending is always safe. Clearing
+ * the queue also forgets the last sequence number, so the first frame after it is always accepted.
+ */
+#define MISSION_SEGMENT_WAYPOINT   0x01
+#define MISSION_SEGMENT_PAUSE      0x02
+#define MISSION_SEGMENT_HEADING    0x03
+#define MISSION_SEGMENT_SPEED      0x04
+#define MISSION_SEGMENT_DISTANCE   0x05
+#define MISSION_SEGMENT_ARC        0x06
+
+//number of segments buffered between the client and the robot; must be a power of two
+#define MISSION_QUEUE_SIZE           32
+
+//length of the mission status sent back to the client
+#define MISSION_STATUS_LENGTH         6
+
+typedef struct _MissionSegment
+{
+  uint8_t type;
+  int16_t a;
+  int16_t b;
+} MissionSegment;
+
+class MissionQueue
+{
+
+private:
+  MissionSegment segments[MISSION_QUEUE_SIZE];
+  //both only ever increase; they are reduced to indexes when the buffer is accessed, so the queue can use every slot
+  uint16_t head;
+  uint16_t tail;
+
+  uint8_t lastSequence;
+  bool sequenceReceived;
+  uint16_t consumedCount;
+  uint16_t rejectedCount;
+  bool statusChanged;
+
+public:
+  MissionQueue();
+
+  //parses the records of a mission frame; returns false if the frame was rejected
+  bool receive(uint8_t sequence, uint8_t* data, uint8_t dataLength);
+  //drops the queued segments and resets the sequence
+  void clear();
+
+  bool isEmpty() { return head == tail; }
+  uint8_t getFreeCount() { return MISSION_QUEUE_SIZE - (uint16_t)(tail - head); }
+  MissionSegment* peek() { return isEmpty() ? NULL : &segments[head & (MISSION_QUEUE_SIZE-1)]; }
+  void pop();
+
+  //last sequence accepted, free segments, segments consumed by the robot, and packets rejected; the status counts as changed
+  //until completeStatus() is called, once the response carrying it has actually been sent
+  bool hasStatusChanged() { return statusChanged; }
+  void getStatus(uint8_t* status);
+  void completeStatus() { statusChanged = false; }
+
+};
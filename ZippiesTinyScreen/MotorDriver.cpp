@@ -5,6 +5,8 @@
 #include "T841Defs.h"
 #include "MotorDriver.h"
 #include "LighthouseSensor.h"
+#include "Parameters.h"
+#include "Battery.h"
 
 #define MOTORS_ADDRESS 0
 #define MOTORS_MAX_PWM_PERIOD 0xFFFF
@@ -63,9 +65,14 @@
 #define _BV(bit) (1 << (bit))
 
 extern Lighthouse lighthouse;
+extern Parameters parameters;
+extern Battery battery;
 
 MotorDriver::MotorDriver()
-  : started(false)
+  : started(false),
+    leftPower(0),
+    rightPower(0),
+    compensation(1.0d)
 {
 }
 
@@ -128,6 +135,10 @@ void MotorDriver::setMotors(int32_t motorLeft, int32_t motorRight)
   SerialUSB.print(" ");
   SerialUSB.println(motorRight);
   */
+  leftPower = motorLeft;
+  rightPower = motorRight;
+  motorLeft = compensate(motorLeft);
+  motorRight = compensate(motorRight);
   this->writeCommand(COMMAND_ALL_PWM,
       motorLeft < 0 ? -motorLeft: 0,
       motorLeft > 0 ? motorLeft: 0,
@@ -135,8 +146,57 @@ void MotorDriver::setMotors(int32_t motorLeft, int32_t motorRight)
       motorRight > 0 ? motorRight: 0);
 }
 
+int32_t MotorDriver::compensate(int32_t power)
+{
+  int32_t compensatedPower = power * compensation;
+  if (compensatedPower > MOTORS_MAX_PWM_PERIOD)
+    return MOTORS_MAX_PWM_PERIOD;
+  else if (compensatedPower < -MOTORS_MAX_PWM_PERIOD)
+    return -MOTORS_MAX_PWM_PERIOD;
+  return compensatedPower;
+}
+
+double padInner(double motorPower, double magnitude)
+{
+  if (motorPower > 0.0d)
+    return magnitude + motorPower;
+  else if (motorPower < 0.0d)
+    return -magnitude + motorPower;
+
+  return 0.0d;
+}
+
+void MotorDriver::setVelocity(double linearVelocity, double angularVelocity)
+{
+  //unicycle to differential drive kinematics; positive angular velocity is clockwise, so the left wheel must turn faster
+  double wheelBase = parameters.get(PARAMETER_WHEEL_BASE);
+  double leftVelocity = linearVelocity + (angularVelocity * wheelBase / 2.0d);
+  double rightVelocity = linearVelocity - (angularVelocity * wheelBase / 2.0d);
+
+  //if either wheel would saturate, slow both down equally so that the robot still follows the requested curvature; the
+  //powers are scaled up for the battery voltage afterwards, which leaves less headroom as it runs down
+  double minPower = parameters.get(PARAMETER_MOTOR_MIN_POWER);
+  double powerPerVelocity = parameters.get(PARAMETER_MOTOR_POWER_PER_VELOCITY);
+  double maxVelocity = ((MOTORS_MAX_PWM_PERIOD / compensation) - minPower) / powerPerVelocity;
+  double fastestVelocity = max(fabs(leftVelocity), fabs(rightVelocity));
+  if (fastestVelocity > maxVelocity) {
+    leftVelocity *= maxVelocity / fastestVelocity;
+    rightVelocity *= maxVelocity / fastestVelocity;
+  }
+
+  setMotors(padInner(leftVelocity * powerPerVelocity, minPower),
+            padInner(rightVelocity * powerPerVelocity, minPower));
+}
+
 void MotorDriver::loop()
 {
+  //a motor turns at a speed set by the voltage across it, which is its share of the PWM period times the supply voltage
+  if (!battery.hasVoltage())
+    return;
+
+  compensation = MOTOR_REFERENCE_MILLIVOLTS / (double)battery.getMillivolts();
+  if (compensation > MOTOR_MAX_COMPENSATION)
+    compensation = MOTOR_MAX_COMPENSATION;
 }
 
 void MotorDriver::writeByte(uint8_t b1)
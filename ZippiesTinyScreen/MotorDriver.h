@@ -3,11 +3,32 @@
 
 #include "LighthouseSensor.h"
 
+//the minimum PCM value below which the motors do not turn; the default for PARAMETER_MOTOR_MIN_POWER
+#define MOTOR_MIN_POWER                      4600.00d
+//placeholders that have not been measured on a robot yet; the defaults for PARAMETER_MOTOR_POWER_PER_VELOCITY and
+//PARAMETER_WHEEL_BASE, which should be calibrated for each robot and committed. To calibrate, drive straight at a few powers
+//and time the robot over a known distance with the lighthouse for the PCM value, above the minimum, per mm/s of wheel
+//velocity; then spin in place at a known power and compare the angular velocity the lighthouse reports with the wheel
+//velocity for the distance between the centers of the wheels
+#define MOTOR_POWER_PER_MM_PER_SECOND          25.00d
+#define WHEEL_BASE_MM                          30.00d
+//the supply voltage at which the motor powers were tuned; the power actually sent to the motors is scaled up as the battery
+//runs down, so that they still turn at the same speed
+#define MOTOR_REFERENCE_MILLIVOLTS           3300.00d
+//the most the power is ever scaled up, in case the voltage reads low
+#define MOTOR_MAX_COMPENSATION                  1.40d
+
 class MotorDriver
 {
 
 private:
   bool started;
+  int32_t leftPower;
+  int32_t rightPower;
+  //the powers requested are multiplied by this before they are sent to the motors
+  double compensation;
+
+  int32_t compensate(int32_t power);
 
   void writeByte(uint8_t);
   void writeByte(uint8_t, uint8_t);
@@ -20,6 +41,12 @@ public:
   bool start();
   void setFailsafe(uint16_t ms);
   void setMotors(int32_t motorLeft, int32_t motorRight);
+  //the powers requested, before compensating for the battery voltage
+  int32_t getLeftPower() { return leftPower; }
+  int32_t getRightPower() { return rightPower; }
+  double getCompensation() { return compensation; }
+  //linear velocity in mm/s and angular velocity in radians/s, positive clockwise, of the point between the wheels
+  void setVelocity(double linearVelocity, double angularVelocity);
   void loop();
   
 };
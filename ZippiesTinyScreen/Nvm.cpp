@@ -0,0 +1,59 @@
+
+#include <Arduino.h>
+#include "Nvm.h"
+
+void nvmRead(const uint8_t* source, void* destination, uint32_t length)
+{
+  const volatile uint8_t* from = source;
+  uint8_t* to = (uint8_t*)destination;
+  for (uint32_t i = 0; i < length; i++)
+    to[i] = from[i];
+}
+
+void waitForNvmReady()
+{
+  while (!NVMCTRL->INTFLAG.bit.READY);
+}
+
+//runs a command after clearing the errors left by the last one; returns false if this one failed
+bool runNvmCommand(uint32_t command)
+{
+  NVMCTRL->STATUS.reg = NVMCTRL_STATUS_MASK;
+  NVMCTRL->INTFLAG.reg = NVMCTRL_INTFLAG_ERROR;
+  NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMDEX_KEY | command;
+  waitForNvmReady();
+  return !NVMCTRL->INTFLAG.bit.ERROR;
+}
+
+bool nvmEraseRow(const uint8_t* row)
+{
+  //the address register takes 16-bit words
+  NVMCTRL->ADDR.reg = ((uint32_t)(uintptr_t)row) / 2;
+  return runNvmCommand(NVMCTRL_CTRLA_CMD_ER);
+}
+
+bool nvmWrite(const uint8_t* destination, const void* source, uint32_t length)
+{
+  //write each page when we say so, rather than when its last word is filled
+  NVMCTRL->CTRLB.bit.MANW = 1;
+
+  volatile uint32_t* to = (volatile uint32_t*)destination;
+  const uint8_t* from = (const uint8_t*)source;
+  while (length) {
+    if (!runNvmCommand(NVMCTRL_CTRLA_CMD_PBC))
+      return false;
+
+    //the page buffer only accepts 32-bit writes
+    for (uint8_t i = 0; i < NVM_PAGE_SIZE / 4 && length; i++) {
+      uint32_t word;
+      memcpy(&word, from, sizeof(uint32_t));
+      *to++ = word;
+      from += sizeof(uint32_t);
+      length -= sizeof(uint32_t);
+    }
+
+    if (!runNvmCommand(NVMCTRL_CTRLA_CMD_WP))
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Writes to the SAMD21's own flash through the NVM controller, for settings that have to survive a reboot. Flash is erased a
+ * row (four pages) at a time, and can only be written where it has been erased since. The CPU stalls while each command runs,
+ * up to a few milliseconds for a row erase, so the sketch only ever runs one command per pass; see KeyValueStore.h.
+ */
+#define NVM_PAGE_SIZE           64
+#define NVM_ROW_SIZE            (4 * NVM_PAGE_SIZE)
+
+//sets aside whole rows of flash among the program's constants; they are erased, like the rest of the flash, when a new sketch
+//is uploaded
+#define NVM_RESERVE_ROWS(name, rowCount) \
+  __attribute__((__aligned__(NVM_ROW_SIZE))) const uint8_t name[(rowCount) * NVM_ROW_SIZE] = { }
+
+//reads must go through here; the compiler otherwise assumes that the reserved rows still hold their initial zeros
+void nvmRead(const uint8_t* source, void* destination, uint32_t length);
+//both return false if the NVM controller reports an error, such as the row being locked
+bool nvmEraseRow(const uint8_t* row);
+//the destination must be page-aligned and erased, and the length a multiple of four bytes
+bool nvmWrite(const uint8_t* destination, const void* source, uint32_t length);
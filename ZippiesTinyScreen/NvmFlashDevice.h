@@ -0,0 +1,26 @@
+
+#pragma once
+
+#include "FlashDevice.h"
+#include "Nvm.h"
+
+//rows set aside in the SAMD21's flash with NVM_RESERVE_ROWS
+class NvmFlashDevice : public FlashDevice
+{
+
+private:
+  const uint8_t* rows;
+  uint16_t rowCount;
+
+public:
+  NvmFlashDevice(const uint8_t* rows, uint16_t rowCount)
+    : rows(rows),
+      rowCount(rowCount)
+  {}
+
+  uint16_t getRowCount() { return rowCount; }
+  void read(uint32_t offset, void* data, uint32_t length) { nvmRead(rows + offset, data, length); }
+  bool eraseRow(uint16_t row) { return nvmEraseRow(rows + (row * FLASH_ROW_SIZE)); }
+  bool writePage(uint16_t page, const uint8_t* data) { return nvmWrite(rows + (page * FLASH_PAGE_SIZE), data, FLASH_PAGE_SIZE); }
+
+};
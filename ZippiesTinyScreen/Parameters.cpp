@@ -0,0 +1,175 @@
+
+#include <Arduino.h>
+#include "Parameters.h"
+#include "KeyValueStore.h"
+#include "ZippyCommand.h"
+#include "ZippyModes.h"
+#include "MotorDriver.h"
+#include "LighthouseGeometry.h"
+
+const ParameterDefinition PARAMETER_DEFINITIONS[PARAMETER_COUNT] = {
+  //type, minimum, maximum, default
+  { PARAMETER_TYPE_FLOAT,    0.0f,    20.0f, AUTODRIVE_LINEAR_Kp },                     //PARAMETER_LINEAR_KP
+  { PARAMETER_TYPE_FLOAT,    0.0f,    20.0f, AUTODRIVE_LINEAR_Ki },                     //PARAMETER_LINEAR_KI
+  { PARAMETER_TYPE_FLOAT,    0.0f,    20.0f, AUTODRIVE_LINEAR_Kd },                     //PARAMETER_LINEAR_KD
+  { PARAMETER_TYPE_FLOAT,    0.0f,    50.0f, AUTODRIVE_ANGULAR_Kp },                    //PARAMETER_ANGULAR_KP
+  { PARAMETER_TYPE_FLOAT,    0.0f,    50.0f, AUTODRIVE_ANGULAR_Ki },                    //PARAMETER_ANGULAR_KI
+  { PARAMETER_TYPE_FLOAT,    0.0f,    50.0f, AUTODRIVE_ANGULAR_Kd },                    //PARAMETER_ANGULAR_KD
+  { PARAMETER_TYPE_FLOAT,    0.0f, 30000.0f, MOTOR_MIN_POWER },                         //PARAMETER_MOTOR_MIN_POWER
+  { PARAMETER_TYPE_FLOAT,   10.0f,  1000.0f, LOOK_AHEAD_DISTANCE },                     //PARAMETER_LOOK_AHEAD_DISTANCE
+  { PARAMETER_TYPE_FLOAT,  100.0f,  4000.0f, LIGHTHOUSE_CENTER_HEIGHT_FROM_FLOOR_MM },  //PARAMETER_LIGHTHOUSE_HEIGHT
+  { PARAMETER_TYPE_FLOAT,    0.0f,   100.0f, ROBOT_DIODE_HEIGHT_MM },                   //PARAMETER_DIODE_HEIGHT
+  { PARAMETER_TYPE_INT,      1.0f,    12.0f, AUTODRIVE_POSE_DECIMATION },               //PARAMETER_POSE_DECIMATION
+  { PARAMETER_TYPE_FLOAT,    1.0f,   500.0f, MOTOR_POWER_PER_MM_PER_SECOND },           //PARAMETER_MOTOR_POWER_PER_VELOCITY
+  { PARAMETER_TYPE_FLOAT,   10.0f,   200.0f, WHEEL_BASE_MM },                           //PARAMETER_WHEEL_BASE
+};
+
+//ids never change, so values committed by firmware with fewer parameters load into the first few of ours
+static_assert(PARAMETER_COUNT * sizeof(float) <= KV_VALUE_MAX_LENGTH, "the parameters must fit in a single settings record");
+
+extern KeyValueStore settings;
+
+Parameters::Parameters()
+  : stagedMask(0),
+    readMask(0),
+    generation(0),
+    commitCount(0)
+{
+  for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+    values[i] = PARAMETER_DEFINITIONS[i].defaultValue;
+    stagedValues[i] = values[i];
+  }
+}
+
+bool Parameters::decode(const uint8_t* encoded, uint8_t* id, float* value)
+{
+  *id = encoded[0];
+  if (*id >= PARAMETER_COUNT)
+    return false;
+
+  const ParameterDefinition* definition = &PARAMETER_DEFINITIONS[*id];
+  if (definition->type == PARAMETER_TYPE_INT) {
+    int32_t intValue;
+    memcpy(&intValue, encoded+1, sizeof(int32_t));
+    *value = (float)intValue;
+  }
+  else {
+    memcpy(value, encoded+1, sizeof(float));
+    //NaN fails both of the comparisons below, so it has to be caught here
+    if (*value != *value)
+      return false;
+  }
+
+  return *value >= definition->minimum && *value <= definition->maximum;
+}
+
+bool Parameters::isValid(const uint8_t* encoded)
+{
+  uint8_t id;
+  float value;
+  return decode(encoded, &id, &value);
+}
+
+bool Parameters::stage(const uint8_t* encoded)
+{
+  uint8_t id;
+  float value;
+  if (!decode(encoded, &id, &value))
+    return false;
+
+  stagedValues[id] = value;
+  stagedMask |= PARAMETER_BIT(id);
+  return true;
+}
+
+uint32_t Parameters::apply()
+{
+  if (!stagedMask)
+    return 0;
+
+  uint32_t changedMask = 0;
+  for (uint8_t i = 0; i < PARAMETER_COUNT; i++) {
+    if ((stagedMask & PARAMETER_BIT(i)) && stagedValues[i] != values[i]) {
+      values[i] = stagedValues[i];
+      changedMask |= PARAMETER_BIT(i);
+    }
+  }
+  stagedMask = 0;
+
+  if (changedMask)
+    generation++;
+  return changedMask;
+}
+
+bool Parameters::requestRead(uint8_t id)
+{
+  if (id >= PARAMETER_COUNT)
+    return false;
+
+  readMask |= PARAMETER_BIT(id);
+  return true;
+}
+
+void Parameters::requestReadAll()
+{
+  readMask = PARAMETER_BIT(PARAMETER_COUNT) - 1;
+}
+
+uint8_t Parameters::encodeReads(uint8_t* payload, uint8_t maxLength, uint32_t* sentMask)
+{
+  uint8_t length = 0;
+  *sentMask = 0;
+  for (uint8_t i = 0; i < PARAMETER_COUNT && length + PARAMETER_ENCODED_LENGTH <= maxLength; i++) {
+    if (!(readMask & PARAMETER_BIT(i)))
+      continue;
+
+    payload[length] = i;
+    if (PARAMETER_DEFINITIONS[i].type == PARAMETER_TYPE_INT) {
+      int32_t intValue = (int32_t)values[i];
+      memcpy(payload+length+1, &intValue, sizeof(int32_t));
+    }
+    else
+      memcpy(payload+length+1, &values[i], sizeof(float));
+    length += PARAMETER_ENCODED_LENGTH;
+    *sentMask |= PARAMETER_BIT(i);
+  }
+  return length;
+}
+
+bool Parameters::commit()
+{
+  //values staged since the last apply() are saved too, since a write and a commit can arrive before the sketch applies it
+  float committedValues[PARAMETER_COUNT];
+  for (uint8_t i = 0; i < PARAMETER_COUNT; i++)
+    committedValues[i] = (stagedMask & PARAMETER_BIT(i)) ? stagedValues[i] : values[i];
+  if (!settings.put(KV_KEY_PARAMETERS, committedValues, sizeof(committedValues)))
+    return false;
+
+  commitCount++;
+  return true;
+}
+
+void Parameters::load()
+{
+  float storedValues[PARAMETER_COUNT];
+  int storedLength = settings.get(KV_KEY_PARAMETERS, storedValues, sizeof(storedValues));
+  if (storedLength <= 0)
+    return;
+
+  //each value is checked against the current range, which may have changed since it was committed
+  uint8_t valueCount = storedLength / sizeof(float);
+  if (valueCount > PARAMETER_COUNT)
+    valueCount = PARAMETER_COUNT;
+  for (uint8_t i = 0; i < valueCount; i++) {
+    uint8_t encoded[PARAMETER_ENCODED_LENGTH];
+    encoded[0] = i;
+    if (PARAMETER_DEFINITIONS[i].type == PARAMETER_TYPE_INT) {
+      int32_t intValue = (int32_t)storedValues[i];
+      memcpy(encoded+1, &intValue, sizeof(int32_t));
+    }
+    else
+      memcpy(encoded+1, &storedValues[i], sizeof(float));
+    stage(encoded);
+  }
+  apply();
+}
@@ -0,0 +1,91 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Registry of the settings that can be tuned at runtime, each with a type, a range and a default. The client reads and writes
+ * them in batches with the PROTOCOL_PARAMETERS_* commands, encoded as...
+ *
+ *   [id u8][value 4 bytes; float32 or int32, according to the type of the parameter]
+ *
+ * Written values are staged and only take effect when the sketch calls apply(), between control steps, so that a controller
+ * never sees half of a batch. They last until the next reboot unless the client also asks for them to be committed, which
+ * saves them in the settings store under KV_KEY_PARAMETERS; the committed values are loaded at startup. New parameters must be
+ * given the next unused id, so that values committed by older firmware still load.
+ */
+#define PARAMETER_LINEAR_KP                0x00
+#define PARAMETER_LINEAR_KI                0x01
+#define PARAMETER_LINEAR_KD                0x02
+#define PARAMETER_ANGULAR_KP               0x03
+#define PARAMETER_ANGULAR_KI               0x04
+#define PARAMETER_ANGULAR_KD               0x05
+#define PARAMETER_MOTOR_MIN_POWER          0x06  //PWM
+#define PARAMETER_LOOK_AHEAD_DISTANCE      0x07  //mm
+#define PARAMETER_LIGHTHOUSE_HEIGHT        0x08  //mm from the floor
+#define PARAMETER_DIODE_HEIGHT             0x09  //mm from the floor
+#define PARAMETER_POSE_DECIMATION          0x0A  //a control step is run on every Nth pose from the lighthouse
+#define PARAMETER_MOTOR_POWER_PER_VELOCITY 0x0B  //PWM above the minimum for each mm/s of wheel velocity
+#define PARAMETER_WHEEL_BASE               0x0C  //mm between the centers of the wheels
+#define PARAMETER_COUNT                      13
+
+#define PARAMETER_TYPE_FLOAT                  0
+#define PARAMETER_TYPE_INT                    1
+
+#define PARAMETER_ENCODED_LENGTH              5
+#define PARAMETER_BIT(id)                     (1UL << (id))
+
+typedef struct _ParameterDefinition
+{
+  uint8_t type;
+  float minimum;
+  float maximum;
+  float defaultValue;
+} ParameterDefinition;
+
+extern const ParameterDefinition PARAMETER_DEFINITIONS[PARAMETER_COUNT];
+
+class Parameters
+{
+
+private:
+  float values[PARAMETER_COUNT];
+  float stagedValues[PARAMETER_COUNT];
+  uint32_t stagedMask;
+  //parameters the client has asked to read, which go out with the next responses
+  uint32_t readMask;
+  //changes each time apply() changes any value, so that users of the values know to pick them up again
+  uint8_t generation;
+  unsigned long commitCount;
+
+  bool decode(const uint8_t* encoded, uint8_t* id, float* value);
+
+public:
+  Parameters();
+
+  float get(uint8_t id) { return values[id]; }
+  int getInt(uint8_t id) { return (int)values[id]; }
+  uint8_t getGeneration() { return generation; }
+
+  //returns false if the id is unknown or the value is out of range, in which case nothing is staged
+  bool isValid(const uint8_t* encoded);
+  bool stage(const uint8_t* encoded);
+  //makes the staged values current; returns the bits of the parameters that changed
+  uint32_t apply();
+
+  bool requestRead(uint8_t id);
+  void requestReadAll();
+  bool hasReadsPending() { return readMask != 0; }
+  //encodes as many of the requested values as fit; the bits of those encoded are returned in sentMask, to be passed to
+  //completeReads() once the response has actually been sent
+  uint8_t encodeReads(uint8_t* payload, uint8_t maxLength, uint32_t* sentMask);
+  void completeReads(uint32_t sentMask) { readMask &= ~sentMask; }
+
+  //queues the current values to be saved, along with any staged but not yet applied; returns false if the settings store
+  //has no room for them right now
+  bool commit();
+  //replaces the defaults with the values last committed, if any; the settings store must have been started first
+  void load();
+  unsigned long getCommitCount() { return commitCount; }
+
+};
@@ -0,0 +1,108 @@
+
+#pragma once
+
+/**
+ * PID controller for any numeric type T (float, Fixed16, etc.), with defaults taken from a Config type at compile time, e.g...
+ *
+ *   struct SteeringPidConfig
+ *   {
+ *     static constexpr float Kp = 3.0f;
+ *     static constexpr float Ki = 0.3f;
+ *     static constexpr float Kd = 0.1f;
+ *     //output is clamped to this range
+ *     static constexpr float OutputMin = -4.0f;
+ *     static constexpr float OutputMax = 4.0f;
+ *     //rate at which the integral is unwound while the output is saturated (back-calculation)
+ *     static constexpr float AntiWindupGain = 1.0f;
+ *     //time constant, in seconds, of the low-pass filter applied to the derivative
+ *     static constexpr float DerivativeTimeConstant = 0.05f;
+ *   };
+ *
+ * Unlike PID_v1, nothing is allocated or referenced by pointer, and the controller never consults the clock; the caller
+ * provides the elapsed time for each update. The derivative is taken on the measurement rather than the error so that
+ * changes to the set point do not cause a derivative kick.
+ *
+ * The integral gathers ki*error*dt, which can be far smaller than the error itself; with a fixed-point T, small errors can
+ * round away to nothing on every update, so that they are never integrated. The integral can be kept in a more precise type I
+ * for that; it only has to hold the output range. ZippiesHost/zippy_pid_bench.cpp compares the cost of an update with PID_v1.
+ */
+template<typename T, typename Config, typename I = T>
+class Pid
+{
+
+private:
+  T kp;
+  T ki;
+  T kd;
+
+  I integral;
+  T derivative;
+  T previousMeasurement;
+  T output;
+
+  template<typename V>
+  static V clamp(V value)
+  {
+    if (value < V(Config::OutputMin))
+      return V(Config::OutputMin);
+    if (value > V(Config::OutputMax))
+      return V(Config::OutputMax);
+    return value;
+  }
+
+public:
+  Pid()
+    : kp(Config::Kp),
+      ki(Config::Ki),
+      kd(Config::Kd),
+      integral(0.0f),
+      derivative(0.0f),
+      previousMeasurement(0.0f),
+      output(0.0f)
+  {
+  }
+
+  void setTunings(T p, T i, T d)
+  {
+    kp = p;
+    ki = i;
+    kd = d;
+  }
+
+  T getOutput() { return output; }
+  T getIntegral() { return T(integral); }
+
+  //start over from the given measurement; the integral picks up from the given output so that there is no bump
+  void reset(T measurement, T currentOutput)
+  {
+    output = clamp(currentOutput);
+    integral = I(output);
+    derivative = T(0.0f);
+    previousMeasurement = measurement;
+  }
+
+  T update(T setPoint, T measurement, T deltaSeconds)
+  {
+    if (deltaSeconds <= T(0.0f))
+      return output;
+
+    T error = setPoint - measurement;
+
+    //derivative on measurement, passed through a first-order low-pass filter; the raw derivative is -kd*change/dt and the
+    //filter moves dt/(dt+tau) of the way toward it, which cancel into a single divide
+    derivative += (-(kd * (measurement - previousMeasurement)) - (derivative * deltaSeconds)) /
+        (deltaSeconds + T(Config::DerivativeTimeConstant));
+    previousMeasurement = measurement;
+
+    T unclampedOutput = (kp * error) + T(integral) + derivative;
+    output = clamp(unclampedOutput);
+
+    //integrate, while bleeding off whatever portion of the output was lost to saturation; then clamp the integral itself so
+    //that it can never exceed the output range on its own
+    integral += ((I(ki) * I(error)) + I(T(Config::AntiWindupGain) * (output - unclampedOutput))) * I(deltaSeconds);
+    integral = clamp(integral);
+
+    return output;
+  }
+
+};
@@ -0,0 +1,84 @@
+
+#include <Arduino.h>
+#include "Profiler.h"
+
+uint8_t getProfileBucket(unsigned long micros)
+{
+  uint8_t bucket = 0;
+  micros >>= PROFILE_FIRST_BUCKET_SHIFT;
+  while (micros && bucket < PROFILE_BUCKET_COUNT - 1) {
+    micros >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+unsigned long getProfileBucketLimit(uint8_t bucket)
+{
+  if (bucket >= PROFILE_BUCKET_COUNT - 1)
+    return 0xFFFFFFFFUL;
+  return (PROFILE_FIRST_BUCKET_MICROS << bucket) - 1;
+}
+
+Profiler::Profiler()
+  : passStartMicros(0)
+{
+  reset();
+}
+
+void Profiler::startPass()
+{
+  passStartMicros = micros();
+}
+
+void Profiler::endPass()
+{
+  record(PROFILE_STAGE_PASS, micros() - passStartMicros);
+}
+
+void Profiler::record(uint8_t stage, unsigned long micros)
+{
+  StageProfile* profile = &stages[stage];
+  uint8_t bucket = getProfileBucket(micros);
+  if (profile->buckets[bucket] == 0xFFFF) {
+    for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++)
+      profile->buckets[i] >>= 1;
+    profile->halvingCount++;
+  }
+  profile->buckets[bucket]++;
+  profile->sampleCount++;
+  profile->lastMicros = micros;
+  if (micros > profile->maxMicros)
+    profile->maxMicros = micros;
+}
+
+void Profiler::reset()
+{
+  for (uint8_t i = 0; i < PROFILE_STAGE_COUNT; i++) {
+    memset(stages[i].buckets, 0, sizeof(stages[i].buckets));
+    stages[i].halvingCount = 0;
+    stages[i].sampleCount = 0;
+    stages[i].lastMicros = 0;
+    stages[i].maxMicros = 0;
+  }
+}
+
+unsigned long Profiler::getPercentileMicros(uint8_t stage, uint8_t percent)
+{
+  StageProfile* profile = &stages[stage];
+  unsigned long total = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++)
+    total += profile->buckets[i];
+  if (!total)
+    return 0;
+
+  unsigned long target = ((total * percent) + 99) / 100;
+  unsigned long count = 0;
+  for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++) {
+    count += profile->buckets[i];
+    //the bucket can't tell us any more than that the time was no longer than the longest seen
+    if (count >= target)
+      return min(getProfileBucketLimit(i), profile->maxMicros);
+  }
+  return profile->maxMicros;
+}
@@ -0,0 +1,67 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Times each stage of the sketch's loop, every time it runs, so that we can see which of them blows the budget once the robot
+ * is out in the field. Each stage is one of the scheduler's tasks (see Scheduler.h), which records how long it took; each time
+ * goes into a histogram of fixed buckets for its stage, alongside the longest time seen. Timestamps come from micros(), which
+ * the core keeps with SysTick.
+ */
+#define PROFILE_STAGE_PASS            0  //the whole pass through loop()
+#define PROFILE_STAGE_LIGHTHOUSE      1
+#define PROFILE_STAGE_CONTROL         2  //the drive mode acting on a new pose
+#define PROFILE_STAGE_TRANSPORTS      3  //draining the Bluetooth and serial transports, and handling the commands
+#define PROFILE_STAGE_MODE            4  //the drive mode's timeouts, and switching modes
+#define PROFILE_STAGE_MOTORS          5
+#define PROFILE_STAGE_RESPONSE        6  //acknowledging commands
+#define PROFILE_STAGE_TELEMETRY       7  //sampling telemetry
+#define PROFILE_STAGE_SEND            8  //sending the telemetry packets
+#define PROFILE_STAGE_FACE            9  //sending the face to the display
+#define PROFILE_STAGE_FACE_CHANGES   10  //checking what should be on the face
+#define PROFILE_STAGE_SETTINGS       11  //saving to flash
+#define PROFILE_STAGE_DEBUG_INFO     12  //the legacy debug packets
+#define PROFILE_STAGE_COUNT          13
+
+//the first bucket holds times under PROFILE_FIRST_BUCKET_MICROS, each bucket after it holds times up to twice as long as the
+//one before, and the last holds everything from 16ms up
+#define PROFILE_BUCKET_COUNT         12
+#define PROFILE_FIRST_BUCKET_SHIFT    4
+#define PROFILE_FIRST_BUCKET_MICROS   (1UL << PROFILE_FIRST_BUCKET_SHIFT)
+
+typedef struct _StageProfile
+{
+  //when a bucket is about to overflow, all of them are halved, which keeps their proportions; the number of times that has
+  //happened is counted
+  uint16_t buckets[PROFILE_BUCKET_COUNT];
+  unsigned long halvingCount = 0;
+  unsigned long sampleCount = 0;
+  unsigned long lastMicros = 0;
+  unsigned long maxMicros = 0;
+} StageProfile;
+
+//the bucket for the given time, and the longest time held by the given bucket
+uint8_t getProfileBucket(unsigned long micros);
+unsigned long getProfileBucketLimit(uint8_t bucket);
+
+class Profiler
+{
+
+private:
+  StageProfile stages[PROFILE_STAGE_COUNT];
+  unsigned long passStartMicros;
+
+public:
+  Profiler();
+
+  void startPass();
+  void endPass();
+  void record(uint8_t stage, unsigned long micros);
+  void reset();
+
+  StageProfile* getStage(uint8_t stage) { return &stages[stage]; }
+  //the longest time held by the bucket that the given percentage of the samples falls within
+  unsigned long getPercentileMicros(uint8_t stage, uint8_t percent);
+
+};
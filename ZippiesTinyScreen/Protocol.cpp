@@ -0,0 +1,100 @@
+
+#include "Protocol.h"
+
+ProtocolDecoder::ProtocolDecoder(const ProtocolCommand* c, uint8_t cc)
+  : commands(c),
+    commandCount(cc),
+    lastSequence(0),
+    handledCount(0),
+    failedSequence(0),
+    failedError(PROTOCOL_OK)
+{
+}
+
+bool ProtocolDecoder::decode(uint8_t* packet, uint8_t packetLength)
+{
+  if (packetLength < 1 || packet[0] != PROTOCOL_VERSION)
+    return false;
+
+  stats.packetCount++;
+
+  int position = 1;
+  while (position < packetLength) {
+    if (position + PROTOCOL_HEADER_LENGTH > packetLength) {
+      //a partial header; nothing more can be trusted in this packet
+      if (failedError == PROTOCOL_OK) {
+        failedSequence = lastSequence;
+        failedError = PROTOCOL_ERROR_TRUNCATED;
+      }
+      stats.errorCount++;
+      break;
+    }
+
+    uint8_t opcode = packet[position];
+    uint8_t payloadLength = packet[position+1];
+    uint8_t sequence = packet[position+2];
+    uint8_t* payload = packet + position + PROTOCOL_HEADER_LENGTH;
+    position += PROTOCOL_HEADER_LENGTH + payloadLength;
+    lastSequence = sequence;
+    stats.frameCount++;
+
+    uint8_t result;
+    if (position > packetLength)
+      result = PROTOCOL_ERROR_TRUNCATED;
+    else if (opcode >= commandCount || commands[opcode].handler == NULL)
+      result = PROTOCOL_ERROR_UNKNOWN_OPCODE;
+    else if (payloadLength < commands[opcode].minLength || payloadLength > commands[opcode].maxLength)
+      result = PROTOCOL_ERROR_LENGTH;
+    else
+      result = commands[opcode].handler(sequence, payload, payloadLength);
+
+    if (result == PROTOCOL_OK) {
+      handledCount++;
+      continue;
+    }
+
+    stats.errorCount++;
+    if (failedError == PROTOCOL_OK) {
+      failedSequence = sequence;
+      failedError = result;
+    }
+    if (result == PROTOCOL_ERROR_TRUNCATED)
+      break;
+  }
+
+  return true;
+}
+
+void ProtocolDecoder::recordParseTime(unsigned long parseMicros)
+{
+  stats.lastParseMicros = parseMicros;
+  if (parseMicros > stats.maxParseMicros)
+    stats.maxParseMicros = parseMicros;
+}
+
+void ProtocolDecoder::getAck(uint8_t* ack)
+{
+  ack[0] = lastSequence;
+  ack[1] = handledCount;
+  ack[2] = failedSequence;
+  ack[3] = failedError;
+
+  //the next acknowledgement only covers the packets that arrive after this one went out
+  handledCount = 0;
+  failedSequence = 0;
+  failedError = PROTOCOL_OK;
+}
+
+bool ProtocolEncoder::addFrame(uint8_t opcode, uint8_t sequence, const uint8_t* payload, uint8_t payloadLength)
+{
+  if (packetLength + PROTOCOL_HEADER_LENGTH + payloadLength > PROTOCOL_PACKET_LENGTH)
+    return false;
+
+  packet[packetLength++] = opcode;
+  packet[packetLength++] = payloadLength;
+  packet[packetLength++] = sequence;
+  if (payloadLength)
+    memcpy(packet+packetLength, payload, payloadLength);
+  packetLength += payloadLength;
+  return true;
+}
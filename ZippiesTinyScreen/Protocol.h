@@ -0,0 +1,121 @@
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Framed command protocol used over every Transport. Every packet starts with the protocol version, followed by
+ * as many frames as will fit...
+ *
+ *   [version 0xF1] [opcode u8][length u8][sequence u8][payload...] [opcode u8][length u8][sequence u8][payload...] ...
+ *
+ * Multi-byte values are little-endian. Packets that do not start with the version byte are handed to the legacy parser, so
+ * older clients that send bare opcodes keep working. This file has no Arduino dependencies so that host tools can use the
+ * same definitions, encoder and decoder as the robot.
+ */
+#define PROTOCOL_VERSION                0xF1
+#define PROTOCOL_PACKET_LENGTH            20
+#define PROTOCOL_HEADER_LENGTH             3
+#define PROTOCOL_MAX_PAYLOAD_LENGTH       (PROTOCOL_PACKET_LENGTH - 1 - PROTOCOL_HEADER_LENGTH)
+
+//client to robot
+#define PROTOCOL_STOP                   0x00  //no payload
+#define PROTOCOL_SET_MOTORS             0x01  //left int32, right int32 (raw PWM)
+#define PROTOCOL_MISSION_APPEND         0x02  //mission records; see MissionQueue.h
+#define PROTOCOL_MISSION_CLEAR          0x03  //no payload
+#define PROTOCOL_BEHAVIOR_WRITE         0x04  //offset uint16, bytecode; see Behavior.h
+#define PROTOCOL_BEHAVIOR_RUN           0x05  //no payload
+#define PROTOCOL_TELEMETRY_SUBSCRIBE    0x06  //pairs of channel u8, rate u8 (Hz, zero unsubscribes); see TelemetryFormat.h
+#define PROTOCOL_SET_VELOCITY           0x07  //linear int16 (mm/s), angular int16 (milliradians/s, clockwise); see UserDriveMode
+#define PROTOCOL_PARAMETERS_READ        0x08  //ids u8, or no payload for all of them; see Parameters.h
+#define PROTOCOL_PARAMETERS_WRITE       0x09  //up to three encoded parameters; see Parameters.h
+#define PROTOCOL_PARAMETERS_COMMIT      0x0A  //no payload; saves the current parameters to flash
+#define PROTOCOL_COMMAND_COUNT            11
+
+//robot to client
+#define PROTOCOL_ACK                    0x80  //last sequence u8, frames handled u8, first failed sequence u8, first error u8; covers
+                                              //every packet received since the previous acknowledgement
+#define PROTOCOL_MISSION_STATUS         0x81  //see MissionQueue::getStatus()
+#define PROTOCOL_PARAMETER_VALUES       0x82  //encoded parameters that the client asked to read
+
+//results of handling a frame
+#define PROTOCOL_OK                        0
+#define PROTOCOL_ERROR_UNKNOWN_OPCODE      1
+#define PROTOCOL_ERROR_LENGTH              2
+#define PROTOCOL_ERROR_TRUNCATED           3
+#define PROTOCOL_ERROR_REJECTED            4
+
+typedef uint8_t (*ProtocolHandler)(uint8_t sequence, uint8_t* payload, uint8_t length);
+
+//one entry for each opcode, indexed by the opcode itself
+typedef struct _ProtocolCommand
+{
+  uint8_t minLength;
+  uint8_t maxLength;
+  ProtocolHandler handler;
+} ProtocolCommand;
+
+typedef struct _ProtocolStats
+{
+  unsigned long packetCount = 0;
+  unsigned long frameCount = 0;
+  unsigned long errorCount = 0;
+  //time spent decoding and handling each packet
+  unsigned long lastParseMicros = 0;
+  unsigned long maxParseMicros = 0;
+} ProtocolStats;
+
+class ProtocolDecoder
+{
+
+private:
+  const ProtocolCommand* commands;
+  uint8_t commandCount;
+  ProtocolStats stats;
+
+  //outcome of the packets received since the last acknowledgement; several packets may be handled before one goes out, and
+  //a failure in any of them must still reach the client
+  uint8_t lastSequence;
+  uint8_t handledCount;
+  uint8_t failedSequence;
+  uint8_t failedError;
+
+public:
+  ProtocolDecoder(const ProtocolCommand* commands, uint8_t commandCount);
+
+  //returns false if the packet is not framed, in which case nothing was handled
+  bool decode(uint8_t* packet, uint8_t packetLength);
+  void recordParseTime(unsigned long parseMicros);
+
+  //payload of an acknowledgement of the packets received since the last one; starts over for the next acknowledgement
+  void getAck(uint8_t* ack);
+  ProtocolStats* getStats() { return &stats; }
+
+};
+
+class ProtocolEncoder
+{
+
+private:
+  uint8_t packet[PROTOCOL_PACKET_LENGTH];
+  uint8_t packetLength;
+
+public:
+  ProtocolEncoder() { clear(); }
+
+  void clear() { packet[0] = PROTOCOL_VERSION; packetLength = 1; }
+  bool isEmpty() { return packetLength == 1; }
+  //the longest payload that still fits in a frame at the end of the packet
+  uint8_t getRemainingPayloadLength()
+  {
+    return packetLength + PROTOCOL_HEADER_LENGTH < PROTOCOL_PACKET_LENGTH ?
+        PROTOCOL_PACKET_LENGTH - packetLength - PROTOCOL_HEADER_LENGTH : 0;
+  }
+  //returns false if the frame does not fit in the remainder of the packet
+  bool addFrame(uint8_t opcode, uint8_t sequence, const uint8_t* payload, uint8_t payloadLength);
+
+  uint8_t* getPacket() { return packet; }
+  uint8_t getPacketLength() { return packetLength; }
+
+};
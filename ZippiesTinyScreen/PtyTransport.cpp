@@ -0,0 +1,92 @@
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "PtyTransport.h"
+
+unsigned long ptyMicros()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (unsigned long)((now.tv_sec * 1000000ULL) + (now.tv_nsec / 1000));
+}
+
+PtyTransport::PtyTransport()
+  : masterDescriptor(-1),
+    connected(false)
+{
+  slaveName[0] = 0;
+}
+
+PtyTransport::~PtyTransport()
+{
+  if (masterDescriptor >= 0)
+    close(masterDescriptor);
+}
+
+bool PtyTransport::start()
+{
+  if (masterDescriptor >= 0)
+    return true;
+
+  masterDescriptor = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+  if (masterDescriptor < 0)
+    return false;
+
+  if (grantpt(masterDescriptor) != 0 || unlockpt(masterDescriptor) != 0 ||
+      ptsname_r(masterDescriptor, slaveName, sizeof(slaveName)) != 0)
+  {
+    close(masterDescriptor);
+    masterDescriptor = -1;
+    return false;
+  }
+
+  //pass every byte through untouched, in both directions
+  struct termios settings;
+  if (tcgetattr(masterDescriptor, &settings) == 0) {
+    cfmakeraw(&settings);
+    tcsetattr(masterDescriptor, TCSANOW, &settings);
+  }
+  return true;
+}
+
+void PtyTransport::loop()
+{
+  if (masterDescriptor < 0)
+    return;
+
+  uint8_t buffer[64];
+  ssize_t readLength = read(masterDescriptor, buffer, sizeof(buffer));
+  if (readLength <= 0) {
+    //Linux reports EIO on the master once the program at the other end has closed it, and EAGAIN while there is nothing to
+    //read, including before anything has opened it at all
+    if (readLength == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+      connected = false;
+    return;
+  }
+
+  connected = true;
+  unsigned long receivedMicros = ptyMicros();
+  for (ssize_t i = 0; i < readLength; i++) {
+    if (decoder.receive(buffer[i]) && decoder.getKind() == SERIAL_FRAME_PROTOCOL)
+      receivedPackets.push(decoder.getPacket(), decoder.getPacketLength(), receivedMicros);
+  }
+}
+
+bool PtyTransport::sendFrame(uint8_t kind, uint8_t* packet, uint8_t length)
+{
+  if (!connected)
+    return false;
+
+  uint8_t encoded[SERIAL_ENCODED_LENGTH];
+  uint8_t encodedLength = encodeSerialFrame(kind, packet, length, encoded);
+  return write(masterDescriptor, encoded, encodedLength) == encodedLength;
+}
+
+#endif
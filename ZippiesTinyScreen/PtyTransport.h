@@ -0,0 +1,45 @@
+
+#pragma once
+
+#if defined(__linux__)
+
+#include "Transport.h"
+#include "SerialFraming.h"
+
+/**
+ * Carries the protocol over a Linux pseudo-terminal, using the same framing as SerialTransport, so that host tools can talk to
+ * the firmware when it is built for the host exactly as they would to a robot on a USB port. A pseudo-terminal has no DTR, and
+ * looks the same before anything opens it as while a program has it open and is quiet, so the link counts as connected from
+ * the first bytes the host sends until it closes its end. ZippiesHost/zippy_pty_test exercises it. Only compiled on Linux;
+ * the Arduino build skips it.
+ */
+class PtyTransport : public Transport
+{
+
+private:
+  int masterDescriptor;
+  char slaveName[64];
+  bool connected;
+  SerialFrameDecoder decoder;
+  PacketQueue receivedPackets;
+
+  bool sendFrame(uint8_t kind, uint8_t* packet, uint8_t length);
+
+public:
+  PtyTransport();
+  ~PtyTransport();
+
+  //creates the pseudo-terminal; host tools open the device named by getSlaveName()
+  bool start();
+  const char* getSlaveName() { return slaveName; }
+
+  void loop();
+  bool isConnected() { return connected; }
+  ReceivedPacket* peekReceivedPacket() { return receivedPackets.peek(); }
+  void releaseReceivedPacket() { receivedPackets.release(); }
+  bool sendResponse(uint8_t* packet, uint8_t length) { return sendFrame(SERIAL_FRAME_PROTOCOL, packet, length); }
+  bool sendTelemetry(uint8_t* packet, uint8_t length) { return sendFrame(SERIAL_FRAME_TELEMETRY, packet, length); }
+
+};
+
+#endif
@@ -0,0 +1,140 @@
+
+#include <Arduino.h>
+#include "Scheduler.h"
+#include "Profiler.h"
+
+extern Profiler profiler;
+
+Scheduler::Scheduler()
+  : taskCount(0)
+{
+}
+
+uint8_t Scheduler::addTask(SchedulerTaskFunction function, void* context, bool event, unsigned long periodMicros,
+                           unsigned long budgetMicros, bool critical, uint8_t profileStage)
+{
+  if (taskCount >= SCHEDULER_MAX_TASKS)
+    return SCHEDULER_NO_TASK;
+
+  SchedulerTask* task = &tasks[taskCount];
+  task->function = function;
+  task->context = context;
+  task->event = event;
+  task->periodMicros = periodMicros;
+  task->budgetMicros = budgetMicros;
+  task->critical = critical;
+  task->profileStage = profileStage;
+  task->signalled = false;
+  task->dueMicros = micros();
+  task->deferred = false;
+  return taskCount++;
+}
+
+uint8_t Scheduler::addPeriodicTask(SchedulerTaskFunction function, void* context, unsigned long periodMicros,
+                                   unsigned long budgetMicros, bool critical, uint8_t profileStage)
+{
+  return addTask(function, context, false, periodMicros, budgetMicros, critical, profileStage);
+}
+
+uint8_t Scheduler::addEventTask(SchedulerTaskFunction function, void* context, unsigned long budgetMicros, bool critical,
+                                uint8_t profileStage)
+{
+  return addTask(function, context, true, 0, budgetMicros, critical, profileStage);
+}
+
+void Scheduler::signal(uint8_t task)
+{
+  if (task >= taskCount)
+    return;
+
+  SchedulerTask* signalledTask = &tasks[task];
+  if (signalledTask->signalled) {
+    signalledTask->stats.missedCount++;
+    return;
+  }
+
+  signalledTask->signalled = true;
+  signalledTask->dueMicros = micros();
+}
+
+bool Scheduler::isReady(SchedulerTask* task, unsigned long currentMicros)
+{
+  if (task->event)
+    return task->signalled;
+
+  //the difference is taken as signed so that the comparison survives micros() wrapping
+  return task->periodMicros == SCHEDULER_EVERY_PASS || (long)(currentMicros - task->dueMicros) >= 0;
+}
+
+void Scheduler::run(SchedulerTask* task, unsigned long startMicros)
+{
+  TaskStats* stats = &task->stats;
+  unsigned long latencyMicros = startMicros - task->dueMicros;
+  if (task->event) {
+    //cleared first, so that the task can signal itself to run again on the next pass
+    task->signalled = false;
+    if (latencyMicros > stats->maxLatencyMicros)
+      stats->maxLatencyMicros = latencyMicros;
+  }
+  else if (task->periodMicros != SCHEDULER_EVERY_PASS) {
+    if (latencyMicros > stats->maxLatencyMicros)
+      stats->maxLatencyMicros = latencyMicros;
+    //keep to the original schedule, unless whole periods have gone by, in which case they are skipped rather than made up
+    task->dueMicros += task->periodMicros;
+    if ((long)(startMicros - task->dueMicros) >= 0) {
+      stats->missedCount += ((startMicros - task->dueMicros) / task->periodMicros) + 1;
+      task->dueMicros = startMicros + task->periodMicros;
+    }
+  }
+
+  task->function(task->context);
+
+  unsigned long runMicros = micros() - startMicros;
+  stats->runCount++;
+  stats->lastMicros = runMicros;
+  if (runMicros > stats->maxMicros)
+    stats->maxMicros = runMicros;
+  if (stats->runCount == 1)
+    stats->averageMicros = runMicros;
+  else
+    stats->averageMicros = ((stats->averageMicros * 15) + runMicros) / 16;
+  if (runMicros > task->budgetMicros)
+    stats->overrunCount++;
+  profiler.record(task->profileStage, runMicros);
+}
+
+void Scheduler::loop()
+{
+  profiler.startPass();
+  unsigned long passStartMicros = micros();
+
+  //one bit for each task that has already had its turn this pass
+  uint16_t doneMask = 0;
+  while (true) {
+    unsigned long currentMicros = micros();
+    SchedulerTask* nextTask = NULL;
+    for (uint8_t i = 0; i < taskCount; i++) {
+      if ((doneMask & (1 << i)) || !isReady(&tasks[i], currentMicros))
+        continue;
+
+      doneMask |= (1 << i);
+      if (!tasks[i].critical && !tasks[i].deferred &&
+          (currentMicros - passStartMicros) + tasks[i].stats.averageMicros > SCHEDULER_PASS_BUDGET_MICROS)
+      {
+        tasks[i].deferred = true;
+        tasks[i].stats.deferredCount++;
+        continue;
+      }
+
+      tasks[i].deferred = false;
+      nextTask = &tasks[i];
+      break;
+    }
+
+    if (nextTask == NULL)
+      break;
+    run(nextTask, currentMicros);
+  }
+
+  profiler.endPass();
+}
@@ -0,0 +1,99 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Runs the work of the sketch as a fixed set of tasks, each of which runs to completion when it is called. Tasks are added
+ * in order of priority, highest first, and a task's number is its priority. On each pass, the highest priority task that is
+ * ready runs, and then the tasks are checked again from the top, so that anything a task makes ready above it runs before the
+ * tasks below it; each task runs at most once a pass. A task is ready...
+ *
+ *   - on every pass, if it is periodic with a period of SCHEDULER_EVERY_PASS
+ *   - once its period has gone by since it was last due, if it is periodic
+ *   - once it has been signalled, if it is an event task
+ *
+ * Nothing can be interrupted once it starts, so the deadlines are kept by keeping the tasks short and by putting the ones that
+ * matter first. Each task has a budget, and a run that takes longer is counted as an overrun. Once a pass has used up
+ * SCHEDULER_PASS_BUDGET_MICROS, a task that usually takes longer than what is left of it waits for the next pass, unless it
+ * is critical; that way, the tasks below the critical ones only fill the slack, while a task is never put off for more than
+ * one pass in a row.
+ */
+//no more than there are bits in the mask of the tasks that have run in a pass
+#define SCHEDULER_MAX_TASKS           16
+//returned when there is no room for another task
+#define SCHEDULER_NO_TASK           0xFF
+#define SCHEDULER_EVERY_PASS           0
+//half the time between poses from the lighthouse
+#define SCHEDULER_PASS_BUDGET_MICROS  4000
+
+typedef void (*SchedulerTaskFunction)(void* context);
+
+typedef struct _TaskStats
+{
+  unsigned long runCount = 0;
+  unsigned long lastMicros = 0;
+  unsigned long maxMicros = 0;
+  //exponential moving average over roughly the last 16 runs
+  unsigned long averageMicros = 0;
+  //runs that took longer than the task's budget
+  unsigned long overrunCount = 0;
+  //passes the task was ready but waited for the next one, to keep the pass within its budget
+  unsigned long deferredCount = 0;
+  //periods that went by without the task running, or signals that arrived while the task was already waiting to run
+  unsigned long missedCount = 0;
+  //the longest the task was ready before it ran
+  unsigned long maxLatencyMicros = 0;
+} TaskStats;
+
+typedef struct _SchedulerTask
+{
+  SchedulerTaskFunction function;
+  void* context;
+  bool event;
+  unsigned long periodMicros;
+  unsigned long budgetMicros;
+  //critical tasks run as soon as they are ready, however much of the pass is left
+  bool critical;
+  //the stage of the loop profile that the task's run times are recorded against; see Profiler.h
+  uint8_t profileStage;
+
+  //when the task next becomes ready; for event tasks, whether it has been signalled and when
+  bool signalled;
+  unsigned long dueMicros;
+  bool deferred;
+  TaskStats stats;
+} SchedulerTask;
+
+class Scheduler
+{
+
+private:
+  SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+  uint8_t taskCount;
+
+  uint8_t addTask(SchedulerTaskFunction function, void* context, bool event, unsigned long periodMicros,
+                  unsigned long budgetMicros, bool critical, uint8_t profileStage);
+  bool isReady(SchedulerTask* task, unsigned long currentMicros);
+  void run(SchedulerTask* task, unsigned long startMicros);
+
+public:
+  Scheduler();
+
+  //each returns the number of the new task, which is also its priority, or SCHEDULER_NO_TASK if there are already
+  //SCHEDULER_MAX_TASKS; tasks must be added highest priority first
+  uint8_t addPeriodicTask(SchedulerTaskFunction function, void* context, unsigned long periodMicros,
+                          unsigned long budgetMicros, bool critical, uint8_t profileStage);
+  uint8_t addEventTask(SchedulerTaskFunction function, void* context, unsigned long budgetMicros, bool critical,
+                       uint8_t profileStage);
+
+  //makes an event task ready to run; called from a task above it, it runs later in the same pass
+  void signal(uint8_t task);
+
+  //runs one pass over the tasks
+  void loop();
+
+  uint8_t getTaskCount() { return taskCount; }
+  TaskStats* getStats(uint8_t task) { return &tasks[task].stats; }
+
+};
@@ -0,0 +1,87 @@
+
+#include "SerialFraming.h"
+
+#define SLIP_END             0xC0
+#define SLIP_ESC             0xDB
+#define SLIP_ESC_END         0xDC
+#define SLIP_ESC_ESC         0xDD
+
+uint8_t encodeSerialByte(uint8_t b, uint8_t* encoded)
+{
+  if (b == SLIP_END) {
+    encoded[0] = SLIP_ESC;
+    encoded[1] = SLIP_ESC_END;
+    return 2;
+  }
+  else if (b == SLIP_ESC) {
+    encoded[0] = SLIP_ESC;
+    encoded[1] = SLIP_ESC_ESC;
+    return 2;
+  }
+
+  encoded[0] = b;
+  return 1;
+}
+
+uint8_t encodeSerialFrame(uint8_t kind, const uint8_t* packet, uint8_t length, uint8_t* encoded)
+{
+  if (length > TRANSPORT_PACKET_LENGTH)
+    length = TRANSPORT_PACKET_LENGTH;
+
+  //a leading end flushes whatever noise the receiver has seen since the last frame
+  uint8_t encodedLength = 0;
+  encoded[encodedLength++] = SLIP_END;
+  encodedLength += encodeSerialByte(kind, encoded+encodedLength);
+  for (uint8_t i = 0; i < length; i++)
+    encodedLength += encodeSerialByte(packet[i], encoded+encodedLength);
+  encoded[encodedLength++] = SLIP_END;
+  return encodedLength;
+}
+
+bool SerialFrameDecoder::receive(uint8_t b)
+{
+  if (complete) {
+    complete = false;
+    frameLength = 0;
+  }
+
+  if (b == SLIP_END) {
+    bool valid = !overflowed && !escaped && frameLength > 1 &&
+                 (frame[0] == SERIAL_FRAME_PROTOCOL || frame[0] == SERIAL_FRAME_TELEMETRY);
+    //back-to-back ends are how frames start, so only count the ones that end something
+    if (!valid && (frameLength || overflowed))
+      errorCount++;
+
+    escaped = false;
+    overflowed = false;
+    if (!valid) {
+      frameLength = 0;
+      return false;
+    }
+
+    complete = true;
+    return true;
+  }
+
+  if (b == SLIP_ESC) {
+    escaped = true;
+    return false;
+  }
+
+  if (escaped) {
+    escaped = false;
+    if (b == SLIP_ESC_END)
+      b = SLIP_END;
+    else if (b == SLIP_ESC_ESC)
+      b = SLIP_ESC;
+    else
+      //not a valid escape; the frame is corrupt, so drop it when it ends
+      overflowed = true;
+  }
+
+  if (frameLength >= SERIAL_FRAME_LENGTH)
+    overflowed = true;
+  else if (!overflowed)
+    frame[frameLength++] = b;
+  return false;
+}
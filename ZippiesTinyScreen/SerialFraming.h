@@ -0,0 +1,54 @@
+
+#pragma once
+
+#include <stdint.h>
+#include "Transport.h"
+
+/**
+ * Framing for transports over a byte stream, such as USB serial or a pseudo-terminal. Each frame is...
+ *
+ *   [kind u8][packet...]
+ *
+ * ...SLIP encoded (RFC 1055): 0xC0 ends a frame, and 0xC0 and 0xDB within it are sent as 0xDB 0xDC and 0xDB 0xDD. A receiver
+ * that joins mid-stream, or sees a corrupt frame, recovers at the next 0xC0. Debug text written to the same stream is
+ * discarded, since it never forms a frame of a known kind.
+ */
+#define SERIAL_FRAME_PROTOCOL        0x01  //protocol packets in either direction, including legacy packets from the client
+#define SERIAL_FRAME_TELEMETRY       0x02  //telemetry packets from the robot
+
+#define SERIAL_FRAME_LENGTH          (1 + TRANSPORT_PACKET_LENGTH)
+//every byte escaped, plus the leading and trailing ends
+#define SERIAL_ENCODED_LENGTH        ((2 * SERIAL_FRAME_LENGTH) + 2)
+
+//encodes a frame into the given buffer, which must hold SERIAL_ENCODED_LENGTH bytes; returns the encoded length
+uint8_t encodeSerialFrame(uint8_t kind, const uint8_t* packet, uint8_t length, uint8_t* encoded);
+
+class SerialFrameDecoder
+{
+
+private:
+  uint8_t frame[SERIAL_FRAME_LENGTH];
+  uint8_t frameLength;
+  bool escaped;
+  bool overflowed;
+  //the frame was handed out on the previous byte, and is discarded on this one
+  bool complete;
+  unsigned long errorCount;
+
+public:
+  SerialFrameDecoder()
+    : frameLength(0),
+      escaped(false),
+      overflowed(false),
+      complete(false),
+      errorCount(0)
+  {}
+
+  //returns true once a complete frame has been received, which remains valid until the next byte is received
+  bool receive(uint8_t b);
+  uint8_t getKind() { return frame[0]; }
+  uint8_t* getPacket() { return frame+1; }
+  uint8_t getPacketLength() { return frameLength-1; }
+  unsigned long getErrorCount() { return errorCount; }
+
+};
@@ -0,0 +1,30 @@
+
+#include "SerialTransport.h"
+
+//the most bytes taken from the port on each pass through the sketch, so that a flood from the host can't stall it
+#define SERIAL_TRANSPORT_READ_BUDGET     128
+
+void SerialTransport::loop()
+{
+  int budget = SERIAL_TRANSPORT_READ_BUDGET;
+  while (budget-- > 0 && SerialUSB.available() > 0) {
+    if (decoder.receive(SerialUSB.read()) && decoder.getKind() == SERIAL_FRAME_PROTOCOL)
+      receivedPackets.push(decoder.getPacket(), decoder.getPacketLength(), micros());
+  }
+}
+
+bool SerialTransport::isConnected()
+{
+  return SerialUSB;
+}
+
+bool SerialTransport::sendFrame(uint8_t kind, uint8_t* packet, uint8_t length)
+{
+  //nobody is listening; don't let writes to a closed port block the sketch
+  if (!isConnected())
+    return false;
+
+  uint8_t encoded[SERIAL_ENCODED_LENGTH];
+  uint8_t encodedLength = encodeSerialFrame(kind, packet, length, encoded);
+  return SerialUSB.write(encoded, encodedLength) == encodedLength;
+}
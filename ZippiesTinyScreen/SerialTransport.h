@@ -0,0 +1,35 @@
+
+#pragma once
+
+#include <Arduino.h>
+#include "Transport.h"
+#include "SerialFraming.h"
+
+/**
+ * Carries the protocol over the native USB port. USB full speed is far faster than the BLE link, so tethered bench runs can
+ * stream every telemetry channel at full rate. The port counts as connected while the host holds DTR, i.e. while a program
+ * on the host has it open.
+ */
+class SerialTransport : public Transport
+{
+
+private:
+  SerialFrameDecoder decoder;
+  PacketQueue receivedPackets;
+
+  bool sendFrame(uint8_t kind, uint8_t* packet, uint8_t length);
+
+public:
+  SerialTransport() {}
+
+  void loop();
+  bool isConnected();
+  ReceivedPacket* peekReceivedPacket() { return receivedPackets.peek(); }
+  void releaseReceivedPacket() { receivedPackets.release(); }
+  bool sendResponse(uint8_t* packet, uint8_t length) { return sendFrame(SERIAL_FRAME_PROTOCOL, packet, length); }
+  bool sendTelemetry(uint8_t* packet, uint8_t length) { return sendFrame(SERIAL_FRAME_TELEMETRY, packet, length); }
+
+  unsigned long getDroppedPacketCount() { return receivedPackets.getDroppedCount(); }
+  unsigned long getFrameErrorCount() { return decoder.getErrorCount(); }
+
+};
@@ -0,0 +1,85 @@
+
+#include <Arduino.h>
+#include <STBLE.h>
+#include "SpiBus.h"
+
+SpiBus::SpiBus()
+  : owner(SPI_CLIENT_NONE),
+    ownedMicros(0),
+    waitingMask(0)
+{
+  for (uint8_t i = 0; i < SPI_CLIENT_COUNT; i++) {
+    waitStartMicros[i] = 0;
+    lastRequestMicros[i] = 0;
+    pollHandlers[i] = NULL;
+    pollContexts[i] = NULL;
+  }
+}
+
+void SpiBus::setPollHandler(uint8_t client, SpiBusPollHandler handler, void* context)
+{
+  pollHandlers[client] = handler;
+  pollContexts[client] = context;
+}
+
+bool SpiBus::isHeldOff(uint8_t client, unsigned long currentMicros)
+{
+  if (owner != SPI_CLIENT_NONE)
+    return true;
+
+  for (uint8_t i = 0; i < client; i++) {
+    if ((waitingMask & (1 << i)) && currentMicros - lastRequestMicros[i] < SPI_BUS_REQUEST_LAPSE_MICROS)
+      return true;
+  }
+  return false;
+}
+
+bool SpiBus::acquire(uint8_t client)
+{
+  unsigned long currentMicros = micros();
+  if (isHeldOff(client, currentMicros)) {
+    if (!(waitingMask & (1 << client))) {
+      waitingMask |= (1 << client);
+      waitStartMicros[client] = currentMicros;
+    }
+    lastRequestMicros[client] = currentMicros;
+    stats[client].deferredCount++;
+    return false;
+  }
+
+  if (waitingMask & (1 << client)) {
+    waitingMask &= ~(1 << client);
+    unsigned long waitMicros = currentMicros - waitStartMicros[client];
+    if (waitMicros > stats[client].maxWaitMicros)
+      stats[client].maxWaitMicros = waitMicros;
+  }
+
+  //the radio's interrupt handler would otherwise talk to the BlueNRG in the middle of someone else's transaction
+  if (client != SPI_CLIENT_RADIO)
+    Disable_SPI_IRQ();
+  owner = client;
+  ownedMicros = currentMicros;
+  return true;
+}
+
+void SpiBus::acquireWaiting(uint8_t client)
+{
+  while (!acquire(client)) {
+    //the bus can only come free if whoever holds it gets the chance to notice that it's done
+    uint8_t currentOwner = owner;
+    if (currentOwner != SPI_CLIENT_NONE && pollHandlers[currentOwner] != NULL)
+      pollHandlers[currentOwner](pollContexts[currentOwner]);
+  }
+}
+
+void SpiBus::release(uint8_t client)
+{
+  if (owner != client)
+    return;
+
+  stats[client].busMicros += micros() - ownedMicros;
+  stats[client].transactionCount++;
+  owner = SPI_CLIENT_NONE;
+  if (client != SPI_CLIENT_RADIO)
+    Enable_SPI_IRQ();
+}
@@ -0,0 +1,71 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Decides who gets the SPI bus that the BlueNRG radio and the display share. Each client takes the bus for one transaction at a
+ * time and gives it back when done; a client that is turned away is remembered as waiting, and until it comes back for the bus,
+ * no client of lower priority is given it. The display sends its frames in bands (see FACE_BAND_LENGTH), each a transaction of
+ * its own, so the radio never waits on more than one band.
+ *
+ * The radio's interrupt handler uses the bus whenever the BlueNRG raises its IRQ line, without asking; it is held off for as
+ * long as any other client holds the bus.
+ */
+
+//clients, in order of priority; the radio comes first, so that display work can never hold up radio traffic for long
+#define SPI_CLIENT_RADIO              0
+#define SPI_CLIENT_DISPLAY            1
+#define SPI_CLIENT_COUNT              2
+#define SPI_CLIENT_NONE            0xFF
+
+//a client that was turned away and hasn't asked again for this long no longer holds off the clients below it
+#define SPI_BUS_REQUEST_LAPSE_MICROS  5000
+
+//called while another client waits for the bus, so that the one holding it can check whether it is done with it
+typedef void (*SpiBusPollHandler)(void* context);
+
+typedef struct _SpiClientStats
+{
+  //time spent holding the bus, and the number of transactions
+  unsigned long busMicros = 0;
+  unsigned long transactionCount = 0;
+  //requests turned away, and the longest any request waited between first being turned away and getting the bus
+  unsigned long deferredCount = 0;
+  unsigned long maxWaitMicros = 0;
+} SpiClientStats;
+
+class SpiBus
+{
+
+private:
+  uint8_t owner;
+  unsigned long ownedMicros;
+  //one bit for each client turned away since it last held the bus, along with when it was first turned away and when it
+  //last asked
+  uint8_t waitingMask;
+  unsigned long waitStartMicros[SPI_CLIENT_COUNT];
+  unsigned long lastRequestMicros[SPI_CLIENT_COUNT];
+
+  SpiBusPollHandler pollHandlers[SPI_CLIENT_COUNT];
+  void* pollContexts[SPI_CLIENT_COUNT];
+  SpiClientStats stats[SPI_CLIENT_COUNT];
+
+  bool isHeldOff(uint8_t client, unsigned long currentMicros);
+
+public:
+  SpiBus();
+
+  void setPollHandler(uint8_t client, SpiBusPollHandler handler, void* context);
+
+  //takes the bus if it is free and no client of higher priority is waiting for it; otherwise, remembers that the client is
+  //waiting and returns false
+  bool acquire(uint8_t client);
+  //for the rare transaction that can't be put off; polls the client holding the bus until it lets go
+  void acquireWaiting(uint8_t client);
+  void release(uint8_t client);
+
+  uint8_t getOwner() { return owner; }
+  SpiClientStats* getStats(uint8_t client) { return &stats[client]; }
+
+};
@@ -0,0 +1,124 @@
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+
+//compile-time helpers for the list of types a StaticVariant may hold
+template<typename... Types>
+struct VariantTypeList;
+
+template<>
+struct VariantTypeList<>
+{
+  static const unsigned int size = 0;
+  static const unsigned int alignment = 1;
+};
+
+template<typename T, typename... Rest>
+struct VariantTypeList<T, Rest...>
+{
+  static const unsigned int size = sizeof(T) > VariantTypeList<Rest...>::size ? sizeof(T) : VariantTypeList<Rest...>::size;
+  static const unsigned int alignment = alignof(T) > VariantTypeList<Rest...>::alignment ? alignof(T) : VariantTypeList<Rest...>::alignment;
+};
+
+//index of type T within a type list
+template<typename T, typename... Types>
+struct VariantTypeIndex;
+
+template<typename T, typename... Rest>
+struct VariantTypeIndex<T, T, Rest...>
+{
+  static const uint8_t value = 0;
+};
+
+template<typename T, typename U, typename... Rest>
+struct VariantTypeIndex<T, U, Rest...>
+{
+  static const uint8_t value = 1 + VariantTypeIndex<T, Rest...>::value;
+};
+
+//walks the type list to invoke a visitor on the type currently being held
+template<typename R, typename... Types>
+struct VariantVisit;
+
+template<typename R>
+struct VariantVisit<R>
+{
+  template<typename Visitor>
+  static R visit(uint8_t, void*, Visitor& visitor) { return visitor(); }
+  static void destroy(uint8_t, void*) {}
+};
+
+template<typename R, typename T, typename... Rest>
+struct VariantVisit<R, T, Rest...>
+{
+  template<typename Visitor>
+  static R visit(uint8_t index, void* storage, Visitor& visitor)
+  {
+    if (index == 0)
+      return visitor(*((T*)storage));
+    return VariantVisit<R, Rest...>::visit(index-1, storage, visitor);
+  }
+
+  static void destroy(uint8_t index, void* storage)
+  {
+    if (index == 0)
+      ((T*)storage)->~T();
+    else
+      VariantVisit<R, Rest...>::destroy(index-1, storage);
+  }
+};
+
+/**
+ * Statically sized tagged union which holds at most one object of any of the listed types. Objects are constructed in place,
+ * so nothing is ever allocated on the heap, and calls are dispatched by switching on the type index rather than through a
+ * vtable. Visitors provide an operator() for each type, plus an operator() with no arguments for when the variant is empty.
+ */
+template<typename... Types>
+class StaticVariant
+{
+
+private:
+  alignas(VariantTypeList<Types...>::alignment) uint8_t storage[VariantTypeList<Types...>::size];
+  uint8_t typeIndex;
+
+  //the held object is only ever constructed in place
+  StaticVariant(const StaticVariant&) = delete;
+  StaticVariant& operator=(const StaticVariant&) = delete;
+
+public:
+  static const uint8_t EMPTY = sizeof...(Types);
+
+  StaticVariant() : typeIndex(EMPTY) {}
+  ~StaticVariant() { clear(); }
+
+  template<typename T, typename... Args>
+  T* emplace(Args... args)
+  {
+    clear();
+    T* object = new (storage) T(args...);
+    typeIndex = VariantTypeIndex<T, Types...>::value;
+    return object;
+  }
+
+  void clear()
+  {
+    VariantVisit<void, Types...>::destroy(typeIndex, storage);
+    typeIndex = EMPTY;
+  }
+
+  bool isEmpty() { return typeIndex == EMPTY; }
+  uint8_t getTypeIndex() { return typeIndex; }
+
+  template<typename T>
+  bool is() { return typeIndex == VariantTypeIndex<T, Types...>::value; }
+
+  template<typename T>
+  T* get() { return is<T>() ? (T*)storage : NULL; }
+
+  template<typename R, typename Visitor>
+  R visit(Visitor& visitor) { return VariantVisit<R, Types...>::visit(typeIndex, storage, visitor); }
+
+};
@@ -0,0 +1,452 @@
+
+#include "Telemetry.h"
+#include "LighthouseSensor.h"
+#include "MotorDriver.h"
+#include "ZippyModes.h"
+#include "Bluetooth.h"
+#include "ZippyFace.h"
+#include "SpiBus.h"
+#include "Profiler.h"
+#include "SerialTransport.h"
+#include "Protocol.h"
+#include "Scheduler.h"
+
+//the lighthouse provides a new pose at 120Hz
+#define TELEMETRY_POSE_RATE                 120
+
+extern Lighthouse lighthouse;
+extern MotorDriver motors;
+extern Bluetooth bluetooth;
+extern SerialTransport serialTransport;
+extern ProtocolDecoder protocolDecoder;
+extern Scheduler scheduler;
+extern ZippyFace face;
+extern SpiBus spiBus;
+extern Profiler profiler;
+extern AutoDriveMode autoDriveMode;
+extern UserDriveMode userDriveMode;
+extern TrackingState trackingState;
+
+Telemetry::Telemetry()
+  : poseDecimation(1),
+    posesSinceSample(0),
+    subscribedCount(0),
+    sequence(0),
+    packetHead(0),
+    packetTail(0),
+    currentPacket(NULL),
+    currentLength(0),
+    currentPacketMicros(0),
+    poseRecord(NULL),
+    previousPoseMicros(0),
+    previousX(0),
+    previousY(0),
+    previousHeading(0),
+    baseStationOffset(0),
+    profileStage(0),
+    schedulerTask(0)
+{
+  memset(channelPeriods, 0, sizeof(channelPeriods));
+  memset(channelSampleTimes, 0, sizeof(channelSampleTimes));
+}
+
+void Telemetry::subscribe(uint8_t channel, uint8_t rate)
+{
+  if (channel == 0 || channel >= TELEMETRY_CHANNEL_COUNT)
+    return;
+
+  if (channelPeriods[channel])
+    subscribedCount--;
+  channelPeriods[channel] = rate ? 1000000UL / rate : 0;
+  if (channelPeriods[channel])
+    subscribedCount++;
+
+  if (channel == TELEMETRY_CHANNEL_POSE && rate)
+    poseDecimation = max(1, TELEMETRY_POSE_RATE / rate);
+  else if (channel == TELEMETRY_CHANNEL_SWEEPS)
+    lighthouse.enableSweepEvents(rate != 0);
+}
+
+void Telemetry::unsubscribeAll()
+{
+  memset(channelPeriods, 0, sizeof(channelPeriods));
+  subscribedCount = 0;
+  lighthouse.enableSweepEvents(false);
+
+  //anything not yet sent is stale by the time streaming resumes
+  currentPacket = NULL;
+  poseRecord = NULL;
+  packetHead = packetTail;
+}
+
+uint8_t* Telemetry::startRecord(uint8_t channel, uint8_t length)
+{
+  if (currentPacket != NULL && currentLength + 1 + length > TELEMETRY_PACKET_LENGTH)
+    finishPacket();
+
+  if (currentPacket == NULL) {
+    if ((uint8_t)(packetTail - packetHead) >= TELEMETRY_QUEUE_SIZE) {
+      stats.droppedRecordCount++;
+      return NULL;
+    }
+
+    currentPacket = packets[packetTail & (TELEMETRY_QUEUE_SIZE-1)];
+    memset(currentPacket, 0, TELEMETRY_PACKET_LENGTH);
+    currentPacket[0] = sequence++;
+    currentLength = 1;
+    currentPacketMicros = micros();
+  }
+
+  uint8_t* record = currentPacket + currentLength + 1;
+  currentPacket[currentLength] = channel;
+  currentLength += 1 + length;
+  poseRecord = NULL;
+  stats.recordCount++;
+  return record;
+}
+
+void Telemetry::finishPacket()
+{
+  if (currentPacket == NULL)
+    return;
+
+  currentPacket = NULL;
+  poseRecord = NULL;
+  packetTail++;
+  stats.packetCount++;
+}
+
+void Telemetry::addPose()
+{
+  KVector2* position = lighthouse.getPosition();
+  unsigned long sampleMicros = lighthouse.getPoseTimeMicros();
+  int16_t sampleX = (int16_t)round(position->getX());
+  int16_t sampleY = (int16_t)round(position->getY());
+  int16_t sampleHeading = (int16_t)round(lighthouse.getOrientation()->getOrientation() * 1000.0d);
+
+  if (poseRecord != NULL && currentLength + TELEMETRY_POSE_DELTA_LENGTH <= TELEMETRY_PACKET_LENGTH) {
+    //deltas are taken from the previous sample as the client will have decoded it, so that rounding never accumulates
+    long deltaTime = (long)(sampleMicros - previousPoseMicros) / TELEMETRY_DELTA_TIME_MICROS;
+    int deltaX = sampleX - previousX;
+    int deltaY = sampleY - previousY;
+    int deltaHeading = (sampleHeading - previousHeading) / TELEMETRY_DELTA_HEADING_MRAD;
+    if (deltaTime >= 0 && deltaTime <= 255 && deltaX >= -128 && deltaX <= 127 && deltaY >= -128 && deltaY <= 127 &&
+        deltaHeading >= -128 && deltaHeading <= 127)
+    {
+      currentPacket[currentLength++] = (uint8_t)deltaTime;
+      currentPacket[currentLength++] = (uint8_t)(int8_t)deltaX;
+      currentPacket[currentLength++] = (uint8_t)(int8_t)deltaY;
+      currentPacket[currentLength++] = (uint8_t)(int8_t)deltaHeading;
+      poseRecord[0]++;
+      stats.recordCount++;
+
+      previousPoseMicros += deltaTime * TELEMETRY_DELTA_TIME_MICROS;
+      previousX = sampleX;
+      previousY = sampleY;
+      previousHeading += deltaHeading * TELEMETRY_DELTA_HEADING_MRAD;
+      return;
+    }
+  }
+
+  //too far from the previous sample to encode as a delta, or no pose record to add it to
+  uint8_t* record = startRecord(TELEMETRY_CHANNEL_POSE, TELEMETRY_POSE_LENGTH);
+  if (record == NULL)
+    return;
+
+  //the low 24 bits of the time, little-endian; they wrap every 16.7s
+  uint32_t timeMicros = sampleMicros;
+  record[0] = 1;
+  memcpy(record+1, &timeMicros, 3);
+  memcpy(record+4, &sampleX, sizeof(int16_t));
+  memcpy(record+6, &sampleY, sizeof(int16_t));
+  memcpy(record+8, &sampleHeading, sizeof(int16_t));
+  poseRecord = record;
+  previousPoseMicros = sampleMicros;
+  previousX = sampleX;
+  previousY = sampleY;
+  previousHeading = sampleHeading;
+}
+
+void writeInt16(uint8_t* record, int position, double value)
+{
+  int16_t intValue = (int16_t)constrain(round(value), -32768.0d, 32767.0d);
+  memcpy(record+position, &intValue, sizeof(int16_t));
+}
+
+void writeUInt16(uint8_t* record, int position, unsigned long value)
+{
+  uint16_t intValue = (uint16_t)min(value, 0xFFFFUL);
+  memcpy(record+position, &intValue, sizeof(uint16_t));
+}
+
+//the low 16 bits of a running total, which the client unwraps by taking the difference between samples
+void writeRunningTotal16(uint8_t* record, int position, unsigned long value)
+{
+  uint16_t intValue = (uint16_t)value;
+  memcpy(record+position, &intValue, sizeof(uint16_t));
+}
+
+void Telemetry::addRecord(uint8_t channel)
+{
+  if (channel == TELEMETRY_CHANNEL_BASE_STATION) {
+    //nothing to send until the lighthouse has finished broadcasting the whole block
+    const uint8_t* infoBlock = lighthouse.getBaseStationInfoBlock();
+    if (infoBlock == NULL)
+      return;
+
+    uint8_t* record = startRecord(channel, TELEMETRY_RECORD_LENGTHS[channel]);
+    if (record == NULL)
+      return;
+    record[0] = baseStationOffset;
+    memcpy(record+1, infoBlock+baseStationOffset, TELEMETRY_BASE_STATION_CHUNK_LENGTH);
+    baseStationOffset += TELEMETRY_BASE_STATION_CHUNK_LENGTH;
+    if (baseStationOffset >= BASE_STATION_INFO_BLOCK_SIZE)
+      baseStationOffset = 0;
+    return;
+  }
+
+  if (channel == TELEMETRY_CHANNEL_PROFILE) {
+    //one stage per record, taking turns, and then what has been dropped along the way
+    uint8_t* record = startRecord(channel, TELEMETRY_RECORD_LENGTHS[channel]);
+    if (record == NULL)
+      return;
+    if (profileStage == PROFILE_STAGE_COUNT) {
+      memset(record, 0, TELEMETRY_RECORD_LENGTHS[channel]);
+      record[0] = TELEMETRY_PROFILE_DROPPED;
+      writeRunningTotal16(record, 1, lighthouse.getDroppedTickCount());
+      writeRunningTotal16(record, 3, lighthouse.getDroppedSweepEventCount());
+      writeRunningTotal16(record, 5, stats.droppedRecordCount);
+      writeRunningTotal16(record, 7, bluetooth.getDroppedPacketCount());
+      writeRunningTotal16(record, 9, serialTransport.getDroppedPacketCount());
+      profileStage = 0;
+      return;
+    }
+
+    StageProfile* profile = profiler.getStage(profileStage);
+    record[0] = profileStage;
+    writeUInt16(record, 1, profile->maxMicros);
+    writeUInt16(record, 3, profiler.getPercentileMicros(profileStage, 99));
+    record[5] = (uint8_t)min(profile->halvingCount, 0xFFUL);
+    unsigned long total = 0;
+    for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++)
+      total += profile->buckets[i];
+    for (uint8_t i = 0; i < PROFILE_BUCKET_COUNT; i++)
+      record[6+i] = total ? (profile->buckets[i] * 255UL) / total : 0;
+    profileStage++;
+    return;
+  }
+
+  if (channel == TELEMETRY_CHANNEL_TASKS) {
+    //one task per record, taking turns
+    if (!scheduler.getTaskCount())
+      return;
+    uint8_t* record = startRecord(channel, TELEMETRY_RECORD_LENGTHS[channel]);
+    if (record == NULL)
+      return;
+    if (schedulerTask >= scheduler.getTaskCount())
+      schedulerTask = 0;
+    TaskStats* task = scheduler.getStats(schedulerTask);
+    record[0] = schedulerTask;
+    writeRunningTotal16(record, 1, task->runCount);
+    writeRunningTotal16(record, 3, task->overrunCount);
+    writeRunningTotal16(record, 5, task->deferredCount);
+    writeRunningTotal16(record, 7, task->missedCount);
+    writeUInt16(record, 9, task->lastMicros);
+    writeUInt16(record, 11, task->averageMicros);
+    writeUInt16(record, 13, task->maxMicros);
+    writeUInt16(record, 15, task->maxLatencyMicros);
+    schedulerTask++;
+    return;
+  }
+
+  if (channel == TELEMETRY_CHANNEL_RAW_TICKS) {
+    //one record for each sensor
+    for (uint8_t i = 0; i < 2; i++) {
+      LighthouseSensor* sensor = i ? lighthouse.getRightSensor() : lighthouse.getLeftSensor();
+      uint8_t* record = startRecord(channel, TELEMETRY_RECORD_LENGTHS[channel]);
+      if (record == NULL)
+        return;
+      uint16_t timeMS = millis();
+      uint32_t xTicks = sensor->getXSweepTickCount();
+      uint32_t yTicks = sensor->getYSweepTickCount();
+      memcpy(record, &timeMS, sizeof(uint16_t));
+      record[2] = i;
+      memcpy(record+3, &xTicks, sizeof(uint32_t));
+      memcpy(record+7, &yTicks, sizeof(uint32_t));
+    }
+    return;
+  }
+
+  uint8_t* record = startRecord(channel, TELEMETRY_RECORD_LENGTHS[channel]);
+  if (record == NULL)
+    return;
+
+  uint16_t timeMS = millis();
+  memcpy(record, &timeMS, sizeof(uint16_t));
+  switch (channel) {
+    case TELEMETRY_CHANNEL_SENSOR_POSITIONS:
+      writeInt16(record, 2, lighthouse.getLeftSensor()->getPosition()->getX());
+      writeInt16(record, 4, lighthouse.getLeftSensor()->getPosition()->getY());
+      writeInt16(record, 6, lighthouse.getRightSensor()->getPosition()->getX());
+      writeInt16(record, 8, lighthouse.getRightSensor()->getPosition()->getY());
+      break;
+
+    case TELEMETRY_CHANNEL_MOTORS:
+      {
+        int32_t left = motors.getLeftPower();
+        int32_t right = motors.getRightPower();
+        memcpy(record+2, &left, sizeof(int32_t));
+        memcpy(record+6, &right, sizeof(int32_t));
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_LOOP_TIMING:
+      {
+        ControlTiming* timing = autoDriveMode.getControlTiming();
+        writeUInt16(record, 2, timing->lastLatencyMicros);
+        writeUInt16(record, 4, timing->maxLatencyMicros);
+        writeUInt16(record, 6, timing->averageStepMicros);
+        writeUInt16(record, 8, timing->latencyOverruns);
+        writeUInt16(record, 10, timing->missedPoseDeadlines);
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_TRACKING:
+      writeInt16(record, 2, trackingState.alongTrackError);
+      writeInt16(record, 4, trackingState.linearIntegral);
+      writeInt16(record, 6, trackingState.linearOutput);
+      writeInt16(record, 8, trackingState.headingError * 1000.0d);
+      writeInt16(record, 10, trackingState.angularIntegral * 1000.0d);
+      writeInt16(record, 12, trackingState.angularOutput * 1000.0d);
+      break;
+
+    case TELEMETRY_CHANNEL_TELEOP:
+      {
+        TeleopStats* teleop = userDriveMode.getTeleopStats();
+        writeUInt16(record, 2, bluetooth.getConnectionInterval());
+        writeUInt16(record, 4, teleop->lastLatencyMicros);
+        writeUInt16(record, 6, teleop->maxLatencyMicros);
+        writeUInt16(record, 8, teleop->commandCount);
+        writeUInt16(record, 10, teleop->deadmanStops);
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_RADIO:
+      {
+        //the client takes the difference between samples to get the share of the loop spent on the radio
+        BluetoothStats* radio = bluetooth.getStats();
+        uint32_t busyMicros = radio->busyMicros;
+        memcpy(record+2, &busyMicros, sizeof(uint32_t));
+        writeUInt16(record, 6, radio->lastLoopMicros);
+        writeUInt16(record, 8, radio->maxLoopMicros);
+        uint16_t idleCount = radio->idleCount;
+        memcpy(record+10, &idleCount, sizeof(uint16_t));
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_DISPLAY:
+      {
+        FaceStats* display = face.getStats();
+        uint16_t transferCount = display->transferCount;
+        memcpy(record+2, &transferCount, sizeof(uint16_t));
+        writeUInt16(record, 4, display->lastTransferMicros);
+        writeUInt16(record, 6, display->lastLoopMicros);
+        uint32_t offloadedMicros = display->offloadedMicros;
+        memcpy(record+8, &offloadedMicros, sizeof(uint32_t));
+        uint32_t pixelCount = display->pixelCount;
+        memcpy(record+12, &pixelCount, sizeof(uint32_t));
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_SPI_BUS:
+      {
+        //as with the radio, the client takes the difference between samples to see how the bus is shared
+        SpiClientStats* radio = spiBus.getStats(SPI_CLIENT_RADIO);
+        SpiClientStats* display = spiBus.getStats(SPI_CLIENT_DISPLAY);
+        uint32_t radioMicros = radio->busMicros;
+        memcpy(record+2, &radioMicros, sizeof(uint32_t));
+        uint32_t displayMicros = display->busMicros;
+        memcpy(record+6, &displayMicros, sizeof(uint32_t));
+        writeUInt16(record, 10, radio->maxWaitMicros);
+        writeUInt16(record, 12, display->maxWaitMicros);
+        uint16_t deferredCount = radio->deferredCount;
+        memcpy(record+14, &deferredCount, sizeof(uint16_t));
+      }
+      break;
+
+    case TELEMETRY_CHANNEL_PROTOCOL:
+      {
+        ProtocolStats* protocol = protocolDecoder.getStats();
+        writeRunningTotal16(record, 2, protocol->packetCount);
+        writeRunningTotal16(record, 4, protocol->frameCount);
+        writeRunningTotal16(record, 6, protocol->errorCount);
+        writeUInt16(record, 8, protocol->lastParseMicros);
+        writeUInt16(record, 10, protocol->maxParseMicros);
+      }
+      break;
+  }
+}
+
+bool Telemetry::hasRoomFor(uint8_t length)
+{
+  if (currentPacket != NULL && currentLength + 1 + length <= TELEMETRY_PACKET_LENGTH)
+    return true;
+
+  //otherwise the current packet, if any, has to be queued and a new one started after it
+  return (uint8_t)(packetTail + (currentPacket != NULL ? 1 : 0) - packetHead) < TELEMETRY_QUEUE_SIZE;
+}
+
+void Telemetry::addSweepEvents()
+{
+  //events stay with the lighthouse until there is room for them, rather than being dropped here
+  SweepEvent* event;
+  while ((event = lighthouse.peekSweepEvent()) != NULL && hasRoomFor(TELEMETRY_RECORD_LENGTHS[TELEMETRY_CHANNEL_SWEEPS])) {
+    uint8_t* record = startRecord(TELEMETRY_CHANNEL_SWEEPS, TELEMETRY_RECORD_LENGTHS[TELEMETRY_CHANNEL_SWEEPS]);
+    uint16_t syncTicks = event->syncTicks;
+    uint32_t sweepTicks = event->sweepTicks;
+    uint16_t hitTime = (uint16_t)(event->hitMicros >> TELEMETRY_SWEEP_TIME_SHIFT);
+    record[0] = (event->sensor << 1) | event->axis;
+    memcpy(record+1, &syncTicks, sizeof(uint16_t));
+    memcpy(record+3, &sweepTicks, 3);
+    memcpy(record+6, &hitTime, sizeof(uint16_t));
+    lighthouse.releaseSweepEvent();
+  }
+}
+
+void Telemetry::loop(bool poseAvailable)
+{
+  if (!subscribedCount)
+    return;
+
+  //the pose follows the lighthouse; recalculating is a no-op if the drive mode has already done so for this pose
+  if (poseAvailable && channelPeriods[TELEMETRY_CHANNEL_POSE] && ++posesSinceSample >= poseDecimation) {
+    posesSinceSample = 0;
+    lighthouse.recalculate();
+    addPose();
+  }
+
+  unsigned long currentMicros = micros();
+  for (uint8_t channel = 1; channel < TELEMETRY_CHANNEL_COUNT; channel++) {
+    if (channel == TELEMETRY_CHANNEL_POSE || channel == TELEMETRY_CHANNEL_SWEEPS || !channelPeriods[channel] ||
+        currentMicros - channelSampleTimes[channel] < channelPeriods[channel])
+    {
+      continue;
+    }
+
+    channelSampleTimes[channel] = currentMicros;
+    addRecord(channel);
+  }
+
+  if (channelPeriods[TELEMETRY_CHANNEL_SWEEPS])
+    addSweepEvents();
+
+  //don't let a partially filled packet hold up low rate channels
+  if (currentPacket != NULL && currentMicros - currentPacketMicros >= TELEMETRY_MAX_PACKET_AGE_MICROS)
+    finishPacket();
+}
+
+void Telemetry::releasePacket()
+{
+  if (packetHead != packetTail)
+    packetHead++;
+}
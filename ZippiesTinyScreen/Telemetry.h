@@ -0,0 +1,88 @@
+
+#pragma once
+
+#include <Arduino.h>
+#include "TelemetryFormat.h"
+
+/**
+ * Streams the telemetry channels that the client has subscribed to, each at its own rate, in the packets described in
+ * TelemetryFormat.h. Completed packets wait in a small queue until the client's link has room for them; if the queue overflows,
+ * new records are dropped, which shows up on the client as a gap in the packet sequence. Sweep events are the exception; they
+ * wait in the lighthouse until there is room for them, so that none are lost to a brief stall in the link.
+ */
+//must be a power of two
+#define TELEMETRY_QUEUE_SIZE                     4
+#define TELEMETRY_MAX_PACKET_AGE_MICROS      20000
+
+typedef struct _TelemetryStats
+{
+  unsigned long recordCount = 0;
+  unsigned long packetCount = 0;
+  unsigned long droppedRecordCount = 0;
+  //times the radio had no room for the next packet
+  unsigned long backpressureCount = 0;
+} TelemetryStats;
+
+class Telemetry
+{
+
+private:
+  //sampling period for each channel, in micros, or zero if the client has not subscribed to it; the pose channel is sampled
+  //on every Nth pose from the lighthouse instead
+  unsigned long channelPeriods[TELEMETRY_CHANNEL_COUNT];
+  unsigned long channelSampleTimes[TELEMETRY_CHANNEL_COUNT];
+  int poseDecimation;
+  int posesSinceSample;
+  uint8_t subscribedCount;
+
+  uint8_t sequence;
+  uint8_t packets[TELEMETRY_QUEUE_SIZE][TELEMETRY_PACKET_LENGTH];
+  uint8_t packetHead;
+  uint8_t packetTail;
+
+  //the packet being filled, which is built in place in the next free slot of the queue
+  uint8_t* currentPacket;
+  uint8_t currentLength;
+  unsigned long currentPacketMicros;
+
+  //the pose record at the end of the current packet, if any, and the last sample in it, as the client will decode it
+  uint8_t* poseRecord;
+  unsigned long previousPoseMicros;
+  int16_t previousX;
+  int16_t previousY;
+  int16_t previousHeading;
+
+  //next offset into the base station info block to send
+  uint8_t baseStationOffset;
+  //next stage of the loop profile, and next of the scheduler's tasks, to send
+  uint8_t profileStage;
+  uint8_t schedulerTask;
+
+  TelemetryStats stats;
+
+  uint8_t* startRecord(uint8_t channel, uint8_t length);
+  void finishPacket();
+  void addPose();
+  void addRecord(uint8_t channel);
+  bool hasRoomFor(uint8_t length);
+  void addSweepEvents();
+
+public:
+  Telemetry();
+
+  //rate in Hz; zero unsubscribes from the channel
+  void subscribe(uint8_t channel, uint8_t rate);
+  void unsubscribeAll();
+  bool isStreaming() { return subscribedCount > 0; }
+
+  //samples whichever channels are due
+  void loop(bool poseAvailable);
+
+  //the oldest packet that is ready to be sent, or NULL; the packet should be released once the radio has accepted it
+  uint8_t* peekPacket() { return packetHead == packetTail ? NULL : packets[packetHead & (TELEMETRY_QUEUE_SIZE-1)]; }
+  void releasePacket();
+  void backpressure() { stats.backpressureCount++; }
+
+  TelemetryStats* getStats() { return &stats; }
+
+};
@@ -0,0 +1,16 @@
+
+#include "TelemetryFormat.h"
+
+const uint8_t TELEMETRY_RECORD_LENGTHS[TELEMETRY_CHANNEL_COUNT] = { 0, 11, 10, TELEMETRY_POSE_LENGTH, 10, 12, 14, 12, 8,
+                                                                    1 + TELEMETRY_BASE_STATION_CHUNK_LENGTH, 12, 16, 16,
+                                                                    6 + TELEMETRY_PROFILE_BUCKET_COUNT, 12, 17 };
+
+uint8_t getTelemetryRecordLength(uint8_t channel, const uint8_t* record)
+{
+  if (channel == 0 || channel >= TELEMETRY_CHANNEL_COUNT)
+    return 0;
+
+  if (channel == TELEMETRY_CHANNEL_POSE)
+    return TELEMETRY_POSE_LENGTH + ((record[0] - 1) * TELEMETRY_POSE_DELTA_LENGTH);
+  return TELEMETRY_RECORD_LENGTHS[channel];
+}
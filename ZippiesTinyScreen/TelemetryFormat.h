@@ -0,0 +1,91 @@
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Layout of the telemetry packets. Records from all channels are packed into shared packets...
+ *
+ *   [sequence u8][channel u8][record...][channel u8][record...]...
+ *
+ * ...each of which is sent once it is full or has been waiting for a short while; a channel of zero marks the end of a packet
+ * that is not full. Multi-byte values are little-endian; times are the low 16 bits of millis() unless noted otherwise. The
+ * records for each channel are...
+ *
+ *   0x01 raw ticks          time u16, sensor u8 (0 is left, 1 is right), X sweep ticks u32, Y sweep ticks u32
+ *   0x02 sensor positions   time u16, left x int16, left y int16, right x int16, right y int16 (mm)
+ *   0x03 pose               count u8, time u24 (micros), x int16 (mm), y int16 (mm), heading int16 (milliradians), followed
+ *                           by count-1 deltas of [time u8 (100us), x int8 (mm), y int8 (mm), heading int8 (10 milliradians)]
+ *                           from the sample before
+ *   0x04 motors             time u16, left int32, right int32 (PWM)
+ *   0x05 loop timing        time u16, last latency u16 (us), max latency u16 (us), average step u16 (us), latency overruns u16,
+ *                           missed pose deadlines u16
+ *   0x06 tracking           time u16, along-track error int16 (mm), linear integral int16 (mm/s), linear output int16 (mm/s),
+ *                           heading error int16 (milliradians), angular integral int16 (milliradians/s), angular output int16
+ *                           (milliradians/s)
+ *   0x07 teleop             time u16, connection interval u16 (1.25ms), last latency u16 (us), max latency u16 (us),
+ *                           commands u16, deadman stops u16
+ *   0x08 sweeps             sensor and axis u8 (bit 1 is the sensor, 0 is right and 1 is left; bit 0 is the axis, 0 is x and 1
+ *                           is y), sync pulse ticks u16, sweep ticks u24, hit time u16 (4us)
+ *   0x09 base station       offset u8, the next TELEMETRY_BASE_STATION_CHUNK_LENGTH bytes of the base station info block
+ *   0x0A radio              time u16, busy time u32 (us, running total), last HCI pass u16 (us), max HCI pass u16 (us),
+ *                           idle passes u16 (running total, wraps)
+ *   0x0B display            time u16, transfers u16 (running total, wraps), last transfer u16 (us), loop time spent on the
+ *                           last transfer u16 (us), loop time saved u32 (us, running total), pixels sent u32 (running total)
+ *   0x0C SPI bus            time u16, radio bus time u32 (us, running total), display bus time u32 (us, running total), radio
+ *                           longest wait u16 (us), display longest wait u16 (us), radio requests turned away u16 (running
+ *                           total, wraps)
+ *   0x0D loop profile       stage u8 (see Profiler.h), longest time u16 (us), 99th percentile u16 (us), times the histogram
+ *                           has been halved u8, followed by the share of the histogram in each of its buckets, u8 each
+ *                           (out of 255); after the last stage comes a record with a stage of TELEMETRY_PROFILE_DROPPED,
+ *                           followed by what the rings along the way have had to drop, all running totals that wrap: edges
+ *                           from the lighthouse sensors u16, sweep events u16, telemetry records u16, packets received over
+ *                           Bluetooth u16, packets received over serial u16, and then zeros to fill the record
+ *   0x0E protocol           time u16, framed packets u16, frames u16, frames that failed u16 (all running totals, wrap),
+ *                           last parse u16 (us), longest parse u16 (us)
+ *   0x0F tasks              task u8 (see Scheduler.h), runs u16, overruns u16, deferrals u16, missed periods u16 (all running
+ *                           totals, wrap), last run u16 (us), average run u16 (us), longest run u16 (us), longest wait to run
+ *                           u16 (us); one task per record, taking turns
+ *
+ * Pose deltas are appended to the pose record at the end of the current packet for as long as they fit; otherwise a new pose
+ * record is started. The pose time is cut to 24 bits so that a packet holds a pose record with two deltas, or three samples;
+ * it wraps every 16.7s. Every sweep hit is sent on the sweeps channel while it is subscribed, regardless of the rate
+ * requested; hit times wrap every 262ms. The client unwraps both against the packet sequence. Like Protocol.h, this file has
+ * no Arduino dependencies so that host tools can decode the same packets.
+ */
+#define TELEMETRY_CHANNEL_RAW_TICKS           0x01
+#define TELEMETRY_CHANNEL_SENSOR_POSITIONS    0x02
+#define TELEMETRY_CHANNEL_POSE                0x03
+#define TELEMETRY_CHANNEL_MOTORS              0x04
+#define TELEMETRY_CHANNEL_LOOP_TIMING         0x05
+#define TELEMETRY_CHANNEL_TRACKING            0x06
+#define TELEMETRY_CHANNEL_TELEOP              0x07
+#define TELEMETRY_CHANNEL_SWEEPS              0x08
+#define TELEMETRY_CHANNEL_BASE_STATION        0x09
+#define TELEMETRY_CHANNEL_RADIO               0x0A
+#define TELEMETRY_CHANNEL_DISPLAY             0x0B
+#define TELEMETRY_CHANNEL_SPI_BUS             0x0C
+#define TELEMETRY_CHANNEL_PROFILE             0x0D
+#define TELEMETRY_CHANNEL_PROTOCOL            0x0E
+#define TELEMETRY_CHANNEL_TASKS               0x0F
+#define TELEMETRY_CHANNEL_COUNT                 16
+
+#define TELEMETRY_PACKET_LENGTH                 20
+
+//resolution of the pose delta time and heading, in micros and milliradians
+#define TELEMETRY_DELTA_TIME_MICROS            100
+#define TELEMETRY_DELTA_HEADING_MRAD            10
+#define TELEMETRY_POSE_LENGTH                   10
+#define TELEMETRY_POSE_DELTA_LENGTH              4
+//resolution of sweep hit times, as a shift of micros
+#define TELEMETRY_SWEEP_TIME_SHIFT               2
+#define TELEMETRY_BASE_STATION_CHUNK_LENGTH     11
+//must match PROFILE_BUCKET_COUNT
+#define TELEMETRY_PROFILE_BUCKET_COUNT          12
+#define TELEMETRY_PROFILE_DROPPED             0xFF
+
+//length of the record for each channel, not including the channel byte; pose records grow as deltas are added
+extern const uint8_t TELEMETRY_RECORD_LENGTHS[TELEMETRY_CHANNEL_COUNT];
+
+//the length of the given record, including any pose deltas, or zero if the channel is unknown
+uint8_t getTelemetryRecordLength(uint8_t channel, const uint8_t* record);
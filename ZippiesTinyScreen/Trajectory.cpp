@@ -0,0 +1,315 @@
+
+#include <math.h>
+#include "Trajectory.h"
+
+//default limits, in mm/s, mm/s^2 and mm/s^2, respectively
+#define TRAJECTORY_DEFAULT_MAX_VELOCITY              150.0f
+#define TRAJECTORY_DEFAULT_MAX_ACCELERATION          150.0f
+#define TRAJECTORY_DEFAULT_MAX_LATERAL_ACCELERATION  100.0f
+
+//the furthest from a waypoint that a blended corner may start; the blend is also limited to half of each adjacent line so
+//that neighboring blends never overlap
+#define TRAJECTORY_BLEND_DISTANCE_MM                 100.0f
+//turns smaller than this are not worth blending
+#define TRAJECTORY_MIN_BLEND_ANGLE                     0.01f
+//turns sharper than this (~160 degrees) would require a uselessly tiny blend radius; instead, the robot comes to a stop at the
+//waypoint and pivots toward the next one
+#define TRAJECTORY_MAX_BLEND_ANGLE                     2.8f
+//waypoints closer than this to the previous waypoint are ignored
+#define TRAJECTORY_MIN_SEGMENT_LENGTH_MM               1.0f
+#define TRAJECTORY_MIN_CURVATURE                       0.000001f
+
+float wrapAngle(float angle)
+{
+  if (angle < -M_PI)
+    angle += 2.0f * M_PI;
+  else if (angle > M_PI)
+    angle -= 2.0f * M_PI;
+  return angle;
+}
+
+Trajectory::Trajectory()
+  : maxVelocity(TRAJECTORY_DEFAULT_MAX_VELOCITY),
+    maxAcceleration(TRAJECTORY_DEFAULT_MAX_ACCELERATION),
+    maxLateralAcceleration(TRAJECTORY_DEFAULT_MAX_LATERAL_ACCELERATION),
+    waypointCount(0),
+    segmentCount(0),
+    currentSegment(0),
+    duration(0.0f)
+{
+  reset(0.0f, 0.0f);
+}
+
+void Trajectory::setLimits(float v, float a, float lateralA)
+{
+  maxVelocity = v;
+  maxAcceleration = a;
+  maxLateralAcceleration = lateralA;
+}
+
+void Trajectory::reset(float startX, float startY)
+{
+  waypoints[0].x = startX;
+  waypoints[0].y = startY;
+  waypointCount = 1;
+  segmentCount = 0;
+  currentSegment = 0;
+  duration = 0.0f;
+}
+
+bool Trajectory::addWaypoint(float x, float y)
+{
+  TrajectoryPoint* previousWaypoint = &waypoints[waypointCount-1];
+  float deltaX = x - previousWaypoint->x;
+  float deltaY = y - previousWaypoint->y;
+  if ((deltaX*deltaX) + (deltaY*deltaY) < TRAJECTORY_MIN_SEGMENT_LENGTH_MM*TRAJECTORY_MIN_SEGMENT_LENGTH_MM)
+    return true;
+
+  if (waypointCount == (TRAJECTORY_MAX_SEGMENTS/2)+1)
+    return false;
+
+  waypoints[waypointCount].x = x;
+  waypoints[waypointCount].y = y;
+  waypointCount++;
+  return true;
+}
+
+void Trajectory::plan()
+{
+  segmentCount = 0;
+  currentSegment = 0;
+  duration = 0.0f;
+
+  //each line starts where the blend of the previous corner ended
+  float lineStartX = waypoints[0].x;
+  float lineStartY = waypoints[0].y;
+  for (int i = 1; i < waypointCount; i++) {
+    TrajectoryPoint* corner = &waypoints[i];
+    if (i == waypointCount-1) {
+      //final line runs all the way to the last waypoint
+      addLine(lineStartX, lineStartY, corner->x, corner->y);
+      break;
+    }
+
+    TrajectoryPoint* previous = &waypoints[i-1];
+    TrajectoryPoint* next = &waypoints[i+1];
+    float inX = corner->x - previous->x;
+    float inY = corner->y - previous->y;
+    float inLength = sqrt((inX*inX) + (inY*inY));
+    float outX = next->x - corner->x;
+    float outY = next->y - corner->y;
+    float outLength = sqrt((outX*outX) + (outY*outY));
+
+    //headings are measured clockwise from the positive y axis, the same as KVector2::getOrientation()
+    float inHeading = atan2(inX, inY);
+    float turnAngle = wrapAngle(atan2(outX, outY) - inHeading);
+    float absoluteTurnAngle = fabs(turnAngle);
+    if (absoluteTurnAngle < TRAJECTORY_MIN_BLEND_ANGLE || absoluteTurnAngle > TRAJECTORY_MAX_BLEND_ANGLE) {
+      //no blend; the velocity planner will bring us to a stop here if the heading changes
+      addLine(lineStartX, lineStartY, corner->x, corner->y);
+      lineStartX = corner->x;
+      lineStartY = corner->y;
+      continue;
+    }
+
+    //replace the corner with a circular arc tangent to both lines
+    float tangentDistance = fminf(TRAJECTORY_BLEND_DISTANCE_MM, fminf(inLength, outLength) / 2.0f);
+    float radius = tangentDistance / tan(absoluteTurnAngle / 2.0f);
+    float blendStartX = corner->x - ((inX * tangentDistance) / inLength);
+    float blendStartY = corner->y - ((inY * tangentDistance) / inLength);
+    addLine(lineStartX, lineStartY, blendStartX, blendStartY);
+    addArc(blendStartX, blendStartY, inHeading, radius, turnAngle);
+
+    lineStartX = corner->x + ((outX * tangentDistance) / outLength);
+    lineStartY = corner->y + ((outY * tangentDistance) / outLength);
+  }
+
+  planVelocities();
+  planTimings();
+}
+
+void Trajectory::planArc(float startHeading, float radius, float turnAngle)
+{
+  segmentCount = 0;
+  currentSegment = 0;
+  duration = 0.0f;
+  waypointCount = 1;
+  if (radius < TRAJECTORY_MIN_SEGMENT_LENGTH_MM || radius * fabs(turnAngle) < TRAJECTORY_MIN_SEGMENT_LENGTH_MM)
+    return;
+
+  addArc(waypoints[0].x, waypoints[0].y, startHeading, radius, turnAngle);
+
+  //the end point is where the arc finishes, so that commands know where to settle
+  TrajectorySegment* segment = &segments[0];
+  float endHeading = startHeading + turnAngle;
+  waypoints[1].x = segment->startX + ((cos(startHeading) - cos(endHeading)) / segment->curvature);
+  waypoints[1].y = segment->startY + ((sin(endHeading) - sin(startHeading)) / segment->curvature);
+  waypointCount = 2;
+
+  planVelocities();
+  planTimings();
+}
+
+void Trajectory::addLine(float fromX, float fromY, float toX, float toY)
+{
+  float deltaX = toX - fromX;
+  float deltaY = toY - fromY;
+  float length = sqrt((deltaX*deltaX) + (deltaY*deltaY));
+  if (length < TRAJECTORY_MIN_SEGMENT_LENGTH_MM || segmentCount == TRAJECTORY_MAX_SEGMENTS)
+    return;
+
+  TrajectorySegment* segment = &segments[segmentCount++];
+  segment->startX = fromX;
+  segment->startY = fromY;
+  segment->startHeading = atan2(deltaX, deltaY);
+  segment->curvature = 0.0f;
+  segment->length = length;
+}
+
+void Trajectory::addArc(float fromX, float fromY, float fromHeading, float radius, float turnAngle)
+{
+  if (segmentCount == TRAJECTORY_MAX_SEGMENTS)
+    return;
+
+  TrajectorySegment* segment = &segments[segmentCount++];
+  segment->startX = fromX;
+  segment->startY = fromY;
+  segment->startHeading = fromHeading;
+  segment->length = radius * fabs(turnAngle);
+  segment->curvature = turnAngle / segment->length;
+}
+
+void Trajectory::planVelocities()
+{
+  //determine the highest velocity allowed within each segment and at each junction between segments
+  for (int i = 0; i < segmentCount; i++) {
+    TrajectorySegment* segment = &segments[i];
+    float absoluteCurvature = fabs(segment->curvature);
+    segment->peakVelocity = maxVelocity;
+    if (absoluteCurvature > TRAJECTORY_MIN_CURVATURE)
+      segment->peakVelocity = fminf(maxVelocity, sqrt(maxLateralAcceleration / absoluteCurvature));
+
+    if (i == 0) {
+      segment->entryVelocity = 0.0f;
+      continue;
+    }
+
+    //if the heading changes abruptly between segments, we must stop at the junction and pivot
+    TrajectorySegment* previousSegment = &segments[i-1];
+    float previousEndHeading = previousSegment->startHeading + (previousSegment->curvature * previousSegment->length);
+    float junctionVelocity = 0.0f;
+    if (fabs(wrapAngle(segment->startHeading - previousEndHeading)) < TRAJECTORY_MIN_BLEND_ANGLE)
+      junctionVelocity = fminf(previousSegment->peakVelocity, segment->peakVelocity);
+    previousSegment->exitVelocity = junctionVelocity;
+    segment->entryVelocity = junctionVelocity;
+  }
+  if (segmentCount)
+    segments[segmentCount-1].exitVelocity = 0.0f;
+
+  //backward pass; make sure every segment can decelerate in time for the next one
+  for (int i = segmentCount-1; i >= 0; i--) {
+    TrajectorySegment* segment = &segments[i];
+    segment->entryVelocity = fminf(segment->entryVelocity,
+        sqrt((segment->exitVelocity*segment->exitVelocity) + (2.0f * maxAcceleration * segment->length)));
+    if (i > 0)
+      segments[i-1].exitVelocity = segment->entryVelocity;
+  }
+
+  //forward pass; make sure every segment can accelerate enough to reach the next one
+  for (int i = 0; i < segmentCount; i++) {
+    TrajectorySegment* segment = &segments[i];
+    segment->exitVelocity = fminf(segment->exitVelocity,
+        sqrt((segment->entryVelocity*segment->entryVelocity) + (2.0f * maxAcceleration * segment->length)));
+    if (i < segmentCount-1)
+      segments[i+1].entryVelocity = segment->exitVelocity;
+  }
+}
+
+void Trajectory::planTimings()
+{
+  float segmentStartTime = 0.0f;
+  for (int i = 0; i < segmentCount; i++) {
+    TrajectorySegment* segment = &segments[i];
+    float entry2 = segment->entryVelocity * segment->entryVelocity;
+    float exit2 = segment->exitVelocity * segment->exitVelocity;
+
+    //the highest velocity we can reach (triangular profile) is limited by the segment length; otherwise we cruise at the
+    //peak velocity allowed within this segment (trapezoidal profile)
+    float peakVelocity = fminf(segment->peakVelocity,
+        sqrt(((2.0f * maxAcceleration * segment->length) + entry2 + exit2) / 2.0f));
+    peakVelocity = fmaxf(peakVelocity, fmaxf(segment->entryVelocity, segment->exitVelocity));
+    segment->peakVelocity = peakVelocity;
+
+    float peak2 = peakVelocity * peakVelocity;
+    float accelerationDistance = (peak2 - entry2) / (2.0f * maxAcceleration);
+    float decelerationDistance = (peak2 - exit2) / (2.0f * maxAcceleration);
+    float cruiseDistance = fmaxf(0.0f, segment->length - accelerationDistance - decelerationDistance);
+
+    segment->accelerationTime = (peakVelocity - segment->entryVelocity) / maxAcceleration;
+    segment->decelerationTime = (peakVelocity - segment->exitVelocity) / maxAcceleration;
+    segment->cruiseTime = peakVelocity > 0.0f ? cruiseDistance / peakVelocity : 0.0f;
+    segment->startTime = segmentStartTime;
+
+    segmentStartTime += segment->accelerationTime + segment->cruiseTime + segment->decelerationTime;
+  }
+  duration = segmentStartTime;
+}
+
+bool Trajectory::evaluate(float seconds, TrajectoryReference* reference)
+{
+  if (!segmentCount) {
+    TrajectoryPoint* endPoint = getEndPoint();
+    reference->x = endPoint->x;
+    reference->y = endPoint->y;
+    reference->velocity = 0.0f;
+    reference->angularVelocity = 0.0f;
+    return false;
+  }
+
+  //the current segment only ever moves forward, unless time is restarted
+  if (seconds < segments[currentSegment].startTime)
+    currentSegment = 0;
+  while (currentSegment < segmentCount-1 && seconds >= segments[currentSegment+1].startTime)
+    currentSegment++;
+
+  TrajectorySegment* segment = &segments[currentSegment];
+  float segmentTime = fmaxf(0.0f, seconds - segment->startTime);
+  float distance;
+  float velocity;
+  if (segmentTime < segment->accelerationTime) {
+    velocity = segment->entryVelocity + (maxAcceleration * segmentTime);
+    distance = (segment->entryVelocity * segmentTime) + (0.5f * maxAcceleration * segmentTime * segmentTime);
+  }
+  else {
+    distance = ((segment->entryVelocity + segment->peakVelocity) / 2.0f) * segment->accelerationTime;
+    segmentTime -= segment->accelerationTime;
+    if (segmentTime < segment->cruiseTime) {
+      velocity = segment->peakVelocity;
+      distance += segment->peakVelocity * segmentTime;
+    }
+    else {
+      distance += segment->peakVelocity * segment->cruiseTime;
+      segmentTime = fminf(segmentTime - segment->cruiseTime, segment->decelerationTime);
+      velocity = segment->peakVelocity - (maxAcceleration * segmentTime);
+      distance += (segment->peakVelocity * segmentTime) - (0.5f * maxAcceleration * segmentTime * segmentTime);
+    }
+  }
+  distance = fminf(distance, segment->length);
+
+  //pose at a distance along a segment of constant curvature; the heading is measured clockwise from the y axis, so the
+  //direction of travel is (sin(heading), cos(heading))
+  float heading = segment->startHeading + (segment->curvature * distance);
+  if (fabs(segment->curvature) < TRAJECTORY_MIN_CURVATURE) {
+    reference->x = segment->startX + (distance * sin(heading));
+    reference->y = segment->startY + (distance * cos(heading));
+  }
+  else {
+    reference->x = segment->startX + ((cos(segment->startHeading) - cos(heading)) / segment->curvature);
+    reference->y = segment->startY + ((sin(heading) - sin(segment->startHeading)) / segment->curvature);
+  }
+  reference->heading = wrapAngle(heading);
+  reference->velocity = velocity;
+  reference->angularVelocity = velocity * segment->curvature;
+
+  return seconds < duration;
+}
@@ -0,0 +1,98 @@
+
+#pragma once
+
+#include <math.h>
+
+//each waypoint adds a line and a blended corner, so this allows for paths of up to 12 waypoints
+#define TRAJECTORY_MAX_SEGMENTS 24
+
+typedef struct _TrajectoryPoint
+{
+  float x;
+  float y;
+} TrajectoryPoint;
+
+//the reference pose and velocities that a command should be tracking at a given moment in time
+typedef struct _TrajectoryReference
+{
+  float x = 0.0f;
+  float y = 0.0f;
+  float heading = 0.0f;
+  //mm/s along the path
+  float velocity = 0.0f;
+  //radians/s; positive is clockwise, matching KVector2::getOrientation()
+  float angularVelocity = 0.0f;
+} TrajectoryReference;
+
+//a segment of constant curvature (zero for lines) along with the trapezoidal velocity profile used to traverse it; segments
+//are stored as floats to keep the table compact
+typedef struct _TrajectorySegment
+{
+  float startX;
+  float startY;
+  float startHeading;
+  float curvature;
+  float length;
+
+  float entryVelocity;
+  float peakVelocity;
+  float exitVelocity;
+
+  float accelerationTime;
+  float cruiseTime;
+  float decelerationTime;
+
+  //seconds from the start of the trajectory until the start of this segment
+  float startTime;
+} TrajectorySegment;
+
+//wraps an angle, in radians, into the range -PI to PI
+float wrapAngle(float angle);
+
+/**
+ * Converts a list of waypoints into a smooth, time-parameterized reference. Corners are blended with circular arcs whose
+ * speed is limited by the maximum lateral acceleration, and each segment is given a trapezoidal velocity profile such that
+ * the robot starts and ends at rest. Evaluating the trajectory is O(1) per control tick, since the segment being evaluated
+ * only ever moves forward as time passes. It has no Arduino dependencies, so that host tools can plan the same trajectories.
+ */
+class Trajectory
+{
+
+private:
+  float maxVelocity;
+  float maxAcceleration;
+  float maxLateralAcceleration;
+
+  TrajectoryPoint waypoints[(TRAJECTORY_MAX_SEGMENTS/2)+1];
+  int waypointCount;
+
+  TrajectorySegment segments[TRAJECTORY_MAX_SEGMENTS];
+  int segmentCount;
+  int currentSegment;
+  float duration;
+
+  void addLine(float fromX, float fromY, float toX, float toY);
+  void addArc(float fromX, float fromY, float fromHeading, float radius, float turnAngle);
+  void planVelocities();
+  void planTimings();
+
+public:
+  Trajectory();
+
+  void setLimits(float maxVelocity, float maxAcceleration, float maxLateralAcceleration);
+  void setMaxVelocity(float v) { maxVelocity = v; }
+
+  void reset(float startX, float startY);
+  bool addWaypoint(float x, float y);
+  void plan();
+  //replaces the waypoints with a single arc from the start point; the turn angle is in radians, positive being clockwise
+  void planArc(float startHeading, float radius, float turnAngle);
+
+  int getSegmentCount() { return segmentCount; }
+  float getDuration() { return duration; }
+  TrajectoryPoint* getEndPoint() { return &waypoints[waypointCount-1]; }
+
+  //returns false once the end of the trajectory has been reached, in which case the reference is left at the final pose
+  bool evaluate(float seconds, TrajectoryReference* reference);
+
+};
@@ -0,0 +1,16 @@
+
+#include "Transport.h"
+
+void PacketQueue::push(const uint8_t* data, uint8_t length, unsigned long receivedMicros)
+{
+  if ((uint8_t)(tail - head) >= TRANSPORT_RECEIVE_QUEUE_SIZE) {
+    droppedCount++;
+    return;
+  }
+
+  ReceivedPacket* packet = &packets[tail & (TRANSPORT_RECEIVE_QUEUE_SIZE-1)];
+  packet->receivedMicros = receivedMicros;
+  packet->length = length < TRANSPORT_PACKET_LENGTH ? length : TRANSPORT_PACKET_LENGTH;
+  memcpy(packet->data, data, packet->length);
+  tail++;
+}
@@ -0,0 +1,72 @@
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "Protocol.h"
+
+/**
+ * A link to a client that carries protocol packets in both directions and telemetry from the robot. The sketch does not care
+ * which link a command arrived on; responses go back over the same link, and telemetry follows the link the client most
+ * recently sent a command on. Like Protocol.h, this file has no Arduino dependencies, so that the host pseudo-terminal
+ * transport can implement the same interface.
+ */
+
+//the longest packet in either direction, and the number of received packets that can be waiting to be processed; the queue
+//size must be a power of two
+#define TRANSPORT_PACKET_LENGTH         PROTOCOL_PACKET_LENGTH
+#define TRANSPORT_RECEIVE_QUEUE_SIZE    8
+
+typedef struct _ReceivedPacket
+{
+  //when the link handed us the packet
+  unsigned long receivedMicros;
+  uint8_t length;
+  uint8_t data[TRANSPORT_PACKET_LENGTH];
+} ReceivedPacket;
+
+//received packets wait here, in place, until the sketch has processed them
+class PacketQueue
+{
+
+private:
+  //both indexes only ever increase and are reduced when the ring is accessed
+  ReceivedPacket packets[TRANSPORT_RECEIVE_QUEUE_SIZE];
+  uint8_t head;
+  uint8_t tail;
+  unsigned long droppedCount;
+
+public:
+  PacketQueue()
+    : head(0),
+      tail(0),
+      droppedCount(0)
+  {}
+
+  //copies the packet into the next free slot, unless the sketch has fallen so far behind that there are none
+  void push(const uint8_t* data, uint8_t length, unsigned long receivedMicros);
+  //the oldest packet waiting to be processed, or NULL if there are none
+  ReceivedPacket* peek() { return head == tail ? NULL : &packets[head & (TRANSPORT_RECEIVE_QUEUE_SIZE-1)]; }
+  void release() { if (head != tail) head++; }
+  void clear() { head = tail; }
+  unsigned long getDroppedCount() { return droppedCount; }
+
+};
+
+class Transport
+{
+
+public:
+  //services the link; called on every pass through the sketch
+  virtual void loop() = 0;
+  virtual bool isConnected() = 0;
+
+  //the oldest packet waiting to be processed, or NULL; the packet remains valid, in place, until it is released
+  virtual ReceivedPacket* peekReceivedPacket() = 0;
+  virtual void releaseReceivedPacket() = 0;
+
+  //both return false if the link has no room for the packet right now, in which case it can be retried later
+  virtual bool sendResponse(uint8_t* packet, uint8_t length) = 0;
+  virtual bool sendTelemetry(uint8_t* packet, uint8_t length) = 0;
+
+};
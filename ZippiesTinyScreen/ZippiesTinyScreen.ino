@@ -6,23 +6,64 @@
 #include "MotorDriver.h"
 #include "ZippyFace.h"
 #include "Bluetooth.h"
+#include "SerialTransport.h"
+#include "Telemetry.h"
 #include "ZippyModes.h"
 #include "LighthouseSensor.h"
 #include "KVector.h"
+#include "Protocol.h"
+#include "Parameters.h"
+#include "KeyValueStore.h"
+#include "NvmFlashDevice.h"
+#include "SpiBus.h"
+#include "Battery.h"
+#include "Profiler.h"
+#include "Scheduler.h"
 
 #define BLE_RECEIVE_MOTORS_ALL_STOP  0x00
 #define BLE_RECEIVE_MOTORS_SET       0x15
 #define BLE_RECEIVE_FORWARD_STRAIGHT 0x16
 #define BLE_SEND_DEBUG_INFO          0x00
 #define BLE_SEND_INTERVAL_MS        1000
-
+//rows of flash set aside for the settings store
+#define SETTINGS_ROW_COUNT            16
+
+NVM_RESERVE_ROWS(settingsRows, SETTINGS_ROW_COUNT);
+NvmFlashDevice settingsFlash(settingsRows, SETTINGS_ROW_COUNT);
+KeyValueStore settings(&settingsFlash);
+//the base station info block is saved once per run, the first time it is received, if it differs from the one saved already
+bool baseStationInfoSaved = false;
+Parameters parameters;
+//the radio and the display take turns on the SPI bus
+SpiBus spiBus;
 ZippyFace face;
 Lighthouse lighthouse;
 Bluetooth bluetooth;
-unsigned long bluetoothSendDebugInfoTmeStamp = 0;
+SerialTransport serialTransport;
 MotorDriver motors;
+//sampled in the background from setup() on; the motors and the face both read it
+Battery battery;
+//times each of the scheduler's tasks, and every pass through loop()
+Profiler profiler;
+Scheduler scheduler;
+Telemetry telemetry;
+AutoDriveMode autoDriveMode;
+UserDriveMode userDriveMode;
 ZippyMode* currentMode = NULL;
 
+//commands are accepted from every transport; responses and telemetry go to whichever one the client most recently sent a
+//framed command on
+Transport* const TRANSPORTS[] = { &bluetooth, &serialTransport };
+#define TRANSPORT_COUNT (sizeof(TRANSPORTS) / sizeof(Transport*))
+Transport* clientTransport = &bluetooth;
+//when the radio handed us the packet currently being processed
+unsigned long receivedPacketMicros = 0;
+//set as the tasks that produce them run, and cleared by the tasks that consume them, which may only run on a later pass
+bool framedPacketReceived = false;
+bool telemetryPoseAvailable = false;
+//the task signalled by each new pose from the lighthouse
+uint8_t controlTask = 0;
+
 /*
 #define HMC5883_I2CADDR     0x1E
 int16_t CompassX;
@@ -96,137 +137,433 @@ void extractSensorPacket(LighthouseSensor* sensor, uint8_t* debugPacket)
     memcpy(debugPacket+packetPosition, &nextFloatValue, sizeof(float));
 }
 
-void setup()
+uint8_t handleStop(uint8_t sequence, uint8_t* payload, uint8_t length)
 {
-  Wire.begin();
-  SerialUSB.begin(115200);
-//  while (!SerialUSB);
-//  SerialUSB.println( "Serial port enabled");
+  motors.setMotors(0, 0);
+  return PROTOCOL_OK;
+}
 
-  bluetooth.start();
-//  SerialUSB.println("Bluetooth enabled");
+uint8_t handleSetMotors(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  int32_t motorLeft;
+  int32_t motorRight;
+  memcpy(&motorLeft, payload, sizeof(int32_t));
+  memcpy(&motorRight, payload+4, sizeof(int32_t));
+  motors.setMotors(motorLeft, motorRight);
+  return PROTOCOL_OK;
+}
 
-  lighthouse.start();
-//  SerialUSB.println("Lighthouse enabled");
+uint8_t handleSetVelocity(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  //remote control takes over from whatever mission was running
+  if (currentMode != &userDriveMode) {
+    autoDriveMode.clearMission();
+    currentMode = &userDriveMode;
+  }
 
-  motors.start();
-//  SerialUSB.println("Motors enabled");
+  int16_t linearVelocity;
+  int16_t angularVelocity;
+  memcpy(&linearVelocity, payload, sizeof(int16_t));
+  memcpy(&angularVelocity, payload+2, sizeof(int16_t));
+  userDriveMode.setVelocity(linearVelocity, ((double)angularVelocity) / 1000.0d, receivedPacketMicros);
+  return PROTOCOL_OK;
+}
 
-  face.start();
-//  SerialUSB.println("Face enabled");
+//a new mission or program hands control back to the lighthouse once it is available
+void endUserDrive()
+{
+  if (currentMode == &userDriveMode) {
+    userDriveMode.stop();
+    currentMode = NULL;
+  }
+}
 
-//  initCompass();
-  motors.setMotors(0.0d, 0.0d);
+uint8_t handleMissionAppend(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  endUserDrive();
+  return autoDriveMode.getMission()->receive(sequence, payload, length) ? PROTOCOL_OK : PROTOCOL_ERROR_REJECTED;
 }
 
-void loop()
+uint8_t handleMissionClear(uint8_t sequence, uint8_t* payload, uint8_t length)
 {
-//  /*
-  //first process the Lighthouse input
-  lighthouse.loop();
+  autoDriveMode.clearMission();
+  return PROTOCOL_OK;
+}
 
-  static bool bluetoothWasConnected = false;
+uint8_t handleBehaviorWrite(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  uint16_t programOffset;
+  memcpy(&programOffset, payload, sizeof(uint16_t));
+  endUserDrive();
+  autoDriveMode.clearMission();
+  return autoDriveMode.getBehavior()->write(programOffset, payload+2, length-2) ? PROTOCOL_OK : PROTOCOL_ERROR_REJECTED;
+}
 
-  //now process all the inbound Bluetooth commands
-  uint8_t receivedDataLength = bluetooth.loop();
-  while (receivedDataLength) {
-//  SerialUSB.print("Got packet of length: ");
-//  SerialUSB.println(bluetoothReceiveLength);
-    uint8_t* receivedData = bluetooth.getReceivedData();
-    for (int i = 0; i < receivedDataLength; i++) {
-      switch (receivedData[i]) {
-        case BLE_RECEIVE_FORWARD_STRAIGHT:
-          break;
-          
-        case BLE_RECEIVE_MOTORS_SET:
-//          SerialUSB.println("Motors set.");
-          //this command has a payload that should be 8 bytes (two signed floats)
-          if (receivedDataLength-i >= 8) {
-            i++;
-            float motorLeft;
-            memcpy(&motorLeft, receivedData+i, 4);
-            i += 4;
-            float motorRight;
-            memcpy(&motorRight, receivedData+i, 4);
-            i += 3;
-            
-            motors.setMotors(motorLeft, motorRight);
-          }
-          break;
+uint8_t handleBehaviorRun(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  endUserDrive();
+  autoDriveMode.clearMission();
+  autoDriveMode.getBehavior()->run();
+  return PROTOCOL_OK;
+}
+
+uint8_t handleTelemetrySubscribe(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  //pairs of channel and rate
+  if (length & 1)
+    return PROTOCOL_ERROR_LENGTH;
+
+  for (uint8_t i = 0; i < length; i += 2)
+    telemetry.subscribe(payload[i], payload[i+1]);
+  return PROTOCOL_OK;
+}
+
+uint8_t handleParametersRead(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  //the values go out with the following responses
+  if (length == 0) {
+    parameters.requestReadAll();
+    return PROTOCOL_OK;
+  }
+
+  for (uint8_t i = 0; i < length; i++) {
+    if (!parameters.requestRead(payload[i]))
+      return PROTOCOL_ERROR_REJECTED;
+  }
+  return PROTOCOL_OK;
+}
+
+uint8_t handleParametersWrite(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  if (length % PARAMETER_ENCODED_LENGTH)
+    return PROTOCOL_ERROR_LENGTH;
+
+  //nothing in the frame is staged unless all of it is valid
+  for (uint8_t i = 0; i < length; i += PARAMETER_ENCODED_LENGTH) {
+    if (!parameters.isValid(payload+i))
+      return PROTOCOL_ERROR_REJECTED;
+  }
+  for (uint8_t i = 0; i < length; i += PARAMETER_ENCODED_LENGTH)
+    parameters.stage(payload+i);
+  return PROTOCOL_OK;
+}
+
+uint8_t handleParametersCommit(uint8_t sequence, uint8_t* payload, uint8_t length)
+{
+  return parameters.commit() ? PROTOCOL_OK : PROTOCOL_ERROR_REJECTED;
+}
+
+//indexed by opcode; minimum and maximum payload lengths are checked before the handler is called
+const ProtocolCommand PROTOCOL_COMMANDS[PROTOCOL_COMMAND_COUNT] = {
+  { 0, 0, handleStop },                                      //PROTOCOL_STOP
+  { 8, 8, handleSetMotors },                                 //PROTOCOL_SET_MOTORS
+  { 0, PROTOCOL_MAX_PAYLOAD_LENGTH, handleMissionAppend },   //PROTOCOL_MISSION_APPEND
+  { 0, 0, handleMissionClear },                              //PROTOCOL_MISSION_CLEAR
+  { 2, PROTOCOL_MAX_PAYLOAD_LENGTH, handleBehaviorWrite },   //PROTOCOL_BEHAVIOR_WRITE
+  { 0, 0, handleBehaviorRun },                               //PROTOCOL_BEHAVIOR_RUN
+  { 2, PROTOCOL_MAX_PAYLOAD_LENGTH, handleTelemetrySubscribe }, //PROTOCOL_TELEMETRY_SUBSCRIBE
+  { 4, 4, handleSetVelocity },                               //PROTOCOL_SET_VELOCITY
+  { 0, PROTOCOL_MAX_PAYLOAD_LENGTH, handleParametersRead },  //PROTOCOL_PARAMETERS_READ
+  { PARAMETER_ENCODED_LENGTH, 3 * PARAMETER_ENCODED_LENGTH, handleParametersWrite }, //PROTOCOL_PARAMETERS_WRITE
+  { 0, 0, handleParametersCommit },                          //PROTOCOL_PARAMETERS_COMMIT
+};
+
+ProtocolDecoder protocolDecoder(PROTOCOL_COMMANDS, PROTOCOL_COMMAND_COUNT);
+
+//packets from clients that predate the framed protocol are a series of bare opcodes
+void processLegacyPacket(uint8_t* receivedData, uint8_t receivedDataLength)
+{
+  for (int i = 0; i < receivedDataLength; i++) {
+    switch (receivedData[i]) {
+      case BLE_RECEIVE_FORWARD_STRAIGHT:
+        break;
+        
+      case BLE_RECEIVE_MOTORS_SET:
+//        SerialUSB.println("Motors set.");
+        //this command has a payload that should be 8 bytes (two signed floats)
+        if (receivedDataLength-i >= 9) {
+          float motorLeft;
+          memcpy(&motorLeft, receivedData+i+1, sizeof(float));
+          float motorRight;
+          memcpy(&motorRight, receivedData+i+5, sizeof(float));
+          i += 8;
           
-        case BLE_RECEIVE_MOTORS_ALL_STOP:
-//          SerialUSB.println("Motors all stop.");
-          motors.setMotors(0, 0);
-          break;
-      }
+          motors.setMotors(motorLeft, motorRight);
+        }
+        break;
+        
+      case BLE_RECEIVE_MOTORS_ALL_STOP:
+//        SerialUSB.println("Motors all stop.");
+        motors.setMotors(0, 0);
+        break;
     }
-  
-    //until we've emptied out the bluetooth queue
-    receivedDataLength = bluetooth.loop();
   }
+}
+
+//processes all the packets waiting on the given transport; each packet is parsed in place in its receive queue and then
+//released; returns true if any of them were framed, and so need to be acknowledged
+bool processTransport(Transport* transport)
+{
+  transport->loop();
+  bool framedPacketReceived = false;
+  ReceivedPacket* receivedPacket = transport->peekReceivedPacket();
+  while (receivedPacket != NULL) {
+//  SerialUSB.print("Got packet of length: ");
+//  SerialUSB.println(receivedPacket->length);
+    receivedPacketMicros = receivedPacket->receivedMicros;
+    unsigned long parseStartMicros = micros();
+    if (protocolDecoder.decode(receivedPacket->data, receivedPacket->length)) {
+      protocolDecoder.recordParseTime(micros() - parseStartMicros);
+      framedPacketReceived = true;
+    }
+    else
+      processLegacyPacket(receivedPacket->data, receivedPacket->length);
   
+    //until we've emptied out the queue
+    transport->releaseReceivedPacket();
+    receivedPacket = transport->peekReceivedPacket();
+  }
+  return framedPacketReceived;
+}
+
+void runLighthouse(void* context)
+{
+  //parameters written by the client take effect here, between control steps
+  if (parameters.apply() & (PARAMETER_BIT(PARAMETER_LIGHTHOUSE_HEIGHT) | PARAMETER_BIT(PARAMETER_DIODE_HEIGHT)))
+    lighthouse.recalculateGeometry();
+
+  //new poses are handed to the drive mode immediately to keep the time from sensing to actuation as short as possible
+  if (lighthouse.loop()) {
+    telemetryPoseAvailable = true;
+    scheduler.signal(controlTask);
+  }
+}
+
+void runControl(void* context)
+{
+  if (currentMode != NULL)
+    currentMode->poseAvailable();
+}
+
+void runTransports(void* context)
+{
+  for (uint8_t i = 0; i < TRANSPORT_COUNT; i++) {
+    if (processTransport(TRANSPORTS[i])) {
+      clientTransport = TRANSPORTS[i];
+      framedPacketReceived = true;
+    }
+  }
+
+  static bool clientWasConnected = false;
+  bool clientIsConnected = clientTransport->isConnected();
+  if (clientWasConnected && !clientIsConnected) {
+    endUserDrive();
+    motors.setMotors(0, 0);
+    telemetry.unsubscribeAll();
+  }
+  clientWasConnected = clientIsConnected;
+}
+
+void runMode(void* context)
+{
   static bool lighthouseWasConnected = false;
   //now process our current drive mode; watch for "do nothing" mode
-  if (currentMode != NULL)  
+  if (currentMode != NULL)
     currentMode->loop();
   else if (!lighthouseWasConnected && lighthouse.hasLighthouseSignal()) {
 //    SerialUSB.println("Lighthouse connected. Starting auto-drive mode.");
-    currentMode = new AutoDriveMode();
+    currentMode = &autoDriveMode;
   }
+}
 
-  //now process the motors and the face
+void runMotors(void* context)
+{
   motors.loop();
+}
+
+void runResponse(void* context)
+{
+  //acknowledge the commands we just processed, and let the client know as soon as the mission has room for more segments;
+  //both go out together in a single response, followed by as many of the parameters the client asked for as will fit
+  if (clientTransport->isConnected() &&
+      (framedPacketReceived || autoDriveMode.getMission()->hasStatusChanged() || parameters.hasReadsPending()))
+  {
+    ProtocolEncoder response;
+    bool statusChanged = autoDriveMode.getMission()->hasStatusChanged();
+    if (framedPacketReceived) {
+      uint8_t ack[4];
+      protocolDecoder.getAck(ack);
+      response.addFrame(PROTOCOL_ACK, 0, ack, sizeof(ack));
+    }
+    if (statusChanged) {
+      uint8_t missionStatus[MISSION_STATUS_LENGTH];
+      autoDriveMode.getMission()->getStatus(missionStatus);
+      response.addFrame(PROTOCOL_MISSION_STATUS, 0, missionStatus, sizeof(missionStatus));
+    }
+    uint8_t parameterValues[PROTOCOL_MAX_PAYLOAD_LENGTH];
+    uint32_t sentParameters = 0;
+    uint8_t parameterValuesLength = parameters.encodeReads(parameterValues, response.getRemainingPayloadLength(), &sentParameters);
+    if (parameterValuesLength)
+      response.addFrame(PROTOCOL_PARAMETER_VALUES, 0, parameterValues, parameterValuesLength);
+
+    //the rest of the parameters go out on the following passes, as do the status and any parameters that the link failed to
+    //take this time
+    if (clientTransport->sendResponse(response.getPacket(), response.getPacketLength())) {
+      if (statusChanged)
+        autoDriveMode.getMission()->completeStatus();
+      parameters.completeReads(sentParameters);
+    }
+  }
+  framedPacketReceived = false;
+}
+
+void runTelemetry(void* context)
+{
+  //sampled only after the drive mode has acted on the pose
+  telemetry.loop(telemetryPoseAvailable);
+  telemetryPoseAvailable = false;
+}
+
+void runSend(void* context)
+{
+  //send as many telemetry packets as the link will take
+  bool clientIsConnected = clientTransport->isConnected();
+  uint8_t* telemetryPacket = telemetry.peekPacket();
+  while (clientIsConnected && telemetryPacket != NULL) {
+    if (!clientTransport->sendTelemetry(telemetryPacket, TELEMETRY_PACKET_LENGTH)) {
+      telemetry.backpressure();
+      break;
+    }
+    telemetry.releasePacket();
+    telemetryPacket = telemetry.peekPacket();
+  }
+}
+
+void runFace(void* context)
+{
   face.loop();
+}
 
-  bool bluetoothIsConnected = bluetooth.isConnected();
-  if (bluetoothWasConnected && !bluetoothIsConnected) {
-    motors.setMotors(0, 0);
+void runFaceChanges(void* context)
+{
+  face.markChanges();
+}
+
+void runSettings(void* context)
+{
+  if (!baseStationInfoSaved && lighthouse.getBaseStationInfoCount()) {
+    uint8_t savedBlock[BASE_STATION_INFO_BLOCK_SIZE];
+    const uint8_t* receivedBlock = lighthouse.getBaseStationInfoBlock();
+    if (settings.get(KV_KEY_BASE_STATION, savedBlock, sizeof(savedBlock)) != BASE_STATION_INFO_BLOCK_SIZE ||
+        memcmp(savedBlock, receivedBlock, BASE_STATION_INFO_BLOCK_SIZE))
+    {
+      baseStationInfoSaved = settings.put(KV_KEY_BASE_STATION, receivedBlock, BASE_STATION_INFO_BLOCK_SIZE);
+    }
+    else
+      baseStationInfoSaved = true;
   }
-  bluetoothWasConnected = bluetoothIsConnected;
 
-//  /*
-  //check to see if we need to send debug info over Bluetooth
-  static uint8_t testValue = 0;
+  //settings are written to flash a page at a time, so that no single pass stalls for longer than one row erase
+  settings.loop();
+}
+
+void runDebugInfo(void* context)
+{
+  //send debug info over Bluetooth; not while streaming, since the indications would hold up the stream
+  if (!bluetooth.isConnected() || telemetry.isStreaming())
+    return;
+
+//  lighthouse.recalculate();
+
+  //the time since the last packets went out, for the rotational velocity
+  static unsigned long previousTime = 0;
   unsigned long currentTime = millis();
-  if (bluetooth.isConnected() && currentTime-bluetoothSendDebugInfoTmeStamp > BLE_SEND_INTERVAL_MS) {
-//    lighthouse.recalculate();
-    
-    float deltaTimeSeconds = ((float)(currentTime - bluetoothSendDebugInfoTmeStamp)) / 1000.0f;
-    //send the sync tick count, sweep tick count, X and Y of each diode sensor
-    uint8_t debugPacket[SENSOR_DATA_LENGTH];
-
-    //left sensor data
-    LighthouseSensor* sensorLeft = lighthouse.getLeftSensor();
-    extractSensorPacket(sensorLeft, debugPacket);
-    bluetooth.sendSensor1(debugPacket);
-
-    //right sensor data
-    LighthouseSensor* sensorRight = lighthouse.getRightSensor();
-    extractSensorPacket(sensorRight, debugPacket);
-    bluetooth.sendSensor0(debugPacket);
-
-    //computed data
-    static float previousOrientation = 0.0f;
-
-    KVector2* currentPosition = lighthouse.getPosition();
-    
-    float floatValue = currentPosition->getX();
-    memcpy(debugPacket, &floatValue, sizeof(float));
-    floatValue = currentPosition->getY();
-    memcpy(debugPacket+4, &floatValue, sizeof(float));
-    floatValue = (sensorLeft->getVelocity() + sensorRight->getVelocity()) / 2.0f;
-    memcpy(debugPacket+8, &floatValue, sizeof(float));
-
-    float orientation = lighthouse.getOrientation()->getOrientation();
-    memcpy(debugPacket+12, &orientation, sizeof(float));
-    float rotationalVelocityRadians = (orientation - previousOrientation) / deltaTimeSeconds;
-    memcpy(debugPacket+16, &rotationalVelocityRadians, sizeof(float));
-    previousOrientation = orientation;
-    bluetooth.sendComputedData(debugPacket);
-
-    bluetoothSendDebugInfoTmeStamp = currentTime;
-  }
-//  */
+  float deltaTimeSeconds = ((float)(currentTime - previousTime)) / 1000.0f;
+  previousTime = currentTime;
+  //send the sync tick count, sweep tick count, X and Y of each diode sensor
+  uint8_t debugPacket[SENSOR_DATA_LENGTH];
+
+  //left sensor data
+  LighthouseSensor* sensorLeft = lighthouse.getLeftSensor();
+  extractSensorPacket(sensorLeft, debugPacket);
+  bluetooth.sendSensor1(debugPacket);
+
+  //right sensor data
+  LighthouseSensor* sensorRight = lighthouse.getRightSensor();
+  extractSensorPacket(sensorRight, debugPacket);
+  bluetooth.sendSensor0(debugPacket);
+
+  //computed data
+  static float previousOrientation = 0.0f;
+
+  KVector2* currentPosition = lighthouse.getPosition();
+  
+  float floatValue = currentPosition->getX();
+  memcpy(debugPacket, &floatValue, sizeof(float));
+  floatValue = currentPosition->getY();
+  memcpy(debugPacket+4, &floatValue, sizeof(float));
+  floatValue = (sensorLeft->getVelocity() + sensorRight->getVelocity()) / 2.0f;
+  memcpy(debugPacket+8, &floatValue, sizeof(float));
+
+  float orientation = lighthouse.getOrientation()->getOrientation();
+  memcpy(debugPacket+12, &orientation, sizeof(float));
+  float rotationalVelocityRadians = (orientation - previousOrientation) / deltaTimeSeconds;
+  memcpy(debugPacket+16, &rotationalVelocityRadians, sizeof(float));
+  previousOrientation = orientation;
+  bluetooth.sendComputedData(debugPacket);
 }
 
+void setup()
+{
+  Wire.begin();
+  SerialUSB.begin(115200);
+
+  //before anything that uses them starts up
+  settings.begin();
+  parameters.load();
+//  while (!SerialUSB);
+//  SerialUSB.println( "Serial port enabled");
+
+  bluetooth.start();
+//  SerialUSB.println("Bluetooth enabled");
+
+  lighthouse.start();
+  //positions are available as soon as the sweeps are, rather than after the lighthouse has sent its calibration again
+  uint8_t baseStationInfoBlock[BASE_STATION_INFO_BLOCK_SIZE];
+  if (settings.get(KV_KEY_BASE_STATION, baseStationInfoBlock, sizeof(baseStationInfoBlock)) == BASE_STATION_INFO_BLOCK_SIZE)
+    lighthouse.restoreBaseStationInfo(baseStationInfoBlock);
+//  SerialUSB.println("Lighthouse enabled");
+
+  battery.start();
+  motors.start();
+//  SerialUSB.println("Motors enabled");
+
+  face.start();
+//  SerialUSB.println("Face enabled");
+
+//  initCompass();
+  motors.setMotors(0.0d, 0.0d);
 
+  //in order of priority; the lighthouse and the control steps it triggers always come first, and are critical so that they
+  //are never put off to the next pass; the display and the telemetry fill the slack; budgets are in micros
+  scheduler.addPeriodicTask(runLighthouse, NULL, SCHEDULER_EVERY_PASS, 1000, true, PROFILE_STAGE_LIGHTHOUSE);
+  controlTask = scheduler.addEventTask(runControl, NULL, 2500, true, PROFILE_STAGE_CONTROL);
+  //remote control commands reach the motors without waiting on anything but the lighthouse
+  scheduler.addPeriodicTask(runTransports, NULL, SCHEDULER_EVERY_PASS, 2000, false, PROFILE_STAGE_TRANSPORTS);
+  scheduler.addPeriodicTask(runMode, NULL, SCHEDULER_EVERY_PASS, 500, false, PROFILE_STAGE_MODE);
+  scheduler.addPeriodicTask(runMotors, NULL, SCHEDULER_EVERY_PASS, 500, false, PROFILE_STAGE_MOTORS);
+  scheduler.addPeriodicTask(runResponse, NULL, SCHEDULER_EVERY_PASS, 2000, false, PROFILE_STAGE_RESPONSE);
+  scheduler.addPeriodicTask(runTelemetry, NULL, SCHEDULER_EVERY_PASS, 1000, false, PROFILE_STAGE_TELEMETRY);
+  scheduler.addPeriodicTask(runSend, NULL, SCHEDULER_EVERY_PASS, 1500, false, PROFILE_STAGE_SEND);
+  scheduler.addPeriodicTask(runFace, NULL, SCHEDULER_EVERY_PASS, 1500, false, PROFILE_STAGE_FACE);
+  scheduler.addPeriodicTask(runFaceChanges, NULL, FACE_CHANGES_INTERVAL_MS * 1000UL, 1000, false,
+                            PROFILE_STAGE_FACE_CHANGES);
+  //a single row erase takes several milliseconds
+  scheduler.addPeriodicTask(runSettings, NULL, SCHEDULER_EVERY_PASS, 10000, false, PROFILE_STAGE_SETTINGS);
+  scheduler.addPeriodicTask(runDebugInfo, NULL, BLE_SEND_INTERVAL_MS * 1000UL, 5000, false, PROFILE_STAGE_DEBUG_INFO);
+}
+
+void loop()
+{
+  scheduler.loop();
+}
@@ -2,22 +2,26 @@
 #include "ZippyCommand.h"
 #include "LighthouseSensor.h"
 #include "MotorDriver.h"
-
-//the minimum PCM value below which the motors do not turn
-#define MOTOR_MIN_POWER                      4600.00d
-#define LINEAR_VELOCITY_POWER                5000.00d
-#define LOOK_AHEAD_DISTANCE                   100.00d
+#include "Parameters.h"
 
 //the radius squared (to prevent the need for an additional square root) when we are can consider the robot to be "at the target"
 //currently set to 5cm, since sqrt(2500mm)/(10mm per cm) = 5cm
 #define AUTODRIVE_POSITION_EPSILON_2         2500.0d
 
-#define AUTODRIVE_LINEAR_Kp               1200.0d
-#define AUTODRIVE_LINEAR_Ki                100.0d
-#define AUTODRIVE_LINEAR_Kd                200.0d
+//how long to wait after the end of a trajectory for the robot to reach the final position
+#define AUTODRIVE_SETTLE_TIMEOUT_MS          1000
+
+//how closely, in radians, the robot must face the target heading to complete a rotation (~3 degrees), and how long to try
+#define AUTODRIVE_HEADING_EPSILON            0.05f
+#define AUTODRIVE_ROTATE_TIMEOUT_MS          5000
 
 extern Lighthouse lighthouse;
 extern MotorDriver motors;
+extern Parameters parameters;
+
+//only one command executes at a time, so they all share the same trajectory
+Trajectory trajectory;
+TrackingState trackingState;
 
 Pause::Pause(double seconds)
   : deltaTimeMS(seconds * 1000.0d),
@@ -36,114 +40,263 @@ bool Pause::loop()
   return (millis() - startTimeMS) >= deltaTimeMS;
 }
 
-double padInner(double motorPower, double magnitude)
+//the gains are parameters, which the client can tune even while a command is running
+void applyLinearTunings(LinearPid* pid)
 {
-  if (motorPower > 0.0d)
-    return magnitude + motorPower;
-  else if (motorPower < 0.0d)
-    return -magnitude + motorPower;
+  pid->setTunings(Fixed16(parameters.get(PARAMETER_LINEAR_KP)), Fixed16(parameters.get(PARAMETER_LINEAR_KI)),
+                  Fixed16(parameters.get(PARAMETER_LINEAR_KD)));
+}
 
-  return 0.0d;
+void applyAngularTunings(AngularPid* pid)
+{
+  pid->setTunings(Fixed16(parameters.get(PARAMETER_ANGULAR_KP)), Fixed16(parameters.get(PARAMETER_ANGULAR_KI)),
+                  Fixed16(parameters.get(PARAMETER_ANGULAR_KD)));
 }
 
-MoveTowardPoint::MoveTowardPoint(double x, double y)
-  : currentTargetPosition(x, y),
-    leftPID(&leftInput, &leftOutput, &leftSetPoint, AUTODRIVE_LINEAR_Kp, AUTODRIVE_LINEAR_Ki, AUTODRIVE_LINEAR_Kd, DIRECT),
-    rightPID(&rightInput, &rightOutput, &rightSetPoint, AUTODRIVE_LINEAR_Kp, AUTODRIVE_LINEAR_Ki, AUTODRIVE_LINEAR_Kd, DIRECT)
+TrajectoryCommand::TrajectoryCommand()
+  : startTimeMicros(0),
+    previousStepMicros(0),
+    tuningsGeneration(0),
+    reverse(false)
+{
+}
+
+double TrajectoryCommand::getTravelHeading()
+{
+  double heading = lighthouse.getPredictedOrientation()->getOrientation();
+  return reverse ? wrapAngle(heading + M_PI) : heading;
+}
+
+void TrajectoryCommand::updateInputs(TrajectoryReference* reference)
+{
+  //vector from the center of the robot to the reference position, projected onto the robot's forward and right directions; we
+  //use the pose predicted for when the motors will actually act on our output. When backing up, forward is the direction of
+  //travel, which turns the same way as the robot does, so only the sign of the linear velocity differs
+  KVector2* robotCenterPosition = lighthouse.getPredictedPosition();
+  double heading = getTravelHeading();
+  double deltaX = reference->x - robotCenterPosition->getX();
+  double deltaY = reference->y - robotCenterPosition->getY();
+  double alongTrackError = (deltaX * sin(heading)) + (deltaY * cos(heading));
+  double crossTrackError = (deltaX * cos(heading)) - (deltaY * sin(heading));
+
+  //steer toward a point on the reference path that is a fixed distance ahead of us, in addition to matching the reference heading
+  double headingError = wrapAngle(reference->heading - heading);
+
+  trackingState.alongTrackError = alongTrackError;
+  trackingState.headingError = headingError;
+
+  //the PIDs drive their measurements toward zero, so the measurements are the negated errors
+  linearInput = -alongTrackError;
+  angularInput = -(headingError + atan2(crossTrackError, parameters.get(PARAMETER_LOOK_AHEAD_DISTANCE)));
+}
+
+Trajectory* TrajectoryCommand::startTrajectory(float maxVelocity, bool r)
 {
-  leftPID.SetOutputLimits(-LINEAR_VELOCITY_POWER, LINEAR_VELOCITY_POWER);
-  rightPID.SetOutputLimits(-LINEAR_VELOCITY_POWER, LINEAR_VELOCITY_POWER);
+  reverse = r;
+  trajectory.setMaxVelocity(maxVelocity);
+  trajectory.reset(lighthouse.getPosition()->getX(), lighthouse.getPosition()->getY());
+  return &trajectory;
 }
 
-void MoveTowardPoint::updateInputs()
+void TrajectoryCommand::startTracking()
 {
-  //calculate a delta vector that is a hardwired distance from the center of the robot to the target position
-  KVector2* robotCenterPosition = lighthouse.getPosition();
-  KVector2 nextPosition(currentTargetPosition.getX() - robotCenterPosition->getX(),
-                        currentTargetPosition.getY() - robotCenterPosition->getY(),
-                        LOOK_AHEAD_DISTANCE);
-  nextPosition.set(robotCenterPosition->getX() + nextPosition.getX(),
-                   robotCenterPosition->getY() + nextPosition.getY());
+  startTimeMicros = micros();
+  previousStepMicros = startTimeMicros;
+
+  TrajectoryReference reference;
+  trajectory.evaluate(0.0f, &reference);
+
+  updateInputs(&reference);
+  tuningsGeneration = parameters.getGeneration();
+  applyLinearTunings(&linearPID);
+  applyAngularTunings(&angularPID);
+  linearPID.reset(linearInput, 0.0f);
+  angularPID.reset(angularInput, 0.0f);
+}
 
-  //calculate the left input
-  LighthouseSensor* sensor = lighthouse.getLeftSensor();
-  KVector2* sensorPosition = sensor->getPosition();
-  
-  //vector from center of robot to this sensor
-  KVector2 sensorPositionFromCenter(sensorPosition->getX() - robotCenterPosition->getX(),
-                                    sensorPosition->getY() - robotCenterPosition->getY(),
-                                    1.0d);
+bool TrajectoryCommand::loop()
+{
+  if (tuningsGeneration != parameters.getGeneration()) {
+    tuningsGeneration = parameters.getGeneration();
+    applyLinearTunings(&linearPID);
+    applyAngularTunings(&angularPID);
+  }
 
-  //vector from sensor offset to target position
-  KVector2 deltaSensorToTarget(nextPosition.getX() - sensorPosition->getX(),
-                               nextPosition.getY() - sensorPosition->getY(),
-                               1.0d);
+  //evaluate the reference at the same time as the predicted pose
+  unsigned long stepMicros = lighthouse.getPredictedTimeMicros();
+  long elapsedTimeMicros = (long)(stepMicros - startTimeMicros);
+  if (elapsedTimeMicros < 0)
+    elapsedTimeMicros = 0;
+  unsigned long elapsedTimeMS = elapsedTimeMicros / 1000;
+  TrajectoryReference reference;
+  if (!trajectory.evaluate(((float)elapsedTimeMicros) / 1000000.0f, &reference)) {
+    //the reference has reached the end of the trajectory; wait for the robot to settle onto it, but not forever
+    KVector2* currentPosition = lighthouse.getPredictedPosition();
+    TrajectoryPoint* endPoint = trajectory.getEndPoint();
+    KVector2 deltaCenterToTarget(endPoint->x - currentPosition->getX(),
+                                 endPoint->y - currentPosition->getY());
+    if (deltaCenterToTarget.getD2() < AUTODRIVE_POSITION_EPSILON_2 ||
+        elapsedTimeMS > (unsigned long)(trajectory.getDuration() * 1000.0f) + AUTODRIVE_SETTLE_TIMEOUT_MS)
+    {
+      motors.setMotors(0, 0);
+      return true;
+    }
+  }
 
-  //input is the angle from our sensor vector to the target position
-  leftInput = cos(sensorPositionFromCenter.angleToVector(&deltaSensorToTarget));
+  updateInputs(&reference);
 
-  //calculate the right input
-  sensor = lighthouse.getRightSensor();
-  sensorPosition = sensor->getPosition();
+  //the PIDs integrate over the actual time between the poses of consecutive control steps
+  long deltaMicros = (long)(stepMicros - previousStepMicros);
+  previousStepMicros = stepMicros;
+  Fixed16 deltaSeconds(deltaMicros > 0 ? ((float)deltaMicros) / 1000000.0f : 0.0f);
+  double linearOutput = linearPID.update(0.0f, linearInput, deltaSeconds).toFloat();
+  double angularOutput = angularPID.update(0.0f, angularInput, deltaSeconds).toFloat();
+  trackingState.linearIntegral = linearPID.getIntegral().toFloat();
+  trackingState.linearOutput = linearOutput;
+  trackingState.angularIntegral = angularPID.getIntegral().toFloat();
+  trackingState.angularOutput = angularOutput;
 
-  //vector from center of robot to this sensor
-  sensorPositionFromCenter.set(sensorPosition->getX() - robotCenterPosition->getX(),
-                               sensorPosition->getY() - robotCenterPosition->getY(),
-                               1.0d);
+  //feed forward the reference velocities and correct with the PID outputs; slow down while we are facing away from the path
+  double linearVelocity = (reference.velocity * cos(reference.heading - getTravelHeading())) + linearOutput;
+  double angularVelocity = reference.angularVelocity + angularOutput;
+  motors.setVelocity(reverse ? -linearVelocity : linearVelocity, angularVelocity);
 
-  //vector from sensor to target position
-  deltaSensorToTarget.set(nextPosition.getX() - sensorPosition->getX(),
-                          nextPosition.getY() - sensorPosition->getY(),
-                          1.0d);
+  return false;
+}
 
-  //input is the angle from our sensor vector to the target position
-  rightInput = cos(sensorPositionFromCenter.angleToVector(&deltaSensorToTarget));
+MoveTowardPoint::MoveTowardPoint(double x, double y)
+{
+  targetPosition.x = x;
+  targetPosition.y = y;
 }
 
 void MoveTowardPoint::start()
 {
-  leftPID.SetMode(MANUAL);
-  rightPID.SetMode(MANUAL);
+  Trajectory* trajectory = startTrajectory(AUTODRIVE_MAX_VELOCITY);
+  trajectory->addWaypoint(targetPosition.x, targetPosition.y);
+  trajectory->plan();
+  startTracking();
+}
 
-  updateInputs();
+FollowPath::FollowPath(const TrajectoryPoint* w, int wc, float v)
+  : waypoints(w),
+    waypointCount(wc),
+    maxVelocity(v)
+{
+}
 
-  leftPID.SetMode(AUTOMATIC);
-  rightPID.SetMode(AUTOMATIC);
+void FollowPath::start()
+{
+  Trajectory* trajectory = startTrajectory(maxVelocity);
+  for (int i = 0; i < waypointCount; i++) {
+    if (!trajectory->addWaypoint(waypoints[i].x, waypoints[i].y))
+      break;
+  }
+  trajectory->plan();
+  startTracking();
+}
+
+DriveDistance::DriveDistance(double d)
+  : distance(d)
+{
+}
+
+void DriveDistance::start()
+{
+  //straight along the current heading; a negative distance puts the end point behind us, and we back up to it rather than
+  //turning around
+  KVector2* position = lighthouse.getPosition();
+  double heading = lighthouse.getOrientation()->getOrientation();
+  Trajectory* trajectory = startTrajectory(AUTODRIVE_MAX_VELOCITY, distance < 0.0d);
+  trajectory->addWaypoint(position->getX() + (distance * sin(heading)), position->getY() + (distance * cos(heading)));
+  trajectory->plan();
+  startTracking();
+}
+
+DriveArc::DriveArc(double r, double a)
+  : radius(r),
+    angle(a)
+{
+}
+
+void DriveArc::start()
+{
+  //the arc leaves tangent to the current heading
+  Trajectory* trajectory = startTrajectory(AUTODRIVE_MAX_VELOCITY);
+  trajectory->planArc(lighthouse.getOrientation()->getOrientation(), radius, angle);
+  startTracking();
+}
+
+RotateToHeading::RotateToHeading(float heading)
+  : targetHeading(heading),
+    startTimeMS(0),
+    previousStepMicros(0),
+    tuningsGeneration(0)
+{
 }
 
-bool MoveTowardPoint::loop()
+void RotateToHeading::start()
 {
-  KVector2* currentPosition = lighthouse.getPosition();
-  KVector2 deltaCenterToTarget(currentTargetPosition.getX() - currentPosition->getX(),
-                               currentTargetPosition.getY() - currentPosition->getY());
-  if (deltaCenterToTarget.getD2() < AUTODRIVE_POSITION_EPSILON_2) {
-    leftPID.SetMode(MANUAL);
-    rightPID.SetMode(MANUAL);
+  startTimeMS = millis();
+  previousStepMicros = micros();
+  tuningsGeneration = parameters.getGeneration();
+  applyAngularTunings(&angularPID);
+  angularPID.reset(-wrapAngle(targetHeading - lighthouse.getOrientation()->getOrientation()), 0.0f);
+}
+
+bool RotateToHeading::loop()
+{
+  if (tuningsGeneration != parameters.getGeneration()) {
+    tuningsGeneration = parameters.getGeneration();
+    applyAngularTunings(&angularPID);
+  }
+
+  unsigned long stepMicros = lighthouse.getPredictedTimeMicros();
+  float headingError = wrapAngle(targetHeading - lighthouse.getPredictedOrientation()->getOrientation());
+  if (fabs(headingError) < AUTODRIVE_HEADING_EPSILON || millis() - startTimeMS > AUTODRIVE_ROTATE_TIMEOUT_MS) {
+    motors.setMotors(0, 0);
     return true;
   }
 
-  updateInputs();
+  long deltaMicros = (long)(stepMicros - previousStepMicros);
+  previousStepMicros = stepMicros;
+  Fixed16 deltaSeconds(deltaMicros > 0 ? ((float)deltaMicros) / 1000000.0f : 0.0f);
+  float angularOutput = angularPID.update(0.0f, -headingError, deltaSeconds).toFloat();
+  motors.setVelocity(0.0d, angularOutput);
 
-  leftPID.Compute();
-  rightPID.Compute();
+  trackingState.alongTrackError = 0.0f;
+  trackingState.linearIntegral = 0.0f;
+  trackingState.linearOutput = 0.0f;
+  trackingState.headingError = headingError;
+  trackingState.angularIntegral = angularPID.getIntegral().toFloat();
+  trackingState.angularOutput = angularOutput;
 
-  //our base velocity is just a proportional represented by cosine of the angle from our current orientation to the target
-  KVector2* currentOrientation = lighthouse.getOrientation();
-  double baseVelocity = LINEAR_VELOCITY_POWER * cos(currentOrientation->angleToVector(&deltaCenterToTarget));
-  motors.setMotors(padInner(baseVelocity + leftOutput, MOTOR_MIN_POWER),
-                   padInner(baseVelocity + rightOutput, MOTOR_MIN_POWER));
+  return false;
+}
 
-  /*
-  SerialUSB.print("Orientation: ");
-  SerialUSB.print(lighthouse.getOrientation()->getOrientation(), 3);
-  SerialUSB.print(", Direction: ");
-  SerialUSB.print(currentOrientation->angleToVector(&deltaToTarget), 3);
-  SerialUSB.print(", Left: ");
-  SerialUSB.print(leftInput, 3);
-  SerialUSB.print(", Right: ");
-  SerialUSB.println(rightInput, 3);
-  */
+//visitors which forward to whichever command the variant holds; an empty command completes immediately
+struct StartCommand
+{
+  template<typename T>
+  void operator()(T& command) { command.start(); }
+  void operator()() {}
+};
 
-  return false;
+struct LoopCommand
+{
+  template<typename T>
+  bool operator()(T& command) { return command.loop(); }
+  bool operator()() { return true; }
+};
+
+void ZippyCommand::start()
+{
+  StartCommand visitor;
+  visit<void>(visitor);
 }
 
+bool ZippyCommand::loop()
+{
+  LoopCommand visitor;
+  return visit<bool>(visitor);
+}
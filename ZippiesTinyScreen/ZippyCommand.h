@@ -1,19 +1,35 @@
 
 #pragma once
 
-#include <PID_v1.h>
+#include <Arduino.h>
 #include "KVector.h"
+#include "Trajectory.h"
+#include "FixedPoint.h"
+#include "Pid.h"
+#include "StaticVariant.h"
 
-class ZippyCommand
-{
+#define AUTODRIVE_MAX_VELOCITY              150.0f
+#define AUTODRIVE_MAX_ANGULAR_VELOCITY        4.0f
 
-public:
-  virtual void start() = 0;
-  virtual bool loop() = 0;
+//along-track error (mm) to linear velocity (mm/s)
+#define AUTODRIVE_LINEAR_Kp                  2.0f
+#define AUTODRIVE_LINEAR_Ki                  0.2f
+#define AUTODRIVE_LINEAR_Kd                  0.1f
 
-};
+//heading error (radians) to angular velocity (radians/s)
+#define AUTODRIVE_ANGULAR_Kp                 3.0f
+#define AUTODRIVE_ANGULAR_Ki                 0.3f
+#define AUTODRIVE_ANGULAR_Kd                 0.1f
+
+//the distance ahead along the reference path that we steer toward to correct cross-track error; the default for
+//PARAMETER_LOOK_AHEAD_DISTANCE, as the gains above are for the gain parameters
+#define LOOK_AHEAD_DISTANCE                   100.00d
+
+//back-calculation gain, and the time constant (seconds) of the derivative filter, for both controllers
+#define AUTODRIVE_ANTI_WINDUP_GAIN           1.0f
+#define AUTODRIVE_DERIVATIVE_FILTER_TIME     0.05f
 
-class Pause : public ZippyCommand
+class Pause
 {
 
 private:
@@ -27,54 +43,164 @@ public:
   
 };
 
-class MoveTowardPoint : public ZippyCommand
+struct LinearPidConfig
+{
+  static constexpr float Kp = AUTODRIVE_LINEAR_Kp;
+  static constexpr float Ki = AUTODRIVE_LINEAR_Ki;
+  static constexpr float Kd = AUTODRIVE_LINEAR_Kd;
+  static constexpr float OutputMin = -AUTODRIVE_MAX_VELOCITY;
+  static constexpr float OutputMax = AUTODRIVE_MAX_VELOCITY;
+  static constexpr float AntiWindupGain = AUTODRIVE_ANTI_WINDUP_GAIN;
+  static constexpr float DerivativeTimeConstant = AUTODRIVE_DERIVATIVE_FILTER_TIME;
+};
+
+struct AngularPidConfig
+{
+  static constexpr float Kp = AUTODRIVE_ANGULAR_Kp;
+  static constexpr float Ki = AUTODRIVE_ANGULAR_Ki;
+  static constexpr float Kd = AUTODRIVE_ANGULAR_Kd;
+  static constexpr float OutputMin = -AUTODRIVE_MAX_ANGULAR_VELOCITY;
+  static constexpr float OutputMax = AUTODRIVE_MAX_ANGULAR_VELOCITY;
+  static constexpr float AntiWindupGain = AUTODRIVE_ANTI_WINDUP_GAIN;
+  static constexpr float DerivativeTimeConstant = AUTODRIVE_DERIVATIVE_FILTER_TIME;
+};
+
+//heading errors are small enough that ki*error*dt rounds away in Q16.16 below a few milliradians, so the angular integral is
+//kept in Q8.24, which easily holds the output range
+typedef Pid<Fixed16, LinearPidConfig> LinearPid;
+typedef Pid<Fixed16, AngularPidConfig, Fixed24> AngularPid;
+
+//the most recent inputs and outputs of whichever controllers are running, for telemetry
+typedef struct _TrackingState
+{
+  float alongTrackError = 0.0f;
+  float linearIntegral = 0.0f;
+  float linearOutput = 0.0f;
+  float headingError = 0.0f;
+  float angularIntegral = 0.0f;
+  float angularOutput = 0.0f;
+} TrackingState;
+
+//base class for commands that drive the robot along a time-parameterized trajectory by tracking its reference pose; subclasses
+//plan the trajectory returned by startTrajectory() and then call startTracking() from their own start()
+class TrajectoryCommand
 {
 
 private:
-  KVector2 currentTargetPosition;
+  unsigned long startTimeMicros;
+  unsigned long previousStepMicros;
+  //the generation of the parameters that the PID gains were last taken from
+  uint8_t tuningsGeneration;
+  //whether the robot backs along the trajectory, in which case its rear is the direction of travel
+  bool reverse;
 
-  double leftSetPoint = 0.0d;
-  double leftInput = 0.0d;
-  double leftOutput = 0.0d;
-  PID leftPID;
+  //along-track error, in mm; the PIDs take floats, so the inputs are kept as floats
+  float linearInput = 0.0f;
+  LinearPid linearPID;
+
+  //combined heading and cross-track error, in radians
+  float angularInput = 0.0f;
+  AngularPid angularPID;
+
+  double getTravelHeading();
+  void updateInputs(TrajectoryReference* reference);
+
+protected:
+  Trajectory* startTrajectory(float maxVelocity, bool reverse = false);
+  void startTracking();
+
+public:
+  TrajectoryCommand();
+  bool loop();
+
+};
+
+class MoveTowardPoint : public TrajectoryCommand
+{
+
+private:
+  //floats are all the trajectory plans in; a KVector2 made this the largest command, and so set the size of ZippyCommand
+  TrajectoryPoint targetPosition;
 
-  double rightSetPoint = 0.0d;
-  double rightInput = 0.0d;
-  double rightOutput = 0.0d;
-  PID rightPID;
-  
-  void updateInputs();
-  
 public:
   MoveTowardPoint(double x, double y);
   void start();
-  bool loop();
 
 };
 
-class FollowPath : public ZippyCommand
+class FollowPath : public TrajectoryCommand
 {
 
 private:
-  KVector2 currentTargetPosition;
+  const TrajectoryPoint* waypoints;
+  int waypointCount;
+  float maxVelocity;
 
-  double leftSetPoint = 0.0d;
-  double leftInput = 0.0d;
-  double leftOutput = 0.0d;
-  PID leftPID;
+public:
+  FollowPath(const TrajectoryPoint* waypoints, int waypointCount, float maxVelocity = AUTODRIVE_MAX_VELOCITY);
+  void start();
+
+};
+
+//drives straight along the current heading for the given number of mm, backing up if the distance is negative
+class DriveDistance : public TrajectoryCommand
+{
+
+private:
+  float distance;
+
+public:
+  DriveDistance(double distance);
+  void start();
+
+};
+
+//drives along a circular arc of the given radius in mm that leaves tangent to the current heading; the angle is in radians,
+//with positive angles turning clockwise. Radii below half the wheel base cannot be driven, so they are rejected where
+//missions and behaviors are decoded
+class DriveArc : public TrajectoryCommand
+{
+
+private:
+  float radius;
+  float angle;
+
+public:
+  DriveArc(double radius, double angle);
+  void start();
+
+};
+
+//turns in place until the robot faces the given heading
+class RotateToHeading
+{
+
+private:
+  float targetHeading;
+  unsigned long startTimeMS;
+  unsigned long previousStepMicros;
+  uint8_t tuningsGeneration;
+
+  AngularPid angularPID;
 
-  double rightSetPoint = 0.0d;
-  double rightInput = 0.0d;
-  double rightOutput = 0.0d;
-  PID rightPID;
-  
-  void updateInputs();
-  
 public:
-  FollowPath(double x, double y);
+  RotateToHeading(float heading);
   void start();
   bool loop();
 
 };
 
+/**
+ * Holds any one of the commands above in place. Commands are dispatched by their type index rather than virtually, so they
+ * can be stored in statically allocated arrays without any heap allocation or vtables. New command types must be added to
+ * the type list here.
+ */
+class ZippyCommand : public StaticVariant<Pause, MoveTowardPoint, FollowPath, DriveDistance, DriveArc, RotateToHeading>
+{
+
+public:
+  void start();
+  bool loop();
+
+};
 
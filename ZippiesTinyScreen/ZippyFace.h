@@ -1,6 +1,27 @@
 
 #pragma once
 #include <TinyScreen.h>
+#include "DirtyRegions.h"
+#include "FaceImage.h"
+#include "Profiler.h"
+
+//the most pixels sent to the display in one transfer; larger regions go out in bands of whole rows
+#define FACE_BAND_LENGTH 1024
+//looking for changes is a bit processor-intensive, so it isn't done on every pass
+#define FACE_CHANGES_INTERVAL_MS 250
+
+typedef struct _FaceStats
+{
+  unsigned long transferCount = 0;
+  //how long the last transfer took to reach the display, which the loop used to spend waiting for it, and how long the loop
+  //actually spent starting and finishing it
+  unsigned long lastTransferMicros = 0;
+  unsigned long lastLoopMicros = 0;
+  //running total of the time the loop no longer spends waiting on the display
+  unsigned long offloadedMicros = 0;
+  //running total of the pixels sent; this stops growing while nothing on the screen changes
+  unsigned long pixelCount = 0;
+} FaceStats;
 
 class ZippyFace
 {
@@ -8,11 +29,40 @@ class ZippyFace
 private:
   TinyScreen display;
 
-  void drawBattery();
-  int getBatteryLevel();
+  //the expression being shown, the frame of it that should be on the display now, and when that frame went up
+  const FaceExpression* expression;
+  uint8_t frameIndex;
+  unsigned long frameStartTime;
+
+  //what is on the display now; each time it is checked, the parts that no longer match what should be there are marked dirty
+  uint8_t shownModeColor;
+  uint8_t shownBatteryColor;
+  uint8_t shownBatteryWidth;
+  //the bucket holding the 99th percentile for each stage of the loop profile
+  uint8_t shownProfileBuckets[PROFILE_STAGE_COUNT];
+  DirtyRegions dirtyRegions;
+
+  //the dirty region being sent, a band at a time, and the next of its rows to send
+  ScreenRect sendingRegion;
+  uint8_t sendingRow;
+  uint8_t band[FACE_BAND_LENGTH];
+
+  //bands go out over SPI by DMA, while the loop carries on
+  bool transferring;
+  unsigned long transferStartMicros;
+  FaceStats stats;
+
+  void animate(unsigned long currentTime);
+  void markFrame();
+  void sendNextBand();
+  void startTransfer(const uint8_t* data, uint16_t length);
+  void finishTransfer();
+
+  void getBatteryStatus(unsigned long batteryMillivolts, uint8_t* color, uint8_t* width);
+  void drawStatus(const ScreenRect* bandRect);
+  void drawProfile(const ScreenRect* bandRect);
 
   void drawCoordinate(uint8_t x, uint8_t y, char* label, float value, int precision);
-  void drawModeIndicator(uint8_t modeColor);
 
 public:
   ZippyFace();
@@ -20,6 +70,12 @@ public:
   void start();
   void loop();
   void stop();
+  //compares what is on the display with what should be there, and marks the parts that differ to be sent
+  void markChanges();
+
+  //true while a band is on its way to the display, during which the display holds the SPI bus
+  bool isTransferring();
+  FaceStats* getStats() { return &stats; }
   
 };
 
@@ -4,64 +4,178 @@
 #include "ZippyFace.h"
 #include "LighthouseSensor.h"
 #include "MotorDriver.h"
+#include "Parameters.h"
 
 #define AUTODRIVE_MISSING_POSITION_TIMEOUT    1000
-#define AUTODRIVE_CORRECTION_INTERVAL_MS       200
-#define AUTODRIVE_REAR_POSITION               -800.0d
-#define AUTODRIVE_FRONT_POSITION                 0.0d
-#define AUTODRIVE_LEFT_POSITION               -600.0d
-#define AUTODRIVE_RIGHT_POSITION               600.0d
+//the lighthouse provides a new pose every 8.3ms
+#define AUTODRIVE_POSE_INTERVAL_MICROS        8333
+//a control step should complete before the next pose arrives, and poses should never stop arriving for long while moving
+#define AUTODRIVE_LATENCY_DEADLINE_MICROS     AUTODRIVE_POSE_INTERVAL_MICROS
+#define AUTODRIVE_POSE_DEADLINE_MICROS        (3 * AUTODRIVE_POSE_INTERVAL_MICROS)
 
-#define ZIPPY_COMMAND_COUNT 20
+//the remote control must keep sending commands at least this often while the robot is moving, or it stops
+#define USERDRIVE_DEADMAN_TIMEOUT_MS           250
 
 extern ZippyFace face;
 extern Bluetooth bluetooth;
 extern Lighthouse lighthouse;
 extern MotorDriver motors;
+extern Parameters parameters;
 
 AutoDriveMode::AutoDriveMode()
   : moving(false),
     lostPositionTimestamp(0),
-    lastCorrectionTime(0),
-    currentCommand(0)
+    posesSinceControlStep(0),
+    lastPoseMicros(0),
+    pathVelocity(AUTODRIVE_MAX_VELOCITY)
 {
-  commands = new ZippyCommand*[ZIPPY_COMMAND_COUNT];
-  commands[0] = new Pause(3.0d);
-  commands[1] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_REAR_POSITION);
-  commands[2] = new Pause(3.0d);
-  commands[3] = new MoveTowardPoint(AUTODRIVE_LEFT_POSITION, AUTODRIVE_REAR_POSITION);
-  commands[4] = new Pause(3.0d);
-  commands[5] = new MoveTowardPoint(AUTODRIVE_LEFT_POSITION, AUTODRIVE_FRONT_POSITION);
-  commands[6] = new Pause(3.0d);
-  commands[7] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_FRONT_POSITION);
-  commands[8] = new Pause(3.0d);
-  commands[9] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_REAR_POSITION);
-  commands[10] = new Pause(3.0d);
-
-  commands[11] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_FRONT_POSITION);
-  commands[12] = new Pause(3.0d);
-  commands[13] = new MoveTowardPoint(AUTODRIVE_LEFT_POSITION, AUTODRIVE_FRONT_POSITION);
-  commands[14] = new Pause(3.0d);
-  commands[15] = new MoveTowardPoint(AUTODRIVE_LEFT_POSITION, AUTODRIVE_REAR_POSITION);
-  commands[16] = new Pause(3.0d);
-  commands[17] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_REAR_POSITION);
-  commands[18] = new Pause(3.0d);
-  commands[19] = new MoveTowardPoint(AUTODRIVE_RIGHT_POSITION, AUTODRIVE_FRONT_POSITION);
 }
 
-AutoDriveMode::~AutoDriveMode()
+bool AutoDriveMode::startNextCommand()
 {
-  for (int i = 0; i < ZIPPY_COMMAND_COUNT; i++)
-    delete commands[i];
-  delete[] commands;
+  if (behavior.isRunning()) {
+    //the program runs for a bounded number of instructions each time; if it has not yielded a command yet, we are called
+    //again on the next loop()
+    BehaviorPose pose;
+    pose.x = lighthouse.getPosition()->getX();
+    pose.y = lighthouse.getPosition()->getY();
+    pose.heading = lighthouse.getOrientation()->getOrientation();
+    pose.hasSignal = lighthouse.hasLighthouseSignal();
+    behavior.setMinArcRadius(parameters.get(PARAMETER_WHEEL_BASE) / 2.0f);
+    BehaviorAction action;
+    uint8_t result = behavior.next(&pose, &action);
+    if (result == BEHAVIOR_RESULT_COMMAND) {
+      switch (action.type) {
+        case BEHAVIOR_MOVE:
+          currentCommand.emplace<MoveTowardPoint>((double)action.a, (double)action.b);
+          break;
+        case BEHAVIOR_PAUSE:
+          currentCommand.emplace<Pause>((double)action.a);
+          break;
+        case BEHAVIOR_TURN:
+          currentCommand.emplace<RotateToHeading>(wrapAngle(action.a));
+          break;
+        case BEHAVIOR_DRIVE_DISTANCE:
+          currentCommand.emplace<DriveDistance>((double)action.a);
+          break;
+        case BEHAVIOR_DRIVE_ARC:
+          currentCommand.emplace<DriveArc>((double)action.a, (double)action.b);
+          break;
+      }
+      currentCommand.start();
+      return true;
+    }
+    else if (result == BEHAVIOR_RESULT_WAITING) {
+      currentCommand.clear();
+      return false;
+    }
+  }
+
+  MissionSegment* segment = mission.peek();
+  while (segment != NULL) {
+    switch (segment->type) {
+      case MISSION_SEGMENT_SPEED:
+        pathVelocity = segment->a > 0 ? (float)segment->a : AUTODRIVE_MAX_VELOCITY;
+        mission.pop();
+        segment = mission.peek();
+        break;
+
+      case MISSION_SEGMENT_PAUSE:
+        currentCommand.emplace<Pause>(((double)(uint16_t)segment->a) / 1000.0d);
+        mission.pop();
+        currentCommand.start();
+        return true;
+
+      case MISSION_SEGMENT_HEADING:
+        currentCommand.emplace<RotateToHeading>(((float)segment->a) / 1000.0f);
+        mission.pop();
+        currentCommand.start();
+        return true;
+
+      case MISSION_SEGMENT_DISTANCE:
+        currentCommand.emplace<DriveDistance>((double)segment->a);
+        mission.pop();
+        currentCommand.start();
+        return true;
+
+      case MISSION_SEGMENT_ARC:
+        currentCommand.emplace<DriveArc>((double)segment->a, ((double)segment->b) / 1000.0d);
+        mission.pop();
+        currentCommand.start();
+        return true;
+
+      case MISSION_SEGMENT_WAYPOINT:
+        {
+          //take as many consecutive waypoints as have arrived so far, so that their corners can be blended
+          int waypointCount = 0;
+          while (segment != NULL && segment->type == MISSION_SEGMENT_WAYPOINT && waypointCount < AUTODRIVE_MAX_PATH_WAYPOINTS) {
+            pathWaypoints[waypointCount].x = segment->a;
+            pathWaypoints[waypointCount].y = segment->b;
+            waypointCount++;
+            mission.pop();
+            segment = mission.peek();
+          }
+          currentCommand.emplace<FollowPath>(pathWaypoints, waypointCount, pathVelocity);
+          currentCommand.start();
+        }
+        return true;
+
+      default:
+        mission.pop();
+        segment = mission.peek();
+        break;
+    }
+  }
+
+  //nothing more to do until more of the mission arrives
+  currentCommand.clear();
+  return false;
 }
 
-void AutoDriveMode::loop()
+void AutoDriveMode::clearMission()
 {
-//  /*
-  if (currentCommand >= ZIPPY_COMMAND_COUNT)
+  mission.clear();
+  behavior.stop();
+  currentCommand.clear();
+  if (moving) {
+    motors.setMotors(0, 0);
+    moving = false;
+  }
+}
+
+void AutoDriveMode::poseAvailable()
+{
+  lastPoseMicros = micros();
+  if (!moving || currentCommand.isEmpty())
     return;
-  
+
+  posesSinceControlStep++;
+  if (posesSinceControlStep < parameters.getInt(PARAMETER_POSE_DECIMATION))
+    return;
+  posesSinceControlStep = 0;
+
+  unsigned long stepStartMicros = micros();
+  lighthouse.recalculate();
+
+  //hand the command the pose we expect to have by the time the motors receive its output
+  unsigned long actuationTimeMicros = stepStartMicros + controlTiming.averageStepMicros;
+  lighthouse.predictPose(actuationTimeMicros);
+  controlTiming.lastPredictionMicros = actuationTimeMicros - lighthouse.getPoseTimeMicros();
+
+//  SerialUSB.println(currentCommand);
+  if (currentCommand.loop() && !startNextCommand()) {
+    //the current command completed and the rest of the mission has not arrived yet
+    motors.setMotors(0, 0);
+    moving = false;
+  }
+
+  //the motors have now been updated from the new pose
+  unsigned long stepEndMicros = micros();
+  recordLatency(stepEndMicros - stepStartMicros, stepEndMicros - lighthouse.getPoseTimeMicros());
+}
+
+void AutoDriveMode::loop()
+{
   unsigned long currentTime = millis();
   if (!lighthouse.hasLighthouseSignal()) {
     if (!moving)
@@ -84,32 +198,85 @@ void AutoDriveMode::loop()
     lostPositionTimestamp = 0;
 
   if (!moving) {
+    //resume the command that was interrupted, if any, replanning from where we are now; otherwise wait for the mission
+    if (!currentCommand.isEmpty())
+      currentCommand.start();
+    else if (!startNextCommand())
+      return;
+
     moving = true;
-    currentCommand = 0;
-    commands[0]->start();
-    lastCorrectionTime = currentTime;
+    posesSinceControlStep = 0;
+    lastPoseMicros = micros();
     return;
   }
 
-  if (currentTime - lastCorrectionTime < AUTODRIVE_CORRECTION_INTERVAL_MS)
-    return;
-  lastCorrectionTime += AUTODRIVE_CORRECTION_INTERVAL_MS;
-
-  lighthouse.recalculate();
+  //deadline monitor; count each interval in which we went without a new pose
+  unsigned long currentMicros = micros();
+  if (currentMicros - lastPoseMicros > AUTODRIVE_POSE_DEADLINE_MICROS) {
+    controlTiming.missedPoseDeadlines++;
+    lastPoseMicros = currentMicros;
+  }
+}
 
-//  /*
-//  SerialUSB.println(currentCommand);
-  if (commands[currentCommand]->loop()) {
-    //current command completed; start the next command
-    currentCommand = (currentCommand+1) % ZIPPY_COMMAND_COUNT;
-    commands[currentCommand]->start();
+void AutoDriveMode::recordLatency(unsigned long stepMicros, unsigned long latencyMicros)
+{
+  controlTiming.stepCount++;
+  controlTiming.lastLatencyMicros = latencyMicros;
+  if (latencyMicros > controlTiming.maxLatencyMicros)
+    controlTiming.maxLatencyMicros = latencyMicros;
+  //exponential moving averages over roughly the last 16 control steps
+  if (controlTiming.stepCount == 1) {
+    controlTiming.averageLatencyMicros = latencyMicros;
+    controlTiming.averageStepMicros = stepMicros;
+  }
+  else {
+    controlTiming.averageLatencyMicros = ((controlTiming.averageLatencyMicros * 15) + latencyMicros) / 16;
+    controlTiming.averageStepMicros = ((controlTiming.averageStepMicros * 15) + stepMicros) / 16;
   }
-//  */
+  if (latencyMicros > AUTODRIVE_LATENCY_DEADLINE_MICROS)
+    controlTiming.latencyOverruns++;
 }
 
 void AutoDriveMode::stopMoving()
 {
 }
 
+UserDriveMode::UserDriveMode()
+  : lastCommandMS(0),
+    moving(false)
+{
+}
 
+void UserDriveMode::setVelocity(double linearVelocity, double angularVelocity, unsigned long receivedMicros)
+{
+  motors.setVelocity(linearVelocity, angularVelocity);
+  lastCommandMS = millis();
+  moving = linearVelocity != 0.0d || angularVelocity != 0.0d;
 
+  unsigned long latencyMicros = micros() - receivedMicros;
+  teleopStats.commandCount++;
+  teleopStats.lastLatencyMicros = latencyMicros;
+  if (latencyMicros > teleopStats.maxLatencyMicros)
+    teleopStats.maxLatencyMicros = latencyMicros;
+  if (teleopStats.commandCount == 1)
+    teleopStats.averageLatencyMicros = latencyMicros;
+  else
+    teleopStats.averageLatencyMicros = ((teleopStats.averageLatencyMicros * 15) + latencyMicros) / 16;
+}
+
+void UserDriveMode::stop()
+{
+  if (moving) {
+    motors.setMotors(0, 0);
+    moving = false;
+  }
+}
+
+void UserDriveMode::loop()
+{
+  //the connection dropped or the remote control stopped sending; don't keep driving blind
+  if (moving && millis() - lastCommandMS >= USERDRIVE_DEADMAN_TIMEOUT_MS) {
+    stop();
+    teleopStats.deadmanStops++;
+  }
+}
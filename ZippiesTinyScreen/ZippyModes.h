@@ -2,12 +2,53 @@
 #pragma once
 #include <Tinyscreen.h>
 #include "ZippyCommand.h"
+#include "MissionQueue.h"
+#include "Behavior.h"
+
+//the lighthouse provides a new pose every 8.3ms; run a control step on every Nth one; the default for
+//PARAMETER_POSE_DECIMATION
+#define AUTODRIVE_POSE_DECIMATION                3
+
+//consecutive waypoints in a mission are driven as a single blended path of up to this many waypoints
+#define AUTODRIVE_MAX_PATH_WAYPOINTS    (TRAJECTORY_MAX_SEGMENTS/2)
+
+//timing of the control steps, which are triggered by new poses from the lighthouse
+typedef struct _ControlTiming
+{
+  unsigned long stepCount = 0;
+  //time from the sweep hits that make up a pose until the motors have been updated from it
+  unsigned long lastLatencyMicros = 0;
+  unsigned long maxLatencyMicros = 0;
+  unsigned long averageLatencyMicros = 0;
+  //time from the start of a control step until the motors have been updated; used to predict when the motors will act
+  unsigned long averageStepMicros = 0;
+  //how far forward from the time it was sensed that the most recent pose was extrapolated
+  unsigned long lastPredictionMicros = 0;
+  //control steps that took longer than the interval between poses
+  unsigned long latencyOverruns = 0;
+  //times a new pose failed to arrive in time while moving
+  unsigned long missedPoseDeadlines = 0;
+} ControlTiming;
+
+//commands received from a remote control, and how long they took to reach the motors
+typedef struct _TeleopStats
+{
+  unsigned long commandCount = 0;
+  //time from the radio handing us a command until the motors have been updated from it
+  unsigned long lastLatencyMicros = 0;
+  unsigned long maxLatencyMicros = 0;
+  unsigned long averageLatencyMicros = 0;
+  //times the robot was stopped because commands stopped arriving
+  unsigned long deadmanStops = 0;
+} TeleopStats;
 
 class ZippyMode
 {
 
 public:
   virtual uint8_t getIndicatorColor() = 0;
+  //called each time the lighthouse has a new pose available, before loop()
+  virtual void poseAvailable() {}
   virtual void loop() = 0;
   
 };
@@ -19,30 +60,57 @@ private:
   unsigned long lostPositionTimestamp;
   bool moving;
 
-  unsigned long lastCorrectionTime;
+  //control steps are run on every Nth pose
+  int posesSinceControlStep;
+  unsigned long lastPoseMicros;
+  ControlTiming controlTiming;
 
-  ZippyCommand** commands;
-  int currentCommand;
+  //the mission is executed one command at a time as its segments are taken from the queue, unless a behavior program is
+  //running, in which case the program supplies the commands
+  MissionQueue mission;
+  BehaviorInterpreter behavior;
+  ZippyCommand currentCommand;
+  TrajectoryPoint pathWaypoints[AUTODRIVE_MAX_PATH_WAYPOINTS];
+  float pathVelocity;
   
+  bool startNextCommand();
   void stopMoving();
+  void recordLatency(unsigned long stepMicros, unsigned long latencyMicros);
 
 public:
   AutoDriveMode();
-  ~AutoDriveMode();
 
   uint8_t getIndicatorColor() { return TS_8b_Blue; }
+  void poseAvailable();
   void loop();
+
+  ControlTiming* getControlTiming() { return &controlTiming; }
+  MissionQueue* getMission() { return &mission; }
+  BehaviorInterpreter* getBehavior() { return &behavior; }
+  //abandons the current mission and any running behavior program, and stops
+  void clearMission();
   
 };
 
 class UserDriveMode : public ZippyMode
 {
 
+private:
+  unsigned long lastCommandMS;
+  bool moving;
+  TeleopStats teleopStats;
+
 public:
   UserDriveMode();
   
   uint8_t getIndicatorColor() { return TS_8b_Green; }
   void loop();
+
+  //linear velocity in mm/s and angular velocity in radians/s, applied to the motors immediately; receivedMicros is when the
+  //command arrived from the radio
+  void setVelocity(double linearVelocity, double angularVelocity, unsigned long receivedMicros);
+  void stop();
+  TeleopStats* getTeleopStats() { return &teleopStats; }
   
 };
 